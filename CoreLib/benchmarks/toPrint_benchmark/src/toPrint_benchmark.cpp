@@ -9,6 +9,8 @@
 
 #include <CoreLib/toPrint/toPrint.hpp>
 #include <CoreLib/toPrint/toPrint_sink.hpp>
+#include <CoreLib/toPrint/toPrint_deferred.hpp>
+#include <CoreLib/toPrint/toPrint_time.hpp>
 
 class dumpSink: public core::sink_toPrint_base
 {
@@ -24,6 +26,9 @@ int32_t const test_signed_int = -34;
 uint64_t const test_unsigned_int = 12345;
 double const test_fp = -5.67;
 char const test_char = 'a';
+int64_t const test_big_int = -9012345678901234;
+uint32_t const test_hex = 0xBADC0DE;
+core::date_time_t const test_date{.date{.year = 2024, .month = 2, .day = 29}, .time{.hour = 7, .minute = 5, .second = 9, .nsecond = 12345678}};
 
 static void no_op(benchmark::State& state)
 {
@@ -70,8 +75,104 @@ static void toPrint_l(benchmark::State& state)
 	}
 }
 
+static void toPrint_si_sp(benchmark::State& state)
+{
+	dumpSink const tsink;
+	while(state.KeepRunning())
+	{
+		core::print_single_pass<char8_t>(tsink, test_string, test_signed_int);
+	}
+}
+
+static void toPrint_l_sp(benchmark::State& state)
+{
+	dumpSink const tsink;
+	while(state.KeepRunning())
+	{
+		core::print_single_pass<char8_t>(tsink, test_string, test_signed_int, test_unsigned_int, test_fp, test_char);
+	}
+}
+
+static void toPrint_num(benchmark::State& state)
+{
+	dumpSink const tsink;
+	while(state.KeepRunning())
+	{
+		core::print<char8_t>(tsink, test_signed_int, ' ', test_unsigned_int, ' ', test_big_int, ' ', core::toPrint_hex{test_hex}, ' ', core::toPrint_fp_fancy{test_fp});
+	}
+}
+
+static void toPrint_num_sp(benchmark::State& state)
+{
+	dumpSink const tsink;
+	while(state.KeepRunning())
+	{
+		core::print_single_pass<char8_t>(tsink, test_signed_int, ' ', test_unsigned_int, ' ', test_big_int, ' ', core::toPrint_hex{test_hex}, ' ', core::toPrint_fp_fancy{test_fp});
+	}
+}
+
+static void toPrint_lit(benchmark::State& state)
+{
+	dumpSink const tsink;
+	while(state.KeepRunning())
+	{
+		core::print<char8_t>(tsink, "Value: "sv, test_signed_int, " id: "sv, core::toPrint_hex{test_hex}, " done"sv);
+	}
+}
+
+static void toPrint_fmt(benchmark::State& state)
+{
+	dumpSink const tsink;
+	while(state.KeepRunning())
+	{
+		core::print<char8_t>(tsink, core::toPrint_format<"Value: {} id: {:x} done">(test_signed_int, test_hex));
+	}
+}
+
+static void toPrint_date_fields(benchmark::State& state)
+{
+	dumpSink const tsink;
+	while(state.KeepRunning())
+	{
+		core::print<char8_t>(tsink,
+			test_date.date.year, '-', test_date.date.month, '-', test_date.date.day, 'T',
+			test_date.time.hour, ':', test_date.time.minute, ':', test_date.time.second, '.', test_date.time.nsecond, 'Z');
+	}
+}
+
+static void toPrint_iso(benchmark::State& state)
+{
+	dumpSink const tsink;
+	while(state.KeepRunning())
+	{
+		core::print_single_pass<char8_t>(tsink, core::toPrint_iso8601{test_date});
+	}
+}
+
+//only measures the calling thread, prints that do not fit are dropped instead of waiting for the renderer
+static void toPrint_deferred_l(benchmark::State& state)
+{
+	dumpSink tsink;
+	core::deferred_printer printer;
+	printer.start(tsink, 0x100000, 1, core::deferred_printer::overflow::drop);
+	while(state.KeepRunning())
+	{
+		core::print_deferred<"{} {} {} {} {}">(printer, test_string, test_signed_int, test_unsigned_int, test_fp, test_char);
+	}
+	printer.stop();
+}
+
 BENCHMARK(no_op);
 BENCHMARK(toPrint_n);
 BENCHMARK(toPrint_s);
 BENCHMARK(toPrint_si);
 BENCHMARK(toPrint_l);
+BENCHMARK(toPrint_si_sp);
+BENCHMARK(toPrint_l_sp);
+BENCHMARK(toPrint_num);
+BENCHMARK(toPrint_num_sp);
+BENCHMARK(toPrint_lit);
+BENCHMARK(toPrint_fmt);
+BENCHMARK(toPrint_date_fields);
+BENCHMARK(toPrint_iso);
+BENCHMARK(toPrint_deferred_l);
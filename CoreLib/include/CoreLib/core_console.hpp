@@ -26,7 +26,14 @@
 //======== ======== ======== ======== ======== ======== ======== ========
 
 #pragma once
+#include <cstdint>
 #include <string_view>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <system_error>
+#include "core_sync.hpp"
+#include "core_thread.hpp"
 #include "toPrint/toPrint_sink.hpp"
 
 namespace core
@@ -64,4 +71,78 @@ private:
 extern console_out const cout;
 extern console_out const cerr;
 
+
+///	\brief Accumulates console output in a buffer, to reduce the number of OS writes.
+///	\remarks Output is written when the buffer reaches the flush size, on a new line if enabled,
+///		after the flush interval has elapsed, on \ref flush, or on destruction.
+///		Without a writer thread the interval is only checked when more output arrives.
+///		The writer thread takes the OS writes off the printing thread, and writes out pending output once the interval elapses.
+///	\warning Printing is not thread safe, the writer thread is the only concurrent access supported.
+class console_out_buffered: public sink_toPrint_base
+{
+public:
+	static constexpr sink_toPrint_properties_t sink_toPrint_properties{ .has_own_buffer = true };
+
+public:
+	///	\param[in] p_out - Console to write to
+	///	\param[in] p_flush_size - Amount of buffered output that triggers a write
+	///	\param[in] p_line_flush - If true, output is written whenever a new line is printed
+	///	\param[in] p_flush_interval - Maximum time in milliseconds output is held, 0 for no limit
+	console_out_buffered(console_out const& p_out, uintptr_t p_flush_size = 0x10000, bool p_line_flush = false, uint32_t p_flush_interval = 0);
+	~console_out_buffered();
+
+	///	\brief Starts a background thread to do the OS writes
+	std::errc start_writer();
+
+	///	\brief Writes out all pending output and stops the background thread
+	void stop_writer();
+
+	///	\brief Writes out all buffered output
+	void flush();
+
+	char8_t* buffer_acquire(uintptr_t p_size);
+	void buffer_released(char8_t* p_buff, uintptr_t p_size);
+
+	void write(std::string_view    p_out);
+	void write(std::wstring_view   p_out);
+	void write(std::u8string_view  p_out);
+	void write(std::u16string_view p_out);
+	void write(std::u32string_view p_out);
+
+	void put(char     p_out);
+	void put(wchar_t  p_out);
+	void put(char8_t  p_out);
+	void put(char16_t p_out);
+	void put(char32_t p_out);
+
+private:
+	using clock_t = std::chrono::steady_clock;
+
+	void flush_locked();
+	void writer(void*);
+
+private:
+	console_out const	m_out;
+	uintptr_t const		m_flush_size;
+	uint32_t const		m_flush_interval;	//!< Milliseconds
+	bool const			m_line_flush;
+
+	atomic_spinlock			m_lock;			//!< Protects the front buffer against the writer
+	std::vector<char8_t>	m_front;
+	uintptr_t				m_used = 0;
+	clock_t::time_point		m_pending_since;
+
+	std::vector<char8_t>	m_back;			//!< Being written by the writer thread
+	uintptr_t				m_back_used = 0;
+	std::atomic<bool>		m_back_busy	{false};
+	std::atomic<bool>		m_stop		{false};
+	bool					m_has_writer = false;
+	event_trap				m_trap;
+	thread					m_thread;
+
+private:
+	console_out_buffered(console_out_buffered const&) = delete;
+	console_out_buffered& operator = (console_out_buffered const&) = delete;
+};
+
 } //namespace core
@@ -30,6 +30,7 @@
 #include <array>
 #include <cstdint>
 #include <string_view>
+#include <vector>
 
 namespace core
 {
@@ -155,6 +156,9 @@ namespace core
 			static bool AMX_TILE			();
 			static bool AMX_INT8			();
 
+			static bool RDTSCP			();
+			static bool TSC_invariant	();
+
 			static EX_Reg Fn0();
 			static EX_Reg Fn1();
 			static EX_Reg Fn7();
@@ -264,11 +268,107 @@ namespace core
 			static bool AMX_TILE			();
 			static bool AMX_INT8			();
 
+			static bool RDTSCP			();
+			static bool TSC_invariant	();
+
 			static EX_Reg Fn0();
 			static EX_Reg Fn1();
 			static EX_Reg Fn7();
 		};
 
+		enum class cache_type: uint8_t
+		{
+			data		= 1,
+			instruction	= 2,
+			unified		= 3,
+		};
+
+		///	\brief One cache as reported by CPUID leaf 4 (Intel) or 0x8000001D (AMD).
+		struct cache_info
+		{
+			uint64_t size;			//!< Total size in bytes
+			uint32_t sets;
+			uint16_t line_size;		//!< In bytes
+			uint16_t ways;			//!< Equal to size / (sets * line_size), also when fully associative
+			uint16_t partitions;
+			uint16_t shared_by;		//!< Maximum number of logical processors sharing this cache
+			uint8_t level;
+			cache_type type;
+			bool fully_associative;
+			bool inclusive;			//!< Inclusive of the lower cache levels
+		};
+
+		enum class tlb_type: uint8_t
+		{
+			data		= 1,
+			instruction	= 2,
+			unified		= 3,
+			load		= 4,
+			store		= 5,
+		};
+
+		///	\brief Bits of \ref tlb_info::page_sizes
+		namespace tlb_page
+		{
+			inline constexpr uint8_t size_4K = 0x01;
+			inline constexpr uint8_t size_2M = 0x02;
+			inline constexpr uint8_t size_4M = 0x04;
+			inline constexpr uint8_t size_1G = 0x08;
+		}
+
+		///	\brief One TLB as reported by CPUID leaf 0x18 (Intel) or 0x80000005/6/19 (AMD).
+		struct tlb_info
+		{
+			uint32_t entries;
+			uint16_t ways;			//!< Equal to entries when fully associative
+			uint16_t shared_by;		//!< Maximum number of logical processors sharing this TLB, 0 if unknown
+			uint8_t level;
+			tlb_type type;
+			uint8_t page_sizes;		//!< Combination of \ref tlb_page bits
+			bool fully_associative;
+		};
+
+		///	\brief Kind of core on hybrid processors, see CPUID leaf 0x1A.
+		enum class core_type: uint8_t
+		{
+			unknown		= 0,	//!< Not a hybrid processor, or not reported
+			efficiency	= 0x20,	//!< E-core (Intel Atom)
+			performance	= 0x40,	//!< P-core (Intel Core)
+		};
+
+		///	\brief Cache and TLB layout of the processor.
+		///	\remarks Caches are sorted by level, then data before instruction.
+		///		Caches and TLBs may be different for each core type on hybrid processors,
+		///		the information describes the logical processor the query ran on.
+		struct cpu_topology
+		{
+			std::vector<cache_info> caches;
+			std::vector<tlb_info> tlbs;
+			core_type core = core_type::unknown;
+			uint32_t native_model = 0;	//!< Native model id from CPUID leaf 0x1A
+			bool hybrid = false;
+
+			///	\brief Data or unified cache at the given level.
+			///	\return nullptr if not present
+			[[nodiscard]] cache_info const* data_cache(uint8_t p_level) const;
+
+			///	\brief Line size of the first level data cache, 64 if not reported.
+			[[nodiscard]] uint16_t line_size() const;
+
+			///	\brief Size of the last level cache in bytes, 0 if not reported.
+			[[nodiscard]] uint64_t last_level_size() const;
+		};
+
+		///	\brief Queries cache and TLB information from the logical processor the calling thread is running on.
+		///	\remarks Not cached, cpu_id is always called. Safe to use in global initialization.
+		[[nodiscard]] cpu_topology query_cpu_topology();
+
+		///	\brief Same as \ref query_cpu_topology but only queried once.
+		[[nodiscard]] cpu_topology const& cpu_topology_g();
+
+		///	\brief Type of the core the calling thread is currently running on.
+		[[nodiscard]] core_type current_core_type();
+
 	}
 
 #endif
@@ -0,0 +1,136 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace core
+{
+	///	\brief Instruction set tiers a dispatched kernel can be compiled for.
+	///	\remarks Each tier implies all the tiers below it.
+	///		- sse4_2: SSE4.2, SSSE3 and POPCNT
+	///		- avx2: AVX, AVX2, BMI1, BMI2 and FMA, with YMM state enabled by the OS
+	///		- avx512: AVX-512 F, BW, DQ, CD and VL, with ZMM state enabled by the OS
+	enum class isa_level: uint8_t
+	{
+		scalar	= 0,
+		sse4_2	= 1,
+		avx2	= 2,
+		avx512	= 3,
+	};
+
+	inline constexpr uintptr_t isa_level_count = 4;
+
+	///	\brief Highest tier supported by both the processor and the operating system.
+	///	\remarks Detected once, safe to use during global initialization.
+	[[nodiscard]] isa_level isa_level_supported();
+
+	///	\brief Tier used to resolve dispatched kernels.
+	///	\remarks Same as \ref isa_level_supported, unless capped by the environment variable CORELIB_ISA
+	///		(one of "scalar", "sse4.2", "avx2" or "avx512").
+	///		The variable is read once, it can lower the tier but never raise it above what is supported.
+	[[nodiscard]] isa_level isa_level_active();
+
+	[[nodiscard]] std::u8string_view isa_level_name(isa_level p_level);
+
+	///	\brief Parses a tier name as accepted by CORELIB_ISA, case insensitive.
+	[[nodiscard]] std::optional<isa_level> isa_level_from_name(std::u8string_view p_name);
+
+
+	template<typename Fn>
+	class cpu_dispatch;
+
+	///	\brief Table of kernels implementing the same function for different instruction set tiers.
+	///	\remarks The best kernel at or below \ref isa_level_active is resolved on first call and cached.
+	///		Tiers without a kernel (nullptr) fall back to the next tier below, the scalar kernel is mandatory.
+	///		Intended to be declared constinit, so that it can be used during global initialization.
+	template<typename Ret, typename... Args>
+	class cpu_dispatch<Ret(Args...)>
+	{
+	public:
+		using kernel_t = Ret(*)(Args...);
+
+	public:
+		constexpr cpu_dispatch(kernel_t const p_scalar, kernel_t const p_sse4_2, kernel_t const p_avx2, kernel_t const p_avx512)
+			: m_kernels{p_scalar, p_sse4_2, p_avx2, p_avx512}
+		{
+		}
+
+		cpu_dispatch(cpu_dispatch const&) = delete;
+		cpu_dispatch& operator = (cpu_dispatch const&) = delete;
+
+		inline Ret operator () (Args... p_args) const
+		{
+			return resolved()(p_args...);
+		}
+
+		///	\brief Kernel selected for this process.
+		[[nodiscard]] inline kernel_t resolved() const
+		{
+			kernel_t res = m_resolved.load(std::memory_order_relaxed);
+			if(res == nullptr)
+			{
+				res = kernel(isa_level_active());
+				m_resolved.store(res, std::memory_order_relaxed);
+			}
+			return res;
+		}
+
+		///	\brief Best kernel at or below the given tier.
+		///	\warning Does not check if the tier is supported by the processor.
+		[[nodiscard]] constexpr kernel_t kernel(isa_level const p_level) const
+		{
+			for(uint8_t level = static_cast<uint8_t>(p_level); level; --level)
+			{
+				if(m_kernels[level]) return m_kernels[level];
+			}
+			return m_kernels[0];
+		}
+
+		///	\brief Calls p_callable(isa_level, kernel_t) for every kernel this processor can run, scalar first.
+		///	\remarks Ignores CORELIB_ISA. Intended to test each implementation against the scalar reference.
+		template<typename Callable>
+		void for_each_kernel(Callable&& p_callable) const
+		{
+			uint8_t const top = static_cast<uint8_t>(isa_level_supported());
+			for(uint8_t level = 0; level <= top; ++level)
+			{
+				if(m_kernels[level]) p_callable(static_cast<isa_level>(level), m_kernels[level]);
+			}
+		}
+
+	private:
+		std::array<kernel_t, isa_level_count> const m_kernels;
+		mutable std::atomic<kernel_t> m_resolved = nullptr;
+	};
+
+} //namespace core
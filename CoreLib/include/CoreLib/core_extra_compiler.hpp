@@ -40,3 +40,13 @@
 #else
 #	define FORCE_INLINE inline
 #endif
+
+#if (defined(__GNUG__) or defined(__GNUC__))
+#	define TARGET_SSE4_2	__attribute__((target("sse4.2,popcnt")))
+#	define TARGET_AVX2		__attribute__((target("avx2,bmi,bmi2,fma,popcnt")))
+#	define TARGET_AVX512	__attribute__((target("avx512f,avx512bw,avx512dq,avx512cd,avx512vl,avx2,bmi,bmi2,fma,popcnt")))
+#else
+#	define TARGET_SSE4_2
+#	define TARGET_AVX2
+#	define TARGET_AVX512
+#endif
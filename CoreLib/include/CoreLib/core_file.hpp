@@ -28,8 +28,11 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <filesystem>
 #include <system_error>
+#include <span>
+#include <memory>
 
 namespace core
 {
@@ -69,6 +72,10 @@ namespace core
 
 			void lock();
 			void unlock();
+
+			///	\brief Sets the size of the stream's buffer, 0 disables buffering.
+			///	\remarks Must be called after open and before any other operation on the file.
+			std::errc set_buffer_size(uintptr_t p_size);
 #ifdef _WIN32
 			void close_unlocked();
 			[[nodiscard]] int64_t pos_unlocked() const;
@@ -91,6 +98,8 @@ namespace core
 			void* m_handle = nullptr;
 
 		private:
+			std::unique_ptr<char[]> m_buffer;
+
 			file_base(file_base const&) = delete;
 			file_base(file_base&&) = delete;
 			file_base& operator = (file_base const&) = delete;
@@ -106,8 +115,13 @@ namespace core
 		uintptr_t read(void* p_buff, uintptr_t p_size);
 		uintptr_t read_unlocked(void* p_buff, uintptr_t p_size);
 
+		///	\brief Scatters the data read into the given buffers, in order, with a single vectored call where possible
+		///	\return Total number of bytes read
+		uintptr_t read(std::span<std::span<uint8_t> const> p_buffers);
+
 #ifndef _WIN32
 		uintptr_t read_offset(void* p_buff, uintptr_t p_size, int64_t p_offset);
+		uintptr_t read_offset(std::span<std::span<uint8_t> const> p_buffers, int64_t p_offset);
 #endif
 	};
 
@@ -122,8 +136,14 @@ namespace core
 		uintptr_t write_unlocked(void const* p_buff, uintptr_t p_size);
 		void flush_unlocked();
 
+		///	\brief Gathers the data to write from the given buffers, in order, with a single vectored call where possible
+		///	\return Total number of bytes written
+		///	\remarks Pending buffered data is flushed first
+		uintptr_t write(std::span<std::span<uint8_t const> const> p_buffers);
+
 #ifndef _WIN32
 		uintptr_t write_offset(void const* p_buff, uintptr_t p_size, int64_t p_offset);
+		uintptr_t write_offset(std::span<std::span<uint8_t const> const> p_buffers, int64_t p_offset);
 #endif
 	};
 
@@ -141,10 +161,255 @@ namespace core
 		uintptr_t write_unlocked(void const* p_buff, uintptr_t p_size);
 		void flush_unlocked();
 
+		///	\copydoc file_read::read(std::span<std::span<uint8_t> const>)
+		uintptr_t read (std::span<std::span<uint8_t> const> p_buffers);
+		///	\copydoc file_write::write(std::span<std::span<uint8_t const> const>)
+		uintptr_t write(std::span<std::span<uint8_t const> const> p_buffers);
+
 #ifndef _WIN32
 		uintptr_t read_offset(void* p_buff, uintptr_t p_size, int64_t p_offset);
 		uintptr_t write_offset(void const* p_buff, uintptr_t p_size, int64_t p_offset);
+		uintptr_t read_offset (std::span<std::span<uint8_t> const> p_buffers, int64_t p_offset);
+		uintptr_t write_offset(std::span<std::span<uint8_t const> const> p_buffers, int64_t p_offset);
 #endif
 	};
 
+	///	\brief Releases memory allocated by \ref make_aligned_buffer
+	class aligned_buffer_deleter
+	{
+	public:
+		uintptr_t alignment = alignof(std::max_align_t);
+		void operator () (uint8_t* p_buffer) const;
+	};
+
+	using aligned_buffer = std::unique_ptr<uint8_t[], aligned_buffer_deleter>;
+
+	///	\brief Allocates a buffer suitable for \ref file_direct
+	///	\param[in] p_size - Size of the buffer, rounded up to a multiple of p_alignment
+	///	\param[in] p_alignment - Must be a power of 2
+	///	\return The buffer, or nullptr if the allocation failed or the alignment is invalid
+	[[nodiscard]] aligned_buffer make_aligned_buffer(uintptr_t p_size, uintptr_t p_alignment);
+
+#ifndef _WIN32
+	namespace _p
+	{
+		///	\brief Operates directly on the file descriptor, without going through stdio.
+		///	\remarks Not thread safe, unlike the stdio based classes there is no implicit locking.
+		class file_raw_base
+		{
+		public:
+			using open_mode = file_base::open_mode;
+
+		public:
+			file_raw_base() = default;
+			~file_raw_base();
+
+			void close();
+			[[nodiscard]] inline bool is_open() const { return m_fd != -1; }
+
+			[[nodiscard]] int64_t pos() const;
+
+			std::errc seek(int64_t p_pos);
+			std::errc seek_current(int64_t p_pos);
+			std::errc seek_end(int64_t p_pos);
+
+			[[nodiscard]] int64_t size() const;
+
+			[[nodiscard]] inline int handle() const { return m_fd; }
+
+		protected:
+			int m_fd = -1;
+
+		private:
+			file_raw_base(file_raw_base const&) = delete;
+			file_raw_base(file_raw_base&&) = delete;
+			file_raw_base& operator = (file_raw_base const&) = delete;
+			file_raw_base& operator = (file_raw_base&&) = delete;
+		};
+	} //namespace _p
+
+	class file_read_raw: public _p::file_raw_base
+	{
+	public:
+		std::errc open(std::filesystem::path const& p_path);
+		uintptr_t read(void* p_buff, uintptr_t p_size);
+		uintptr_t read_offset(void* p_buff, uintptr_t p_size, int64_t p_offset);
+
+		///	\brief Reads only what can be served without waiting for the storage (preadv2 with RWF_NOWAIT)
+		///	\param[out] p_read - Number of bytes read
+		///	\return std::errc::resource_unavailable_try_again if the data is not readily available,
+		///		std::errc::not_supported if the system does not support the operation
+		std::errc read_offset_nowait(void* p_buff, uintptr_t p_size, int64_t p_offset, uintptr_t& p_read);
+	};
+
+	///	\remarks Writes are collected in a user space buffer if one is set with \ref set_buffer_size, by default writes go straight to the file.
+	class file_write_raw: public _p::file_raw_base
+	{
+	public:
+		~file_write_raw();
+
+		std::errc open(std::filesystem::path const& p_path, open_mode p_mode, bool p_create_directories = true);
+		void close();
+
+		///	\brief Sets the size of the write buffer, 0 disables buffering. Flushes any pending data.
+		std::errc set_buffer_size(uintptr_t p_size);
+
+		uintptr_t write(void const* p_buff, uintptr_t p_size);
+		std::errc flush();
+		std::errc resize(int64_t p_size);
+
+		///	\brief Writes at the given offset, pending data is flushed first
+		uintptr_t write_offset(void const* p_buff, uintptr_t p_size, int64_t p_offset);
+
+		[[nodiscard]] int64_t pos() const;
+		std::errc seek(int64_t p_pos);
+		std::errc seek_current(int64_t p_pos);
+		std::errc seek_end(int64_t p_pos);
+
+		///	\brief Size the file will have once pending data is flushed
+		[[nodiscard]] int64_t size() const;
+
+	private:
+		std::unique_ptr<uint8_t[]>	m_buffer;
+		uintptr_t					m_capacity	= 0;
+		uintptr_t					m_used		= 0;
+	};
+
+	class file_duplex_raw: public _p::file_raw_base
+	{
+	public:
+		std::errc open(std::filesystem::path const& p_path, open_mode p_mode, bool p_create_directories = true);
+
+		uintptr_t read (void* p_buff, uintptr_t p_size);
+		uintptr_t write(void const* p_buff, uintptr_t p_size);
+		std::errc resize(int64_t p_size);
+
+		uintptr_t read_offset(void* p_buff, uintptr_t p_size, int64_t p_offset);
+		uintptr_t write_offset(void const* p_buff, uintptr_t p_size, int64_t p_offset);
+
+		///	\copydoc file_read_raw::read_offset_nowait
+		std::errc read_offset_nowait(void* p_buff, uintptr_t p_size, int64_t p_offset, uintptr_t& p_read);
+	};
+
+	///	\brief Reads and writes bypassing the system's page cache (O_DIRECT)
+	///	\remarks
+	///		Buffer addresses must be aligned to \ref memory_alignment, offsets and sizes to \ref offset_alignment.
+	///		To end a file on an unaligned size, write the last block in full and then \ref resize.
+	///		Not all file systems support direct I/O, in which case open fails with std::errc::invalid_argument.
+	class file_direct: public _p::file_raw_base
+	{
+	public:
+		enum class access: uint8_t
+		{
+			read_only = 0,
+			read_write,
+		};
+
+	public:
+		///	\remarks open modes other than open_existing are only valid with access::read_write
+		std::errc open(std::filesystem::path const& p_path, access p_access, open_mode p_mode = open_mode::open_existing, bool p_create_directories = true);
+
+		[[nodiscard]] inline uintptr_t offset_alignment() const { return m_offset_alignment; }
+		[[nodiscard]] inline uintptr_t memory_alignment() const { return m_memory_alignment; }
+
+		[[nodiscard]] bool is_aligned(void const* p_buff, uintptr_t p_size, int64_t p_offset) const;
+
+		///	\param[out] p_read - Number of bytes read, less than p_size when the end of the file is reached
+		///	\return std::errc::invalid_argument if the request is not aligned
+		std::errc read_offset(void* p_buff, uintptr_t p_size, int64_t p_offset, uintptr_t& p_read);
+		///	\param[out] p_written - Number of bytes written
+		///	\return std::errc::invalid_argument if the request is not aligned
+		std::errc write_offset(void const* p_buff, uintptr_t p_size, int64_t p_offset, uintptr_t& p_written);
+
+		std::errc resize(int64_t p_size);
+
+	private:
+		uintptr_t m_offset_alignment = 0;
+		uintptr_t m_memory_alignment = 0;
+	};
+#endif
+
+	///	\brief Maps a file, or a window of it, into memory.
+	///	\remarks Only one window is mapped at a time, calling \ref map again replaces it.
+	///		Files larger than the address space can be traversed by mapping successive windows.
+	class file_mmap
+	{
+	public:
+		using open_mode = _p::file_base::open_mode;
+
+		enum class access: uint8_t
+		{
+			read_only = 0,
+			read_write,
+		};
+
+		enum class advice: uint8_t
+		{
+			normal = 0,
+			sequential,
+			random,
+			will_need,
+			dont_need,
+			huge_page,
+		};
+
+	public:
+		file_mmap() = default;
+		~file_mmap();
+
+		///	\remarks open modes other than open_existing are only valid with access::read_write
+		std::errc open(std::filesystem::path const& p_path, access p_access, open_mode p_mode = open_mode::open_existing, bool p_create_directories = true);
+		void close();
+
+		[[nodiscard]] bool is_open() const;
+		[[nodiscard]] inline bool is_mapped() const { return m_view != nullptr; }
+
+		[[nodiscard]] int64_t file_size() const;
+		std::errc resize(int64_t p_size);
+
+		///	\brief Maps the range [p_offset, p_offset + p_size) of the file
+		///	\param[in] p_offset - Start of the window, does not need to be aligned
+		///	\param[in] p_size - Size of the window, 0 maps up to the end of the file
+		std::errc map(int64_t p_offset = 0, uintptr_t p_size = 0);
+		void unmap();
+
+		///	\brief Hints the system on how the window will be accessed
+		std::errc advise(advice p_advice);
+		///	\param[in] p_offset - relative to the start of the window
+		std::errc advise(advice p_advice, uintptr_t p_offset, uintptr_t p_size);
+
+		///	\brief Writes modified pages of the window back to the file
+		///	\param[in] p_wait - If true waits for the write to complete, otherwise only schedules it
+		std::errc flush(bool p_wait = true);
+		///	\param[in] p_offset - relative to the start of the window
+		std::errc flush(uintptr_t p_offset, uintptr_t p_size, bool p_wait = true);
+
+		///	\return File offset of the window
+		[[nodiscard]] inline int64_t offset() const { return m_offset; }
+		[[nodiscard]] inline std::span<uint8_t const> view() const { return {m_view + m_lead, m_size}; }
+		///	\return The window, or an empty span if the file was open as read only
+		[[nodiscard]] inline std::span<uint8_t> writable_view() const
+		{
+			return m_access == access::read_write ? std::span<uint8_t>{m_view + m_lead, m_size} : std::span<uint8_t>{};
+		}
+
+	private:
+#ifdef _WIN32
+		void*		m_file		= nullptr;
+		void*		m_mapping	= nullptr;
+#else
+		int			m_fd		= -1;
+#endif
+		uint8_t*	m_view		= nullptr;	//!< Start of the mapping, aligned to the system's granularity
+		uintptr_t	m_lead		= 0;		//!< Distance from \ref m_view to the requested offset
+		uintptr_t	m_size		= 0;
+		int64_t		m_offset	= 0;
+		access		m_access	= access::read_only;
+
+		file_mmap(file_mmap const&) = delete;
+		file_mmap(file_mmap&&) = delete;
+		file_mmap& operator = (file_mmap const&) = delete;
+		file_mmap& operator = (file_mmap&&) = delete;
+	};
+
 } //namespace core
@@ -0,0 +1,257 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <atomic>
+#include <system_error>
+
+#include "core_file.hpp"
+#include "core_sync.hpp"
+#include "core_thread.hpp"
+
+namespace core
+{
+#ifdef __linux__
+	///	\brief Queues offset reads and writes to the kernel (io_uring) and reports their completions in batches.
+	///	\remarks
+	///		Buffers must remain valid until the respective operation completes.
+	///		Files opened with the stdio based classes must not have pending buffered data on the affected range,
+	///		the engine operates directly on the file descriptor.
+	///		Not thread safe.
+	class file_async
+	{
+	public:
+		///	\brief Identifies the target file of an operation, either a file descriptor or an index into the registered files.
+		struct target
+		{
+			int32_t	value;
+			bool	registered;
+		};
+
+		struct completion
+		{
+			uint64_t	user_data;
+			int32_t		result;	//!< Number of bytes transferred, or the negative of the error code
+		};
+
+	public:
+		file_async() = default;
+		~file_async();
+
+		///	\param[in] p_depth - Number of operations that can be queued before submission
+		///	\return std::errc::not_supported if the system does not support io_uring
+		std::errc open(uint32_t p_depth);
+		void close();
+		[[nodiscard]] inline bool is_open() const { return m_ring != -1; }
+
+		[[nodiscard]] static inline target descriptor(int p_fd) { return target{p_fd, false}; }
+		[[nodiscard]] static inline target registered(uint32_t p_index) { return target{static_cast<int32_t>(p_index), true}; }
+		[[nodiscard]] static target descriptor(_p::file_base& p_file);
+		[[nodiscard]] static inline target descriptor(_p::file_raw_base const& p_file) { return target{p_file.handle(), false}; }
+
+		///	\brief Registers a set of file descriptors, to be referred by their index with \ref registered.
+		///	\remarks Avoids the per operation cost of acquiring the file.
+		std::errc register_files(std::span<int const> p_fds);
+		std::errc unregister_files();
+
+		///	\brief Registers a set of buffers to be used with \ref queue_read_fixed and \ref queue_write_fixed.
+		///	\remarks Buffers are pinned for the duration of the registration, avoiding the per operation mapping cost.
+		std::errc register_buffers(std::span<std::span<uint8_t> const> p_buffers);
+		std::errc unregister_buffers();
+
+		//	All queue functions return std::errc::resource_unavailable_try_again if the queue is full
+		//	and can not be flushed, completions need to be reaped before more operations can be queued.
+		std::errc queue_read (target p_file, void* p_buff, uint32_t p_size, int64_t p_offset, uint64_t p_user_data);
+		std::errc queue_write(target p_file, void const* p_buff, uint32_t p_size, int64_t p_offset, uint64_t p_user_data);
+
+		///	\param[in] p_buffer_index - Index of the registered buffer containing [p_buff, p_buff + p_size)
+		std::errc queue_read_fixed (target p_file, uint16_t p_buffer_index, void* p_buff, uint32_t p_size, int64_t p_offset, uint64_t p_user_data);
+		std::errc queue_write_fixed(target p_file, uint16_t p_buffer_index, void const* p_buff, uint32_t p_size, int64_t p_offset, uint64_t p_user_data);
+
+		std::errc queue_fsync(target p_file, bool p_data_only, uint64_t p_user_data);
+
+		///	\brief Queues a write followed by an fsync that only starts after the write succeeds.
+		///	\remarks If the write fails the fsync completes with -ECANCELED.
+		std::errc queue_write_fsync(target p_file, void const* p_buff, uint32_t p_size, int64_t p_offset, uint64_t p_write_user_data, uint64_t p_fsync_user_data, bool p_data_only);
+
+		///	\brief Hands all queued operations to the kernel.
+		std::errc submit();
+
+		///	\brief Submits queued operations and blocks until at least p_count completions are available.
+		std::errc wait(uint32_t p_count);
+
+		///	\brief Collects available completions without blocking.
+		///	\return Number of completions written to p_out
+		uint32_t reap(std::span<completion> p_out);
+
+		[[nodiscard]] inline uint32_t queued() const { return m_queued; }
+		[[nodiscard]] inline uint32_t depth() const { return m_sq_entries; }
+
+	private:
+		void* acquire_entries(uint32_t p_count);
+		void push_entry();
+		std::errc enter(uint32_t p_min_complete, uint32_t p_flags);
+
+	private:
+		int			m_ring			= -1;
+		uint32_t	m_sq_entries	= 0;
+		uint32_t	m_queued		= 0;
+		uint32_t	m_sq_tail		= 0;
+
+		uint32_t*	m_sq_head_ptr	= nullptr;
+		uint32_t*	m_sq_tail_ptr	= nullptr;
+		uint32_t*	m_sq_array		= nullptr;
+		uint32_t	m_sq_mask		= 0;
+		void*		m_sqes			= nullptr;
+
+		uint32_t*	m_cq_head_ptr	= nullptr;
+		uint32_t*	m_cq_tail_ptr	= nullptr;
+		uint32_t	m_cq_mask		= 0;
+		void*		m_cqes			= nullptr;
+
+		void*		m_sq_map		= nullptr;
+		uintptr_t	m_sq_map_size	= 0;
+		void*		m_cq_map		= nullptr;
+		uintptr_t	m_cq_map_size	= 0;
+		uintptr_t	m_sqes_size		= 0;
+
+	private:
+		file_async(file_async const&) = delete;
+		file_async(file_async&&) = delete;
+		file_async& operator = (file_async const&) = delete;
+		file_async& operator = (file_async&&) = delete;
+	};
+#endif // __linux__
+
+	namespace _p
+	{
+		struct file_write_async_ring;
+	} //namespace _p
+
+	///	\brief Takes writes from many threads without blocking them on I/O, a background thread writes the data to a file.
+	///	\remarks
+	///		Each thread writing gets its own staging ring, writing to it is lock free.
+	///		The background thread drains all rings with a single vectored write when a ring reaches the byte threshold,
+	///		or when the flush interval elapses, while threads keep filling the space already drained.
+	///		The data of each \ref write call is kept contiguous, but data from different threads is only ordered at flush granularity.
+	///		Memory used is bounded by the staging size times the number of threads that write, rings of threads that exit are reused.
+	///		\ref start and \ref stop must not be called concurrently with \ref write.
+	class file_write_async
+	{
+	public:
+		///	\brief What to do when a thread's staging ring is full
+		enum class overflow: uint8_t
+		{
+			block,	//!< Wait for the background thread to make room, gives up if the file fails to take the data
+			drop,	//!< Discard the data, see \ref dropped
+		};
+
+	public:
+		file_write_async() = default;
+		~file_write_async();
+
+		///	\param[in] p_file - Destination, must remain open until \ref stop
+		///	\param[in] p_staging_size - Size of each thread's staging ring, rounded up to a power of 2
+		///	\param[in] p_flush_bytes - Amount of data pending in a ring that wakes the background thread
+		///	\param[in] p_flush_interval - Maximum time in milliseconds data is held before being written, 0 to only flush on p_flush_bytes
+		///	\param[in] p_policy - What to do when a ring is full
+		std::errc start(file_write& p_file, uintptr_t p_staging_size = 0x10000, uintptr_t p_flush_bytes = 0x4000, uint32_t p_flush_interval = 100, overflow p_policy = overflow::block);
+
+		///	\brief Writes out all pending data and stops the background thread
+		void stop();
+
+		[[nodiscard]] inline bool is_running() const { return m_file != nullptr; }
+
+		///	\return std::errc{} if the data was staged,
+		///		std::errc::bad_file_descriptor if the writer is not running,
+		///		std::errc::no_buffer_space if the data was discarded due to \ref overflow::drop or for lack of memory,
+		///		std::errc::io_error if the writer gave up waiting for room, see remarks
+		///	\remarks Data larger than the staging size is split when \ref overflow::block is used, and discarded with \ref overflow::drop
+		///	\warning With \ref overflow::block, if the file fails to take the data (ex. disk full) while waiting for room,
+		///		the part not yet staged is discarded rather than waiting forever. It is counted in \ref dropped,
+		///		the part already staged may still be written once the file accepts it again.
+		std::errc write(void const* p_data, uintptr_t p_size);
+
+		///	\brief Reserves space in the calling thread's staging ring, to be filled in place and published with \ref commit
+		///	\param[in] p_size - Number of bytes to reserve
+		///	\param[in] p_alignment - Alignment required for the space, must be a power of 2
+		///	\return nullptr if the space is not readily available as a contiguous block, or is not aligned, \ref write should then be used instead
+		///	\remarks The position in the ring follows the data written, it can not be padded, text of an odd size leaves the next reservation misaligned.
+		[[nodiscard]] void* reserve(uintptr_t p_size, uintptr_t p_alignment = 1);
+
+		///	\brief Publishes the first p_size bytes of the space obtained with \ref reserve
+		void commit(uintptr_t p_size);
+
+		///	\brief Writes out all data staged so far, from the calling thread
+		void flush();
+
+		///	\return Number of bytes discarded due to \ref overflow::drop, or because they could not be written by the time of \ref stop
+		[[nodiscard]] inline uint64_t dropped() const { return m_dropped.load(std::memory_order::relaxed); }
+
+		///	\return Number of times the file did not accept all the data given to it.
+		///	\remarks Data that was not written stays queued, and is retried on the next flush.
+		[[nodiscard]] inline uint64_t write_errors() const { return m_write_errors.load(std::memory_order::relaxed); }
+
+	private:
+		_p::file_write_async_ring* bind();
+		void wake();
+		void drain();
+		void flusher(void*);
+
+	private:
+		file_write*			m_file				= nullptr;
+		uint64_t			m_id				= 0;
+		uintptr_t			m_staging_size		= 0;
+		uintptr_t			m_flush_bytes		= 0;
+		uint32_t			m_flush_interval	= 0;
+		overflow			m_policy			= overflow::block;
+
+		std::atomic<bool>		m_stop			{false};
+		std::atomic<bool>		m_wake			{false};
+		std::atomic<uint64_t>	m_dropped		{0};
+		std::atomic<uint64_t>	m_write_errors	{0};
+
+		atomic_spinlock									m_lock;			//!< Protects m_rings
+		std::vector<_p::file_write_async_ring*>			m_rings;
+		mutex											m_drain_lock;
+		std::vector<std::span<uint8_t const>>			m_segments;		//!< Protected by m_drain_lock
+
+		event_trap	m_trap;
+		thread		m_thread;
+
+	private:
+		file_write_async(file_write_async const&) = delete;
+		file_write_async(file_write_async&&) = delete;
+		file_write_async& operator = (file_write_async const&) = delete;
+		file_write_async& operator = (file_write_async&&) = delete;
+	};
+} //namespace core
@@ -0,0 +1,179 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		Provides latency histograms and scoped timers to instrument hot paths
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <vector>
+
+#include <CoreLib/core_sync.hpp>
+#include <CoreLib/core_time.hpp>
+
+namespace core
+{
+	namespace _p
+	{
+		struct latency_shard;
+	} //namespace _p
+
+	///	\brief	Log-linear (HDR style) histogram of latencies in nanoseconds.
+	///	\remarks	Values below 128 have their own bucket, above that every power of 2 is split into 64 buckets,
+	///			so any value is reported with a relative error below 1/64.
+	///			Not thread safe, use \ref latency_recorder to record from several threads.
+	class latency_histogram
+	{
+	public:
+		static constexpr uint8_t	sub_bucket_bits	= 6;
+		static constexpr uintptr_t	bucket_count	= uintptr_t{65 - sub_bucket_bits} << sub_bucket_bits;
+
+		[[nodiscard]] static constexpr uintptr_t bucket_index(uint64_t const p_value)
+		{
+			uint8_t const magnitude = static_cast<uint8_t>(std::bit_width(p_value | (uint64_t{1} << sub_bucket_bits)) - sub_bucket_bits - 1);
+			return (uintptr_t{magnitude} << sub_bucket_bits) + static_cast<uintptr_t>(p_value >> magnitude);
+		}
+
+		///	\brief Smallest value that falls into bucket p_index
+		[[nodiscard]] static constexpr uint64_t bucket_lowest(uintptr_t const p_index)
+		{
+			uint8_t const magnitude = p_index < (uintptr_t{2} << sub_bucket_bits) ? uint8_t{0} : static_cast<uint8_t>((p_index >> sub_bucket_bits) - 1);
+			return static_cast<uint64_t>(p_index - (uintptr_t{magnitude} << sub_bucket_bits)) << magnitude;
+		}
+
+		///	\brief Largest value that falls into bucket p_index
+		[[nodiscard]] static constexpr uint64_t bucket_highest(uintptr_t const p_index)
+		{
+			return p_index + 1 < bucket_count ? bucket_lowest(p_index + 1) - 1 : ~uint64_t{0};
+		}
+
+	public:
+		latency_histogram();
+
+		inline void record(uint64_t const p_value)
+		{
+			++m_buckets[bucket_index(p_value)];
+			++m_count;
+			m_sum += p_value;
+			if(p_value < m_min) m_min = p_value;
+			if(p_value > m_max) m_max = p_value;
+		}
+
+		///	\brief Adds all values recorded in p_other
+		void merge(latency_histogram const& p_other);
+		void reset();
+
+		[[nodiscard]] inline uint64_t count() const { return m_count; }
+		[[nodiscard]] inline uint64_t sum() const { return m_sum; }
+		[[nodiscard]] inline uint64_t min() const { return m_count ? m_min : 0; }
+		[[nodiscard]] inline uint64_t max() const { return m_max; }
+		[[nodiscard]] inline uint64_t mean() const { return m_count ? m_sum / m_count : 0; }
+		[[nodiscard]] inline uint64_t bucket(uintptr_t const p_index) const { return m_buckets[p_index]; }
+
+		///	\brief	Value at or below which p_percentile percent of the recorded values fall.
+		///	\param[in] p_percentile - In the range [0, 100]
+		///	\return	Highest value of the bucket the percentile falls in, clamped to [min(), max()]. 0 if empty.
+		[[nodiscard]] uint64_t percentile(double p_percentile) const;
+
+	private:
+		friend class latency_recorder;
+
+		std::vector<uint64_t>	m_buckets;
+		uint64_t				m_count	= 0;
+		uint64_t				m_sum	= 0;
+		uint64_t				m_min	= ~uint64_t{0};
+		uint64_t				m_max	= 0;
+	};
+
+	///	\brief	Records latencies from any number of threads into a \ref latency_histogram.
+	///	\remarks	Every thread records into its own shard, recording takes no lock and issues no atomic read-modify-write.
+	///			A thread takes the lock only the first time it records into a given recorder, it then keeps its shard for as long as the recorder lives.
+	///			Shards left by threads that exited are reused.
+	///			\ref snapshot merges all shards, it can be called while other threads record.
+	class latency_recorder
+	{
+	public:
+		latency_recorder();
+		~latency_recorder();
+
+		latency_recorder(latency_recorder const&) = delete;
+		latency_recorder& operator = (latency_recorder const&) = delete;
+
+		void record(uint64_t p_value);
+
+		[[nodiscard]] latency_histogram snapshot() const;
+
+		///	\brief Clears all shards
+		///	\warning Values recorded concurrently with the reset may partially survive it
+		void reset();
+
+	private:
+		_p::latency_shard* bind();
+
+	private:
+		uint64_t							m_id = 0;
+		mutable atomic_spinlock				m_lock;		//!< Protects m_shards
+		std::vector<_p::latency_shard*>		m_shards;
+	};
+
+	///	\brief	Records the time spent in a scope.
+	///	\tparam Target - \ref latency_histogram or \ref latency_recorder
+	template<typename Target>
+	class scoped_latency
+	{
+	public:
+		inline scoped_latency(Target& p_target)
+			: m_target(p_target)
+		{
+			m_chrono.set();
+		}
+
+		inline ~scoped_latency()
+		{
+			m_target.record(m_chrono.elapsed());
+		}
+
+		scoped_latency(scoped_latency const&) = delete;
+		scoped_latency& operator = (scoped_latency const&) = delete;
+
+		///	\brief Records the time since construction (or the last lap) and starts measuring again
+		inline void lap()
+		{
+			m_target.record(m_chrono.elapsed());
+			m_chrono.set();
+		}
+
+	private:
+		Target&	m_target;
+		chrono	m_chrono;
+	};
+
+	template<typename Target> scoped_latency(Target&) -> scoped_latency<Target>;
+
+} //namespace core
@@ -0,0 +1,132 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <CoreLib/core_sync.hpp>
+
+namespace core
+{
+	namespace _p
+	{
+		struct profiler_sample;
+	} //namespace _p
+
+	///	\brief	In-process statistical profiler, samples the call stacks of attached threads at a fixed rate of their CPU time.
+	///	\remarks
+	///		Each attached thread gets its own CPU time timer (timer_create on CLOCK_THREAD_CPUTIME_ID) delivering SIGPROF to that thread,
+	///		so idle threads are not sampled. The signal handler walks the stack with backtrace and pushes the raw addresses
+	///		into a preallocated lock-free ring, it does not allocate nor take locks.
+	///		\ref collect drains the ring into an aggregate of unique stacks, \ref folded prints it in the folded stack format
+	///		used by flame graph tools, with module relative addresses from \ref list_modules.
+	///
+	///		Only one profiler can be running at a time.
+	///	\note Linux only, on other platforms \ref start returns std::errc::not_supported.
+	class sampling_profiler
+	{
+	public:
+		static constexpr uintptr_t max_frames = 64;
+
+	public:
+		sampling_profiler();
+		~sampling_profiler();
+
+		sampling_profiler(sampling_profiler const&) = delete;
+		sampling_profiler& operator = (sampling_profiler const&) = delete;
+
+		///	\brief Installs the SIGPROF handler and allocates the sample ring.
+		///	\param[in] p_frequency - samples per second of thread CPU time
+		///	\param[in] p_capacity - number of samples the ring can hold between calls to \ref collect, rounded up to a power of 2
+		///	\return std::errc{} on success,
+		///		std::errc::device_or_resource_busy if another profiler is running,
+		///		std::errc::invalid_argument if p_frequency is 0 or above 1MHz
+		std::errc start(uint32_t p_frequency, uintptr_t p_capacity = 4096);
+
+		///	\brief Stops sampling, deletes the timers of all attached threads and sets SIGPROF to be ignored.
+		///	\remarks	The previous handler is not restored, a signal from a deleted timer may still be pending and would otherwise terminate the process.
+		///	\remarks Samples already taken are kept, they can still be collected.
+		void stop();
+
+		///	\brief Starts sampling the calling thread.
+		///	\return std::errc{} on success, std::errc::operation_not_permitted if the profiler is not running
+		///	\remarks	Threads should detach before they exit. Timers left by threads that exited without detaching
+		///			are deleted on the next call to attach_thread.
+		std::errc attach_thread();
+
+		///	\brief Stops sampling the calling thread.
+		void detach_thread();
+
+		///	\brief Moves pending samples from the ring into the aggregate.
+		///	\return Number of samples collected
+		///	\remarks Not thread safe, call from one thread at a time. Should be called often enough that the ring does not fill up.
+		uintptr_t collect();
+
+		///	\brief Aggregated stacks in the folded stack format, one line per unique stack, outermost frame first,
+		///		"module+0xoffset;module+0xoffset count", or "symbol;symbol count" when p_names is set.
+		///	\remarks Calls \ref collect first.
+		[[nodiscard]] std::u8string folded(bool p_names = false);
+
+		///	\brief Total number of samples aggregated
+		[[nodiscard]] inline uint64_t sample_count() const { return m_samples; }
+
+		///	\brief Number of samples lost because the ring was full
+		[[nodiscard]] inline uint64_t dropped() const { return m_dropped.load(std::memory_order::relaxed); }
+
+		///	\brief Clears the aggregate
+		void reset();
+
+	private:
+		friend struct _p::profiler_sample;
+
+		void push(void* p_context);
+
+	private:
+		std::unique_ptr<_p::profiler_sample[]>			m_ring;
+		uintptr_t										m_mask = 0;
+		alignas(64) std::atomic<uint64_t>				m_write = 0;
+		alignas(64) std::atomic<uint64_t>				m_read = 0;
+		std::atomic<uint64_t>							m_dropped = 0;
+
+		uint64_t										m_interval_ns = 0;
+		bool											m_running = false;	//!< Protected by m_lock
+		atomic_spinlock									m_lock;		//!< Protects m_timers
+		std::vector<std::pair<uint64_t, void*>>			m_timers;	//!< Thread id and timer of attached threads
+
+		std::map<std::vector<uintptr_t>, uint64_t>		m_stacks;
+		uint64_t										m_samples = 0;
+	};
+
+} //namespace core
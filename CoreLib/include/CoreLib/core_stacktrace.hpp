@@ -30,6 +30,11 @@
 
 #include <list>
 #include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
 
 #include "string/core_os_string.hpp"
 
@@ -62,6 +67,41 @@ uint8_t generate_coredump();
 ///	\bug invalid arguments passed to C runtime function are known to not be captured by this
 bool register_crash_trace(std::filesystem::path const& p_output_file);
 
+#ifndef _WIN32
+///	\brief Primes the application to output a raw stack trace on a crash, using only async-signal-safe calls
+///	\details
+///		The handler does not allocate nor resolve symbols, it writes with write() only:
+///		- Signal number, signal information code, and critical address
+///		- Process ID, thread ID, and time of the event
+///		- Raw stack addresses
+///		- The module map (a copy of /proc/self/maps)
+///
+///		Use \ref symbolize_crash_trace to turn the file into a readable stack trace, this can be done offline on another machine
+///		as long as the same binaries are available at the same paths.
+///
+///	\param[in] p_output_file - the name of the output file, relative paths are relative to the application directory
+///
+///	\return true if stack trace was registered successfully
+///	\note Linux only. Replaces a handler installed by \ref register_crash_trace.
+bool register_crash_trace_raw(std::filesystem::path const& p_output_file);
+
+///	\brief Resolves a trace written by \ref register_crash_trace_raw
+///	\details Each address is resolved against the module it was loaded from, using the ELF symbol tables of that module (.symtab, or .dynsym if stripped).
+///	\param[in] p_trace - contents of the raw trace file
+///	\param[out] p_output - readable stack trace
+///	\return std::errc{} on success, std::errc::invalid_argument if p_trace is not a raw trace
+///	\note Linux only. Modules that can not be read are reported with module relative addresses only.
+std::errc symbolize_crash_trace(std::u8string_view p_trace, std::u8string& p_output);
+
+///	\brief Resolves code addresses of the current process to function names, using the ELF symbol tables of the loaded modules
+///	\details Unlike backtrace_symbols, this also resolves functions that are not exported.
+///	\param[in] p_addresses - code addresses, return addresses should be moved back into the call instruction
+///	\param[out] p_names - demangled name of the function each address belongs to, empty if not resolved
+///	\return std::errc{} on success
+///	\note Linux only
+std::errc resolve_symbols(std::span<uintptr_t const> p_addresses, std::vector<std::u8string>& p_names);
+#endif
+
 ///	\brief Pairs module name and base address
 struct ModuleAddr
 {
@@ -200,7 +200,7 @@ public:
 	template <class T>
 	Error create(T* const p_object, void (T::*const p_method)(void *), void* const p_param)
 	{
-		if(m_handle) return Error::AlreadyInUse;
+		if(joinable()) return Error::AlreadyInUse;
 
 		_p::thread_obj_redir<T>* t_obj = new _p::thread_obj_redir<T>(p_object, p_method, p_param);
 
@@ -31,6 +31,13 @@
 #include <cstdint>
 #include <cstring>
 #include <chrono>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_M_AMD64) or defined(__amd64__)
+#	include <CoreLib/cpu/x64.hpp>
+#endif
 
 namespace core
 {
@@ -73,6 +80,8 @@ struct date_time_extra
 ///			that the smallest non 0 value can be in the order of 100 nanoseconds or higher
 ///
 ///	\warning	Value may overflow before reaching uint64_t limit.
+///	\warning	On POSIX, when an invariant time stamp counter is available (see \ref tsc_clock) it is used instead of CLOCK_BOOTTIME,
+///				and time spent while the system is suspended is not counted. Use \ref clock_stamp to measure across a suspend.
 class chrono
 {
 private:
@@ -101,6 +110,7 @@ public:
 ///
 ///	\warning	Internal counter may overflow before reaching uint64_t limit,
 ///				when this occurs value will be invalid until reset.
+///	\warning	Same as \ref chrono, time spent while the system is suspended is not counted when the time stamp counter is used.
 class track_chrono
 {
 private:
@@ -146,6 +156,15 @@ void date_time_local(date_time_t& p_out);
 /// \brief	gets the current local date and time based on internal clock
 void date_time_local(date_time_t& p_out, date_time_extra& p_extra);
 
+/// \brief	Same as \ref date_time_local, but the broken-down date is cached per thread and only recomputed when the second changes.
+///	\remarks	Meant for callers that timestamp at a high rate (ex. loggers), it avoids the OS local time conversion
+///			(and any lock it may take) on all but the first call of every second.
+///			A change of the system time zone is only seen once the second changes.
+void date_time_local_cached(date_time_t& p_out);
+
+/// \brief	Same as \ref date_time_local, but the broken-down date is cached per thread and only recomputed when the second changes.
+void date_time_local_cached(date_time_t& p_out, date_time_extra& p_extra);
+
 
 
 class time_delta_t;
@@ -226,6 +245,10 @@ public:
 
 	constexpr int64_t raw() const { return raw_data; }
 
+	/// \brief Converts from nanoseconds, truncated to the 100ns resolution of raw()
+	static constexpr time_delta_t from_nanoseconds(int64_t const p_nanoseconds) { return time_delta_t{p_nanoseconds / 100}; }
+	constexpr int64_t nanoseconds() const { return raw_data * 100; }
+
 private:
 	int64_t raw_data = 0;
 };
@@ -257,13 +280,97 @@ inline time_point_t& time_point_t::operator -= (time_delta_t const p_other)
 	return *this;
 }
 
+#if defined(_M_AMD64) or defined(__amd64__)
+
+/// \brief	Clock based on the CPU's time stamp counter, reading it is much cheaper than asking the OS.
+///	\remarks	It is only used if the counter is invariant (i.e. it keeps a constant rate regardless of
+///			power states), otherwise \ref is_invariant is false and the conversions return 0.
+///			The rate is calibrated once against the OS monotonic clock, which takes about 10ms on first use.
+///			On POSIX, \ref chrono and \ref track_chrono use this clock when it is available,
+///			the counter does not advance while the system is suspended, unlike CLOCK_BOOTTIME they would otherwise use.
+///			\ref clock_stamp does not, it keeps reading the OS clock so that it does not drift from it.
+class tsc_clock
+{
+public:
+	/// \brief Raw counter value, may be reordered with surrounding instructions
+	[[nodiscard]] static inline uint64_t read() { return __rdtsc(); }
+
+	/// \brief Raw counter value, waits for all previous instructions to complete before reading
+	[[nodiscard]] static inline uint64_t read_ordered()
+	{
+		unsigned int aux;
+		return __rdtscp(&aux);
+	}
+
+	/// \brief True if the counter is invariant and has been calibrated
+	[[nodiscard]] static bool is_invariant();
+
+	/// \return Counter ticks per second, 0 if not invariant
+	[[nodiscard]] static uint64_t frequency();
+
+	/// \brief Converts a number of counter ticks to nanoseconds
+	[[nodiscard]] static uint64_t to_nanoseconds(uint64_t p_ticks);
+
+	/// \brief Converts a difference of counter values to a \ref time_delta_t
+	[[nodiscard]] static time_delta_t to_time_delta(int64_t p_ticks);
+};
+
+#endif
+
 [[nodiscard]] time_point_t system_time_fast();
 [[nodiscard]] time_point_t system_time_precise();
 
+/// \brief	Current system time read from the OS's coarse clock, it is only updated every scheduler tick (typically 1 to 16ms).
+///	\remarks	Use it where resolution is not important. On Linux it is cheaper than \ref system_time_fast,
+///			on Windows \ref system_time_fast already reads the coarse clock so the two are equivalent.
+[[nodiscard]] time_point_t system_time_coarse();
+
 time_point_t date_to_system_time(date_time_t const& value);
 date_time_t system_time_to_date(time_point_t value);
 
+/// \brief	Converts a batch of time points, same as calling \ref system_time_to_date on each element.
+///	\return	Number of elements converted, the smallest of p_in.size() and p_out.size().
+uintptr_t system_time_to_date(std::span<time_point_t const> p_in, std::span<date_time_t> p_out);
+
 core::date_time_t to_date(std::chrono::system_clock::time_point p_time);
 
+namespace _p
+{
+	template <typename>
+	struct is_supported_time_conv_c: public std::false_type {};
+	template <> struct is_supported_time_conv_c<char8_t >: public std::true_type {};
+	template <> struct is_supported_time_conv_c<char16_t>: public std::true_type {};
+	template <> struct is_supported_time_conv_c<char32_t>: public std::true_type {};
+
+	template<typename T>
+	concept c_time_conv_char = is_supported_time_conv_c<T>::value;
+} //namespace _p
+
+/// \brief Size of the longest ISO 8601 timestamp, "YYYY-MM-DDTHH:MM:SS.fffffffffZ"
+constexpr uintptr_t iso8601_max_size = 30;
+
+///	\brief	Number of characters written by \ref to_chars_iso8601_unsafe
+///	\param[in] p_fraction_digits - Number of digits in the fractional seconds, values above 9 are treated as 9
+[[nodiscard]] constexpr uintptr_t to_chars_iso8601_size(uint8_t const p_fraction_digits)
+{
+	return p_fraction_digits ? 21 + (p_fraction_digits < 9 ? p_fraction_digits : 9) : 20;
+}
+
+///	\brief	Writes an ISO 8601 (RFC 3339) UTC timestamp, "YYYY-MM-DDTHH:MM:SS.fffffffffZ"
+///	\param[in] p_date - Date to write, fields must be in range and the year below 10000
+///	\param[in] p_fraction_digits - Number of digits in the fractional seconds (truncated), 0 omits the decimal point
+///	\param[out] p_out - Output buffer, must have room for \ref to_chars_iso8601_size characters
+///	\return Pointer past the last character written
+template<_p::c_time_conv_char CharT>
+CharT* to_chars_iso8601_unsafe(date_time_t const& p_date, uint8_t p_fraction_digits, CharT* p_out);
+
+///	\brief	Parses an ISO 8601 (RFC 3339) UTC timestamp, "YYYY-MM-DDTHH:MM:SS[.f]Z"
+///	\param[in] p_str - Text to parse, the separators 'T' and 'Z' may also be lower case.
+///		The fractional seconds are optional and take up to 9 digits.
+///	\param[out] p_out - Decoded date, only valid if the function returns true
+///	\return true if p_str is a well formed timestamp with all fields in range (a leap second of 60 is accepted)
+template<_p::c_time_conv_char CharT>
+[[nodiscard]] bool from_chars_iso8601(std::basic_string_view<CharT> p_str, date_time_t& p_out);
+
 
 } //namespace core
@@ -55,11 +55,36 @@ namespace core
 			using Net_Socket::set_linger;
 			using Net_Socket::poll;
 			using Net_Socket::shutdown;
+			using Net_Socket::set_receive_buffer_size;
+			using Net_Socket::get_receive_buffer_size;
+			using Net_Socket::set_send_buffer_size;
+			using Net_Socket::get_send_buffer_size;
+			using Net_Socket::set_reuse_port;
+			using Net_Socket::get_reuse_port;
+			using Net_Socket::set_reuse_port_cpu_steering;
+			using Net_Socket::set_busy_poll;
+			using Net_Socket::get_busy_poll;
+			using Net_Socket::set_incoming_cpu;
+			using Net_Socket::get_incoming_cpu;
 
 			///	\brief Sets the socket into listening mode
 			///	\param[in] p_max_connections - Number of connections allowed to be pending on the socket before starting to refuse them
 			///	\return \ref core::NET_Error
 			NET_Error listen(int p_max_connections);
+
+			///	\brief Enables TCP Fast Open on a listening socket (TCP_FASTOPEN)
+			///	\param[in] p_queue_length - Maximum number of pending Fast Open requests. 0 disables Fast Open.
+			///	\return \ref core::NET_Error
+			///	\remarks
+			///		Allows clients to send data on the SYN packet saving a round trip on repeated connections.
+			///		On Windows any value different than 0 simply turns the option on.
+			///		Should be set before \ref listen.
+			NET_Error set_fast_open(uint32_t p_queue_length);
+
+			///	\brief Gets the TCP Fast Open setting of the socket (TCP_FASTOPEN)
+			///	\param[out] p_queue_length - receives the maximum number of pending Fast Open requests, 0 if disabled.
+			///	\return \ref core::NET_Error
+			NET_Error get_fast_open(uint32_t& p_queue_length) const;
 		};
 
 		///	\brief Private class to implement generic TCP client functionality
@@ -74,6 +99,14 @@ namespace core
 			using Net_Socket::set_linger;
 			using Net_Socket::poll;
 			using Net_Socket::shutdown;
+			using Net_Socket::set_receive_buffer_size;
+			using Net_Socket::get_receive_buffer_size;
+			using Net_Socket::set_send_buffer_size;
+			using Net_Socket::get_send_buffer_size;
+			using Net_Socket::set_busy_poll;
+			using Net_Socket::get_busy_poll;
+			using Net_Socket::set_incoming_cpu;
+			using Net_Socket::get_incoming_cpu;
 			//using Net_Socket::SetReuseAddress;
 
 			///	\brief Used to check when the connection is established on a non-blocking socket
@@ -220,6 +253,61 @@ namespace core
 			///			https://linux.die.net/man/7/tcp
 			///		for more information.
 			NET_Error set_keep_alive(bool p_keepAlive, uint32_t p_probePeriod, uint32_t p_maxProbes);
+
+			///	\brief Turns on or off the quick acknowledgement mode (TCP_QUICKACK)
+			///	\param[in] p_quickAck - If true acknowledgements are sent immediately, if false they may be delayed
+			///	\return \ref core::NET_Error
+			///	\remarks
+			///		This setting is not permanent, the system may switch out of quick acknowledgement mode
+			///		depending on the protocol state, so it may need to be set again after receiving data.
+			///		Returns \ref core::NET_Error::Not_Supported on Windows.
+			NET_Error set_quick_ack(bool p_quickAck);
+
+			///	\brief Gets the current quick acknowledgement mode (TCP_QUICKACK)
+			///	\param[out] p_quickAck - receives the current setting
+			///	\return \ref core::NET_Error
+			NET_Error get_quick_ack(bool& p_quickAck) const;
+
+			///	\brief Turns on or off corking (TCP_CORK)
+			///	\param[in] p_cork - If true partial frames are held back, if false any queued data is sent immediately
+			///	\return \ref core::NET_Error
+			///	\remarks
+			///		While corked the system only sends full frames, allowing the user to build a message
+			///		with several \ref send_size calls and release it in one go by uncorking the socket.
+			///		Queued data is never held back for more than 200ms.
+			///		Returns \ref core::NET_Error::Not_Supported on Windows.
+			NET_Error set_cork(bool p_cork);
+
+			///	\brief Gets the current corking setting (TCP_CORK)
+			///	\param[out] p_cork - receives the current setting
+			///	\return \ref core::NET_Error
+			NET_Error get_cork(bool& p_cork) const;
+
+			///	\brief Sets the limit of unsent data queued on the socket for it to be considered writable (TCP_NOTSENT_LOWAT)
+			///	\param[in] p_size - Limit in bytes.
+			///	\return \ref core::NET_Error
+			///	\remarks
+			///		Reduces the amount of memory tied up on the send buffer, and the latency of data that has been queued but not yet sent.
+			///		Returns \ref core::NET_Error::Not_Supported on Windows.
+			NET_Error set_notsent_lowat(uint32_t p_size);
+
+			///	\brief Gets the limit of unsent data queued on the socket for it to be considered writable (TCP_NOTSENT_LOWAT)
+			///	\param[out] p_size - receives the limit in bytes
+			///	\return \ref core::NET_Error
+			NET_Error get_notsent_lowat(uint32_t& p_size) const;
+
+			///	\brief Enables TCP Fast Open on the client side of the connection (TCP_FASTOPEN_CONNECT)
+			///	\param[in] p_fastOpen - If true, data sent right after connect will be carried by the SYN packet if a Fast Open cookie is available.
+			///	\return \ref core::NET_Error
+			///	\remarks
+			///		Must be set before connecting.
+			///		Returns \ref core::NET_Error::Not_Supported on Windows.
+			NET_Error set_fast_open_connect(bool p_fastOpen);
+
+			///	\brief Gets the client side TCP Fast Open setting (TCP_FASTOPEN_CONNECT)
+			///	\param[out] p_fastOpen - receives the current setting
+			///	\return \ref core::NET_Error
+			NET_Error get_fast_open_connect(bool& p_fastOpen) const;
 		};
 	} //namesapce _p
 
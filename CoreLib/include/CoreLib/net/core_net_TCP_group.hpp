@@ -0,0 +1,151 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		Provides a group of TCP listeners sharing the same port
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <CoreLib/core_thread.hpp>
+
+#include "core_net_TCP.hpp"
+
+/// \n
+namespace core
+{
+	///	\brief Manages a group of TCP listeners bound to the same address and port (SO_REUSEPORT),
+	///		each one served by its own worker thread.
+	///	\remarks
+	///		The system distributes incoming connections across all listeners of the group,
+	///		allowing accepts to scale across cores instead of being serialized on a single socket.
+	///		Not supported on Windows.
+	class NetTCP_S_group
+	{
+	public:
+		using IPv = IP_address::IPv;
+
+		///	\brief Function run by each worker thread
+		///	\param[in] p_listener - The listener this worker is responsible for
+		///	\param[in] p_index - Index of the listener in the group
+		///	\param[in] p_context - User provided context
+		///	\remarks The function should return once \ref NetTCP_S::accept fails with an error other than \ref core::NET_Error::WouldBlock.
+		using worker_t = void (*)(NetTCP_S& p_listener, uint32_t p_index, void* p_context);
+
+	private:
+		struct worker_slot
+		{
+			NetTCP_S_group*	m_group;
+			uint32_t		m_index;
+		};
+
+		enum class start_state: uint8_t
+		{
+			pending,
+			go,
+			abort,
+		};
+
+		std::vector<NetTCP_S>		m_listeners;
+		std::vector<thread>			m_threads;
+		std::vector<worker_slot>	m_slots;
+		worker_t					m_worker	= nullptr;
+		void*						m_context	= nullptr;
+		std::atomic<start_state>	m_start		= start_state::pending;	//!< Holds the workers back until all of them have been pinned
+
+		void release_workers(start_state p_state);
+
+		static void worker_entry(void* p_slot);
+
+		NetTCP_S_group(NetTCP_S_group const&)				= delete;
+		NetTCP_S_group& operator = (NetTCP_S_group const&)	= delete;
+
+	public:
+		NetTCP_S_group() = default;
+
+		///	\note Stops the workers and closes all listeners.
+		~NetTCP_S_group();
+
+		///	\brief Creates \p p_count listeners with SO_REUSEPORT, binds them to the same interface, and sets them to listening mode
+		///	\param[in] p_IP - IP address of the interface to bind too. If 0.0.0.0 (on IPv4) or ::0 (on IPv6) is used, then the sockets are bound to any address
+		///	\param[in] p_Port - Port number to bind too. If 0 the system will pickup an available free port number to be shared by all listeners.
+		///	\param[in] p_count - Number of listeners in the group
+		///	\param[in] p_max_connections - Number of connections allowed to be pending on each listener before starting to refuse them
+		///	\param[in] p_blocking - If true the sockets are blocking, if false the sockets are non-blocking
+		///	\return \ref core::NET_Error
+		///	\remarks On failure no listener is left open.
+		NET_Error open_bind_listen(IP_address const& p_IP, uint16_t p_Port, uint32_t p_count, int p_max_connections, bool p_blocking = true);
+
+		///	\brief Steers incoming connections to the listener associated with the CPU that received them
+		///	\param[in] p_cpu_map - CPU associated with each listener, one entry per listener.
+		///	\return \ref core::NET_Error
+		///	\remarks
+		///		Works best when combined with \ref run using the same map, and with the network card
+		///		receive queues steered to the same CPUs.
+		///		See \ref _p::Net_Socket::set_reuse_port_cpu_steering.
+		NET_Error set_cpu_steering(std::span<uint32_t const> p_cpu_map);
+
+		///	\brief Launches one worker thread per listener
+		///	\param[in] p_worker - Function to be run by each worker
+		///	\param[in] p_context - Argument to be passed to the worker function
+		///	\param[in] p_cpu_map - Optional, if not empty each worker is pinned to the CPU with the same index. Maximum CPU index 63.
+		///	\return \ref core::NET_Error
+		///	\remarks
+		///		Workers only start once all threads have been launched and pinned.
+		///		On failure, including failure to pin a thread, workers that were already launched are stopped without running \p p_worker.
+		NET_Error run(worker_t p_worker, void* p_context, std::span<uint32_t const> p_cpu_map = {});
+
+		///	\brief Shuts down the listeners, waking any worker blocked on accept, and joins the worker threads.
+		///	\remarks Listeners remain open, and must still be closed with \ref close.
+		void stop();
+
+		///	\brief Stops the workers and closes all listeners
+		///	\return \ref core::NET_Error
+		NET_Error close();
+
+		///	\brief Gets the address information shared by the group.
+		///	\param[in] p_IP - receives the IP address
+		///	\param[in] p_Port - receives the port number
+		///	\return \ref core::NET_Error
+		NET_Error get_address(IP_address& p_IP, uint16_t& p_Port);
+
+		[[nodiscard]] inline bool		is_open	() const;
+		[[nodiscard]] inline bool		running	() const;
+		[[nodiscard]] inline uint32_t	size	() const;
+
+		///	\brief Direct access to a listener, for example to set other socket options
+		[[nodiscard]] inline NetTCP_S& listener(uint32_t p_index);
+	};
+
+	inline bool			NetTCP_S_group::is_open	() const { return !m_listeners.empty(); }
+	inline bool			NetTCP_S_group::running	() const { return !m_threads.empty(); }
+	inline uint32_t		NetTCP_S_group::size	() const { return static_cast<uint32_t>(m_listeners.size()); }
+	inline NetTCP_S&	NetTCP_S_group::listener(uint32_t const p_index) { return m_listeners[p_index]; }
+
+} //namespace core
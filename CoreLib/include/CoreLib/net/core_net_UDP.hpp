@@ -49,6 +49,17 @@ namespace core
 			using Net_Socket::set_linger;
 			using Net_Socket::poll;
 			using Net_Socket::shutdown;
+			using Net_Socket::set_receive_buffer_size;
+			using Net_Socket::get_receive_buffer_size;
+			using Net_Socket::set_send_buffer_size;
+			using Net_Socket::get_send_buffer_size;
+			using Net_Socket::set_reuse_port;
+			using Net_Socket::get_reuse_port;
+			using Net_Socket::set_reuse_port_cpu_steering;
+			using Net_Socket::set_busy_poll;
+			using Net_Socket::get_busy_poll;
+			using Net_Socket::set_incoming_cpu;
+			using Net_Socket::get_incoming_cpu;
 
 			///	\brief Sets/Unsets the broadcast mode on the socket
 			///	\param[in] p_broadcast - if true turns the broadcast mode on, if false turns it of
@@ -301,6 +301,30 @@ struct IPv6_address
 	bool			operator <	(IPv6_address const& p_other) const;
 };
 
+//======== ======== ======== Bulk conversion ======== ======== ========
+
+///	\brief Parses a batch of addresses
+///	\param[in]  p_addresses - Strings to parse, in dot-decimal notation for IPv4, in RFC5952 for IPv6
+///	\param[out] p_out - Receives the parsed addresses.
+///		Entries that fail to parse are set to the null address (IPv4_address and IPv6_address) or to no IP (IP_address).
+///	\return Number of addresses successfully parsed
+///	\remarks Only the first min(p_addresses.size(), p_out.size()) entries are processed.
+uintptr_t from_string_bulk(std::span<std::u8string_view const> p_addresses, std::span<IPv4_address> p_out);
+uintptr_t from_string_bulk(std::span<std::u8string_view const> p_addresses, std::span<IPv6_address> p_out);
+uintptr_t from_string_bulk(std::span<std::u8string_view const> p_addresses, std::span<IP_address  > p_out);
+
+///	\brief Formats a batch of addresses back to back into a single buffer
+///	\param[in]  p_addresses - Addresses to format
+///	\param[out] p_output - Non-null-terminated strings, one after the other with no separator
+///	\param[out] p_sizes - Receives the number of characters used by each address
+///	\return Number of addresses formatted
+///	\remarks
+///		Stops at the first address that no longer fits in p_output, or when p_sizes is full.
+///		An IP_address with no IP uses 0 characters.
+uintptr_t to_string_bulk(std::span<IPv4_address const> p_addresses, std::span<char8_t> p_output, std::span<uintptr_t> p_sizes);
+uintptr_t to_string_bulk(std::span<IPv6_address const> p_addresses, std::span<char8_t> p_output, std::span<uintptr_t> p_sizes);
+uintptr_t to_string_bulk(std::span<IP_address   const> p_addresses, std::span<char8_t> p_output, std::span<uintptr_t> p_sizes);
+
 //======== ======== ======== inline optimization ======== ======== ========
 
 //======== ======== IP_address ======== ========
@@ -0,0 +1,219 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		Provides a pool of network receive buffers
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <CoreLib/core_sync.hpp>
+
+#include "core_net_socket.hpp"
+
+/// \n
+namespace core
+{
+	class Net_buffer_pool;
+
+	namespace _p
+	{
+		class NetTCP_C_p;
+		class NetUDP_p;
+		struct Net_buffer_thread_cache;
+	} //namespace _p
+
+	///	\brief A block of memory borrowed from a \ref Net_buffer_pool.
+	///	\remarks The block is returned to the pool when the object is destroyed or \ref release is called.
+	///		The pool must outlive all buffers borrowed from it.
+	class Net_buffer
+	{
+		friend class Net_buffer_pool;
+
+	private:
+		Net_buffer_pool*	m_pool = nullptr;
+		uint8_t*			m_data = nullptr;
+		uintptr_t			m_size = 0;
+
+		inline Net_buffer(Net_buffer_pool* p_pool, uint8_t* p_data);
+
+		Net_buffer(Net_buffer const&)				= delete;
+		Net_buffer& operator = (Net_buffer const&)	= delete;
+
+	public:
+		Net_buffer() = default;
+		inline Net_buffer(Net_buffer&& p_other);
+		inline Net_buffer& operator = (Net_buffer&& p_other);
+		inline ~Net_buffer();
+
+		///	\brief Returns the block to its pool
+		inline void release();
+
+		///	\return true if the object holds a block
+		[[nodiscard]] inline bool is_valid() const;
+
+		[[nodiscard]] inline uint8_t*	data		() const;
+		[[nodiscard]] inline uintptr_t	capacity	() const;
+
+		///	\return Amount of data in use, as set by \ref set_size
+		[[nodiscard]] inline uintptr_t	size		() const;
+		inline void						set_size	(uintptr_t p_size);
+
+		///	\return The block's memory up to \ref size
+		[[nodiscard]] inline std::span<uint8_t>	used	() const;
+		///	\return The entire block's memory
+		[[nodiscard]] inline std::span<uint8_t>	whole	() const;
+	};
+
+	///	\brief Pool of fixed size receive buffers, that sockets can borrow at receive time and return after processing.
+	///	\remarks
+	///		Instead of having each connection own a worst case buffer, a buffer is only held while there is data to process,
+	///		the memory used is thus proportional to the amount of data in flight rather than the number of connections.
+	///		Blocks are allocated in slabs and never returned to the system until the pool is destroyed.
+	///		Each thread keeps a small cache of blocks, so that borrowing and returning rarely needs to touch the shared free list.
+	///		All methods are thread safe.
+	class Net_buffer_pool
+	{
+		friend class Net_buffer;
+		friend struct _p::Net_buffer_thread_cache;
+
+	public:
+		static constexpr uint32_t thread_cache_size = 32;	//!< Maximum number of blocks held by the cache of each thread
+
+	private:
+		uint64_t const	m_id;
+		uintptr_t const	m_block_size;
+		uint32_t const	m_blocks_per_slab;
+		uint32_t const	m_max_slabs;
+
+		mutable atomic_spinlock	m_lock;
+		void*					m_free = nullptr;
+		std::vector<void*>		m_slabs;
+
+		void*		pop_shared	();
+		uint32_t	pop_shared	(void** p_out, uint32_t p_count);
+		void		push_shared	(void* const* p_blocks, uint32_t p_count);
+		void*		allocate_slab();
+		void		give_back	(uint8_t* p_block);
+
+		Net_buffer_pool(Net_buffer_pool const&)				= delete;
+		Net_buffer_pool& operator = (Net_buffer_pool const&)	= delete;
+
+	public:
+		///	\param[in] p_block_size - Size of each buffer, rounded up to a multiple of 64 Bytes
+		///	\param[in] p_blocks_per_slab - Number of buffers allocated at once when the pool needs to grow
+		///	\param[in] p_max_slabs - Maximum number of slabs that can be allocated, 0 for no limit
+		Net_buffer_pool(uintptr_t p_block_size, uint32_t p_blocks_per_slab = 64, uint32_t p_max_slabs = 0);
+		~Net_buffer_pool();
+
+		///	\brief Borrows a buffer from the pool
+		///	\return A valid buffer, or an invalid one if the pool has reached its limit
+		[[nodiscard]] Net_buffer acquire();
+
+		///	\brief Returns the blocks cached by the calling thread back to the shared free list
+		void flush_thread_cache();
+
+		[[nodiscard]] inline uintptr_t block_size() const;
+
+		///	\return Total number of blocks allocated by the pool, either borrowed or free
+		[[nodiscard]] uintptr_t capacity() const;
+	};
+
+	///	\brief Borrows a buffer from the pool and receives data pending on a TCP socket into it.
+	///	\param[in] p_socket - Socket to receive from
+	///	\param[in] p_pool - Pool to borrow from
+	///	\param[out] p_buffer - On success, receives the buffer with \ref Net_buffer::size set to the amount of data received.
+	///	\return \ref core::NET_Error, \ref core::NET_Error::Buffer_Full if the pool is exhausted.
+	///	\remarks
+	///		On failure no buffer is held. Best used after the socket is known to be readable (ex. \ref _p::Net_Socket::poll),
+	///		so that the buffer is only borrowed when there is data.
+	NET_Error receive_pooled(_p::NetTCP_C_p& p_socket, Net_buffer_pool& p_pool, Net_buffer& p_buffer);
+
+	///	\brief Borrows a buffer from the pool and receives the next datagram pending on a UDP socket into it.
+	///	\param[in] p_socket - Socket to receive from
+	///	\param[in] p_pool - Pool to borrow from
+	///	\param[out] p_buffer - On success, receives the buffer with \ref Net_buffer::size set to the size of the datagram.
+	///	\return \ref core::NET_Error, \ref core::NET_Error::Buffer_Full if the pool is exhausted.
+	///	\remarks Datagrams larger than \ref Net_buffer_pool::block_size are truncated.
+	NET_Error receive_pooled(_p::NetUDP_p& p_socket, Net_buffer_pool& p_pool, Net_buffer& p_buffer);
+
+
+	//======== ======== ======== inline optimization ======== ======== ========
+
+	//======== ======== Net_buffer ======== ========
+	inline Net_buffer::Net_buffer(Net_buffer_pool* const p_pool, uint8_t* const p_data): m_pool(p_pool), m_data(p_data) {}
+	inline Net_buffer::Net_buffer(Net_buffer&& p_other)
+		: m_pool(p_other.m_pool)
+		, m_data(p_other.m_data)
+		, m_size(p_other.m_size)
+	{
+		p_other.m_pool = nullptr;
+		p_other.m_data = nullptr;
+		p_other.m_size = 0;
+	}
+
+	inline Net_buffer& Net_buffer::operator = (Net_buffer&& p_other)
+	{
+		if(this != &p_other)
+		{
+			release();
+			m_pool = p_other.m_pool;
+			m_data = p_other.m_data;
+			m_size = p_other.m_size;
+			p_other.m_pool = nullptr;
+			p_other.m_data = nullptr;
+			p_other.m_size = 0;
+		}
+		return *this;
+	}
+
+	inline Net_buffer::~Net_buffer() { release(); }
+
+	inline void Net_buffer::release()
+	{
+		if(m_data)
+		{
+			m_pool->give_back(m_data);
+			m_pool = nullptr;
+			m_data = nullptr;
+			m_size = 0;
+		}
+	}
+
+	inline bool					Net_buffer::is_valid() const { return m_data != nullptr; }
+	inline uint8_t*				Net_buffer::data	() const { return m_data; }
+	inline uintptr_t			Net_buffer::capacity() const { return m_pool ? m_pool->block_size() : 0; }
+	inline uintptr_t			Net_buffer::size	() const { return m_size; }
+	inline void					Net_buffer::set_size(uintptr_t const p_size) { m_size = p_size; }
+	inline std::span<uint8_t>	Net_buffer::used	() const { return std::span<uint8_t>{m_data, m_size}; }
+	inline std::span<uint8_t>	Net_buffer::whole	() const { return std::span<uint8_t>{m_data, capacity()}; }
+
+	//======== ======== Net_buffer_pool ======== ========
+	inline uintptr_t Net_buffer_pool::block_size() const { return m_block_size; }
+
+} //namespace core
@@ -0,0 +1,174 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		Provides a longest prefix match table for IPv4 and IPv6 networks
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "core_net_address.hpp"
+
+/// \n
+namespace core
+{
+	namespace _p
+	{
+		///	\brief Multi-bit trie with leaf pushing, the first level resolves 16 bits and every other level resolves 8 bits.
+		///	\tparam t_key_size - Number of Bytes in the key (4 for IPv4, 16 for IPv6)
+		template<uint8_t t_key_size>
+		class prefix_trie
+		{
+		public:
+			static constexpr uint32_t child_flag	= 0x80000000;	//!< Marks an entry that points to the next level
+			static constexpr uint32_t root_size		= 0x10000;
+			static constexpr uint32_t chunk_size	= 0x100;
+
+		private:
+			///	\brief Entries for the root followed by all next level chunks.
+			///	An entry is either a child chunk index (with \ref child_flag), 0 for no match, or rule index + 1.
+			std::vector<uint32_t>	m_entries;
+			///	\brief Prefix length of the rule held by each entry
+			std::vector<uint8_t>	m_depth;
+			///	\brief Rule index of each network inserted, keyed by network address (host bits cleared) and prefix length
+			std::map<std::pair<std::array<uint8_t, t_key_size>, uint8_t>, uint32_t> m_rules;
+
+			uint32_t	make_child	(uint32_t p_pos);
+			void		set_entry	(uint32_t p_pos, uint8_t p_len, uint32_t p_rule);
+
+		public:
+			///	\return The rule index of the network, \p p_rule if it is new, or the index it was first inserted with if it is already in the trie
+			uint32_t insert(std::span<uint8_t const, t_key_size> p_key, uint8_t p_len, uint32_t p_rule);
+			void clear();
+
+			[[nodiscard]] inline bool		empty	() const;
+			[[nodiscard]] inline uint32_t	root	(std::span<uint8_t const, t_key_size> p_key) const;
+			[[nodiscard]] inline uint32_t	resolve	(std::span<uint8_t const, t_key_size> p_key, uint32_t p_root_entry) const;
+		};
+	} //namespace _p
+
+	///	\brief Longest prefix match table, maps IPv4 and IPv6 networks to a user value
+	///	\remarks
+	///		IPv4 lookups take at most 3 memory accesses, IPv6 lookups take at most 15.
+	///		The first level of each IP version uses 320KiB, and is only allocated once a network of that version is inserted.
+	///		Lookups may run concurrently with each other, but not with \ref insert or \ref clear.
+	class IP_prefix_table
+	{
+	public:
+		static constexpr uint32_t no_match = 0xFFFFFFFF;	//!< Returned by lookups that do not match any network
+
+	private:
+		_p::prefix_trie<4>		m_v4;
+		_p::prefix_trie<16>		m_v6;
+		std::vector<uint32_t>	m_values;
+
+		static constexpr uintptr_t batch_size = 16;
+
+	public:
+		///	\brief Adds a network to the table
+		///	\param[in] p_cidr - Network in CIDR notation (ex. "10.0.0.0/8" or "2001:db8::/32"), an address without prefix length is a single host
+		///	\param[in] p_value - Value returned by lookups that match this network
+		///	\return true on success, false if the string is not a valid network
+		///	\remarks
+		///		Host bits beyond the prefix length are ignored.
+		///		Adding the same network again replaces its value.
+		bool insert(std::u8string_view p_cidr, uint32_t p_value);
+		bool insert(IPv4_address const& p_network, uint8_t p_prefix_length, uint32_t p_value);
+		bool insert(IPv6_address const& p_network, uint8_t p_prefix_length, uint32_t p_value);
+		bool insert(IP_address   const& p_network, uint8_t p_prefix_length, uint32_t p_value);
+
+		///	\brief Removes all networks
+		void clear();
+
+		///	\return Number of distinct networks in the table
+		[[nodiscard]] inline uintptr_t size() const;
+
+		///	\brief Finds the value of the most specific network that contains the address
+		///	\return The network's value, or \ref no_match
+		[[nodiscard]] inline uint32_t lookup(IPv4_address const& p_address) const;
+		[[nodiscard]] inline uint32_t lookup(IPv6_address const& p_address) const;
+		[[nodiscard]] uint32_t lookup(IP_address const& p_address) const;
+
+		///	\brief Batch version of lookup
+		///	\param[in]  p_addresses - Addresses to look up
+		///	\param[out] p_out - Receives the value for each address, or \ref no_match
+		///	\remarks
+		///		Only the first min(p_addresses.size(), p_out.size()) entries are processed.
+		///		Addresses are processed in groups, the first level of all addresses in a group is read before any of them is resolved further,
+		///		which allows the cache misses of independent lookups to overlap.
+		void lookup(std::span<IPv4_address const> p_addresses, std::span<uint32_t> p_out) const;
+		void lookup(std::span<IPv6_address const> p_addresses, std::span<uint32_t> p_out) const;
+		void lookup(std::span<IP_address   const> p_addresses, std::span<uint32_t> p_out) const;
+	};
+
+	//======== ======== ======== inline optimization ======== ======== ========
+
+	namespace _p
+	{
+		template<uint8_t t_key_size>
+		inline bool prefix_trie<t_key_size>::empty() const { return m_entries.empty(); }
+
+		template<uint8_t t_key_size>
+		inline uint32_t prefix_trie<t_key_size>::root(std::span<uint8_t const, t_key_size> const p_key) const
+		{
+			if(m_entries.empty()) return 0;
+			return m_entries[(static_cast<uint32_t>(p_key[0]) << 8) | p_key[1]];
+		}
+
+		template<uint8_t t_key_size>
+		inline uint32_t prefix_trie<t_key_size>::resolve(std::span<uint8_t const, t_key_size> const p_key, uint32_t p_entry) const
+		{
+			uint8_t level = 2;
+			while(p_entry & child_flag)
+			{
+				p_entry = m_entries[root_size + (p_entry & ~child_flag) * chunk_size + p_key[level++]];
+			}
+			return p_entry;
+		}
+	} //namespace _p
+
+	inline uintptr_t IP_prefix_table::size() const { return m_values.size(); }
+
+	inline uint32_t IP_prefix_table::lookup(IPv4_address const& p_address) const
+	{
+		std::span<uint8_t const, 4> const key = p_address.byteField;
+		uint32_t const entry = m_v4.resolve(key, m_v4.root(key));
+		return entry ? m_values[entry - 1] : no_match;
+	}
+
+	inline uint32_t IP_prefix_table::lookup(IPv6_address const& p_address) const
+	{
+		std::span<uint8_t const, 16> const key = p_address.byteField;
+		uint32_t const entry = m_v6.resolve(key, m_v6.root(key));
+		return entry ? m_values[entry - 1] : no_match;
+	}
+
+} //namespace core
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 
 #include <CoreLib/core_type.hpp>
 
@@ -50,6 +51,7 @@ namespace core
 		Buffer_Full				= 0x0F,	//!< For external use
 
 		Incompatible_Protocol	= 0x11,	//!< You are using an IPv agnostic socket but you are trying to perform a version specific operation that differs from the version the socket has been initialized for
+		Not_Supported			= 0x12,	//!< The requested operation or option is not supported on this platform
 
 		TCP_GracefullClose		= 0xF0,	//!< Indicates that the TCP peer has executed a gracefull close
 		Fail					= 0xFC,	//!< The attempted operations failed
@@ -118,6 +120,85 @@ namespace core
 			///			https://linux.die.net/man/7/socket
 			NET_Error set_linger(bool p_linger, uint16_t p_timeout);
 
+			///	\brief Sets the size of the socket's receive buffer (SO_RCVBUF)
+			///	\param[in] p_size - Requested size in bytes
+			///	\return \ref core::NET_Error
+			///	\remarks
+			///		The system is free to adjust the requested value, on Linux the effective size is doubled
+			///		to account for bookkeeping overhead and is capped by net.core.rmem_max.
+			NET_Error set_receive_buffer_size(uint32_t p_size);
+
+			///	\brief Gets the effective size of the socket's receive buffer (SO_RCVBUF)
+			///	\param[out] p_size - receives the size in bytes
+			///	\return \ref core::NET_Error
+			NET_Error get_receive_buffer_size(uint32_t& p_size) const;
+
+			///	\brief Sets the size of the socket's send buffer (SO_SNDBUF)
+			///	\param[in] p_size - Requested size in bytes
+			///	\return \ref core::NET_Error
+			///	\remarks
+			///		The system is free to adjust the requested value, on Linux the effective size is doubled
+			///		to account for bookkeeping overhead and is capped by net.core.wmem_max.
+			NET_Error set_send_buffer_size(uint32_t p_size);
+
+			///	\brief Gets the effective size of the socket's send buffer (SO_SNDBUF)
+			///	\param[out] p_size - receives the size in bytes
+			///	\return \ref core::NET_Error
+			NET_Error get_send_buffer_size(uint32_t& p_size) const;
+
+			///	\brief Allows several sockets to bind to the exact same address and port (SO_REUSEPORT).
+			///	\param[in] p_reuse - If true allows port sharing, if false revokes it.
+			///	\return \ref core::NET_Error
+			///	\remarks
+			///		Must be set on every socket of the group before \ref bind.
+			///		The system load balances incoming connections (or datagrams) across all sockets of the group.
+			///		Returns \ref core::NET_Error::Not_Supported on Windows.
+			NET_Error set_reuse_port(bool p_reuse);
+
+			///	\brief Checks if the socket allows port sharing (SO_REUSEPORT).
+			///	\param[out] p_reuse - receives the current setting
+			///	\return \ref core::NET_Error
+			NET_Error get_reuse_port(bool& p_reuse) const;
+
+			///	\brief Sets the approximate time in microseconds to busy poll on a blocking receive when there is no data (SO_BUSY_POLL).
+			///	\param[in] p_microseconds - Time to busy poll, 0 disables busy polling.
+			///	\return \ref core::NET_Error
+			///	\remarks
+			///		Increasing this value requires CAP_NET_ADMIN.
+			///		Returns \ref core::NET_Error::Not_Supported on Windows.
+			NET_Error set_busy_poll(uint32_t p_microseconds);
+
+			///	\brief Gets the busy poll time in microseconds (SO_BUSY_POLL).
+			///	\param[out] p_microseconds - receives the current setting
+			///	\return \ref core::NET_Error
+			NET_Error get_busy_poll(uint32_t& p_microseconds) const;
+
+			///	\brief Sets the CPU affinity of the socket (SO_INCOMING_CPU).
+			///	\param[in] p_cpu - Index of the CPU that is expected to process the traffic for this socket.
+			///	\return \ref core::NET_Error
+			///	\remarks
+			///		On a group of listening sockets sharing a port via \ref set_reuse_port, the system will prefer
+			///		the socket whose CPU matches the CPU where the connection request was received.
+			///		Returns \ref core::NET_Error::Not_Supported on Windows.
+			NET_Error set_incoming_cpu(uint32_t p_cpu);
+
+			///	\brief Gets the CPU where the traffic for this socket is being received (SO_INCOMING_CPU).
+			///	\param[out] p_cpu - receives the CPU index
+			///	\return \ref core::NET_Error
+			NET_Error get_incoming_cpu(uint32_t& p_cpu) const;
+
+			///	\brief Steers traffic across the group of sockets sharing a port, based on the CPU that received it (SO_ATTACH_REUSEPORT_CBPF).
+			///	\param[in] p_cpu_map - CPU associated with each socket of the group, in the order the sockets joined the group.
+			///		Traffic received on CPU p_cpu_map[i] is delivered to the i-th socket of the group,
+			///		traffic received on a CPU not in the map is delivered to socket (CPU % p_cpu_map.size()).
+			///	\return \ref core::NET_Error
+			///	\remarks
+			///		The socket must have already joined the group (see \ref set_reuse_port). The program applies to the entire group.
+			///		On TCP sockets, the order in the group is the order in which sockets started listening,
+			///		closing a socket re-arranges the group and invalidates the map.
+			///		Returns \ref core::NET_Error::Not_Supported on Windows.
+			NET_Error set_reuse_port_cpu_steering(std::span<uint32_t const> p_cpu_map);
+
 			///	\brief Used to wait until data arrives on the reading end of the socket
 			///	\param[in] p_microseconds - Time in microseconds to wait for data to arrive at the socket before abandoning the operation
 			///	\return \ref core::NET_Error, more specifically \ref core::NET_Error::NoErr on success,
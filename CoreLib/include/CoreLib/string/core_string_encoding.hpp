@@ -38,6 +38,7 @@
 #include <optional>
 
 #include <CoreLib/core_alternate.hpp>
+#include <CoreLib/core_cpu_dispatch.hpp>
 
 //BOM
 //	UTF8:		EF BB BF
@@ -419,4 +420,10 @@ namespace core
 	///	\brief	Same as \ref core::ASCII_Compliant(char8_t const*, uintptr_t), but for char32_t.
 	[[nodiscard]] bool ASCII_Compliant(std::u32string_view p_str);
 
+	namespace _p
+	{
+		///	\brief Kernels behind \ref core::ASCII_Compliant(std::u8string_view), exposed for testing.
+		extern cpu_dispatch<bool(char8_t const*, uintptr_t)> const ASCII_Compliant_dispatch;
+	} //namespace _p
+
 }	//namespace core
@@ -33,8 +33,17 @@
 #include <string_view>
 #include <span>
 
+#include <CoreLib/core_cpu_dispatch.hpp>
+
 namespace core
 {
+	namespace _p
+	{
+		///	\brief Kernels behind \ref toLowerCase and \ref toUpperCase, exposed for testing.
+		extern cpu_dispatch<void(char8_t*, uintptr_t)> const toLowerCase_dispatch;
+		extern cpu_dispatch<void(char8_t*, uintptr_t)> const toUpperCase_dispatch;
+	} //namespace _p
+
 	//======== ======== Evaluation
 	
 	///	\brief		Converts in-place, the input string to all lower case
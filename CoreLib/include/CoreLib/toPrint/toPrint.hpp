@@ -33,6 +33,11 @@
 #include <string>
 #include <string_view>
 #include <vector>
+#include <concepts>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <cstring>
 
 #include <CoreLib/core_extra_compiler.hpp>
 #include <CoreLib/core_type.hpp>
@@ -91,18 +96,310 @@ namespace core
 		struct to_print_short_opt<wchar_alias, core::pack<std::basic_string<wchar_t>>>: std::true_type{ static constexpr bool type_alias = true; };
 
 
+		template<typename CharT, typename T>
+		concept c_toPrint_single_pass = requires(T const& obj, CharT* const p_out)
+		{
+			{ obj.get_print(p_out) } -> std::same_as<CharT*>;
+		};
+
+		///	\brief Upper bound of the number of characters \p obj will print.
+		///	\remarks Uses the encoder's max_size if it has one, otherwise falls back to the exact size.
+		template<typename CharT, typename T>
+		FORCE_INLINE uintptr_t toPrint_max_size(T const& obj)
+		{
+			if constexpr(requires { { obj.max_size(CharT{}) } -> std::same_as<uintptr_t>; })
+			{
+				return obj.max_size(CharT{});
+			}
+			else
+			{
+				return obj.size(CharT{});
+			}
+		}
+
+		//-------- Format string --------
+
+		enum class format_spec: uint8_t
+		{
+			none,		//!< {}   - \ref toPrint
+			hex,		//!< {:x} - \ref toPrint_hex
+			hex_fix,	//!< {:X} - \ref toPrint_hex_fix
+			bin,		//!< {:b} - \ref toPrint_bin
+			bin_fix,	//!< {:B} - \ref toPrint_bin_fix
+			fp_fancy,	//!< {:e} - \ref toPrint_fp_fancy
+		};
+
+		template<typename T> struct format_char { using type = T; };
+		template<> struct format_char<char>    { using type = char8_t; };
+		template<> struct format_char<wchar_t> { using type = wchar_alias; };
+
+		///	\brief Structural holder of a format string literal, so that it can be used as a template parameter.
+		template<typename char_t, uintptr_t N>
+		struct format_literal
+		{
+			using type = format_char<char_t>::type;
+
+			consteval format_literal(char_t const (&p_str)[N])
+			{
+				for(uintptr_t i = 0; i < N; ++i)
+				{
+					data[i] = static_cast<type>(p_str[i]);
+				}
+			}
+
+			type data[N];
+		};
+
+		///	\brief Not constexpr on purpose, reaching it during constant evaluation fails the build.
+		void format_string_error(char const*);
+
+		template<typename char_t, uintptr_t N>
+		struct format_parsed
+		{
+			std::array<char_t, N> text{};			//!< Literal text with the escapes resolved.
+			std::array<uintptr_t, N> literal_end{};	//!< End of the literal preceding field i in \ref text, the last entry is the end of the trailing literal.
+			std::array<format_spec, N> spec{};
+			uintptr_t field_count = 0;
+			bool ascii = true;
+		};
+
+		template<typename char_t, uintptr_t N>
+		consteval format_parsed<typename format_literal<char_t, N>::type, N> parse_format(format_literal<char_t, N> const& p_format)
+		{
+			using type = format_literal<char_t, N>::type;
+			format_parsed<type, N> res;
+			uintptr_t text_size = 0;
+			uintptr_t const last = N - 1; //null terminator
+
+			for(uintptr_t i = 0; i < last; ++i)
+			{
+				type const tchar = p_format.data[i];
+				if(tchar == '{')
+				{
+					if(i + 1 < last && p_format.data[i + 1] == '{')
+					{
+						res.text[text_size++] = tchar;
+						++i;
+						continue;
+					}
+
+					format_spec spec = format_spec::none;
+					if(i + 1 < last && p_format.data[i + 1] == '}')
+					{
+						i += 1;
+					}
+					else if(i + 3 < last && p_format.data[i + 1] == ':' && p_format.data[i + 3] == '}')
+					{
+						switch(p_format.data[i + 2])
+						{
+							case 'x': spec = format_spec::hex;		break;
+							case 'X': spec = format_spec::hex_fix;	break;
+							case 'b': spec = format_spec::bin;		break;
+							case 'B': spec = format_spec::bin_fix;	break;
+							case 'e': spec = format_spec::fp_fancy;	break;
+							default:
+								format_string_error("Unknown format specifier");
+						}
+						i += 3;
+					}
+					else
+					{
+						format_string_error("Malformed format field");
+					}
+
+					res.literal_end[res.field_count] = text_size;
+					res.spec[res.field_count] = spec;
+					++res.field_count;
+				}
+				else if(tchar == '}')
+				{
+					if(i + 1 < last && p_format.data[i + 1] == '}')
+					{
+						res.text[text_size++] = tchar;
+						++i;
+						continue;
+					}
+					format_string_error("Unmatched '}'");
+				}
+				else
+				{
+					if(static_cast<uint32_t>(tchar) > 0x7F)
+					{
+						res.ascii = false;
+					}
+					res.text[text_size++] = tchar;
+				}
+			}
+			res.literal_end[res.field_count] = text_size;
+			return res;
+		}
+
+		template<format_literal Fmt>
+		constexpr auto format_parsed_v = parse_format(Fmt);
+
+		template<format_spec Spec, typename T>
+		FORCE_INLINE auto format_encode(T const& obj)
+		{
+			if constexpr(Spec == format_spec::none)
+			{
+				return to_print_transform(obj);
+			}
+			else if constexpr(Spec == format_spec::hex)
+			{
+				return ::core::toPrint_hex{obj};
+			}
+			else if constexpr(Spec == format_spec::hex_fix)
+			{
+				return ::core::toPrint_hex_fix{obj};
+			}
+			else if constexpr(Spec == format_spec::bin)
+			{
+				return ::core::toPrint_bin{obj};
+			}
+			else if constexpr(Spec == format_spec::bin_fix)
+			{
+				return ::core::toPrint_bin_fix{obj};
+			}
+			else
+			{
+				return ::core::toPrint_fp_fancy{obj};
+			}
+		}
+
+		///	\brief Encoder produced by \ref core::toPrint_format.
+		///	\remarks Literal fragments are resolved at compile time, fields are printed by the encoders chosen by their specifier.
+		template<format_literal Fmt, typename... Encoders>
+		class toPrint_formatted: public toPrint_base
+		{
+		private:
+			static constexpr auto const& parsed = format_parsed_v<Fmt>;
+			using char_t = std::remove_cvref_t<decltype(parsed.text[0])>;
+			using sequence_t = std::index_sequence_for<Encoders...>;
+
+			static constexpr uintptr_t literal_begin(uintptr_t const p_index)
+			{
+				return p_index ? parsed.literal_end[p_index - 1] : 0;
+			}
+
+			static constexpr uintptr_t text_size = parsed.literal_end[sizeof...(Encoders)];
+
+			template<c_toPrint_char CharT>
+			static constexpr bool literal_direct_v = std::is_same_v<CharT, char_t> || parsed.ascii;
+
+			template<c_toPrint_char CharT, uintptr_t Begin, uintptr_t End>
+			static FORCE_INLINE CharT* put_literal(CharT* const p_out)
+			{
+				if constexpr(Begin == End)
+				{
+					return p_out;
+				}
+				else if constexpr(std::is_same_v<CharT, char_t>)
+				{
+					memcpy(p_out, parsed.text.data() + Begin, (End - Begin) * sizeof(CharT));
+					return p_out + (End - Begin);
+				}
+				else if constexpr(parsed.ascii)
+				{
+					for(uintptr_t i = Begin; i < End; ++i)
+					{
+						p_out[i - Begin] = static_cast<CharT>(parsed.text[i]);
+					}
+					return p_out + (End - Begin);
+				}
+				else
+				{
+					return ::core::toPrint<std::basic_string_view<char_t>>{std::basic_string_view<char_t>{parsed.text.data() + Begin, End - Begin}}.get_print(p_out);
+				}
+			}
+
+			template<c_toPrint_char CharT, typename T>
+			static FORCE_INLINE CharT* put_field(T const& p_encoder, CharT* const p_out)
+			{
+				if constexpr(c_toPrint_single_pass<CharT, T>)
+				{
+					return p_encoder.get_print(p_out);
+				}
+				else
+				{
+					p_encoder.get_print(p_out);
+					return p_out + p_encoder.size(CharT{});
+				}
+			}
+
+			template<c_toPrint_char CharT>
+			static inline uintptr_t literal_size()
+			{
+				if constexpr(literal_direct_v<CharT>)
+				{
+					return text_size;
+				}
+				else
+				{
+					return ::core::toPrint<std::basic_string_view<char_t>>{std::basic_string_view<char_t>{parsed.text.data(), text_size}}.size(CharT{});
+				}
+			}
+
+			template<c_toPrint_char CharT, uintptr_t... I>
+			FORCE_INLINE uintptr_t fields_size(std::index_sequence<I...>) const
+			{
+				return (uintptr_t{0} + ... + std::get<I>(m_fields).size(CharT{}));
+			}
+
+			template<c_toPrint_char CharT, uintptr_t... I>
+			FORCE_INLINE uintptr_t fields_max_size(std::index_sequence<I...>) const
+			{
+				return (uintptr_t{0} + ... + toPrint_max_size<CharT>(std::get<I>(m_fields)));
+			}
+
+			template<c_toPrint_char CharT, uintptr_t... I>
+			FORCE_INLINE CharT* print_fields(CharT* p_out, std::index_sequence<I...>) const
+			{
+				((
+					p_out = put_literal<CharT, literal_begin(I), parsed.literal_end[I]>(p_out),
+					p_out = put_field<CharT>(std::get<I>(m_fields), p_out)
+				), ...);
+				return put_literal<CharT, literal_begin(sizeof...(I)), text_size>(p_out);
+			}
+
+		public:
+			constexpr toPrint_formatted(Encoders const&... p_fields): m_fields{p_fields...} {}
+
+			template<c_toPrint_char CharT>
+			inline uintptr_t size(CharT const&) const { return literal_size<CharT>() + fields_size<CharT>(sequence_t{}); }
+
+			template<c_toPrint_char CharT>
+			inline uintptr_t max_size(CharT const&) const { return literal_size<CharT>() + fields_max_size<CharT>(sequence_t{}); }
+
+			template<c_toPrint_char CharT>
+			CharT* get_print(CharT* const p_out) const
+			{
+				return print_fields<CharT>(p_out, sequence_t{});
+			}
+
+		private:
+			std::tuple<Encoders...> const m_fields;
+		};
+
+		template<format_literal Fmt, uintptr_t... I, typename... Args>
+		FORCE_INLINE auto make_format(std::index_sequence<I...>, Args const&... args)
+		{
+			return toPrint_formatted<Fmt, decltype(format_encode<format_parsed_v<Fmt>.spec[I]>(args))...>
+				{ format_encode<format_parsed_v<Fmt>.spec[I]>(args)... };
+		}
+
 		template<c_toPrint_char CharT>
 		struct toPrint_assist
 		{
 		private:
 
+			///	\brief Formats into scratch space and hands the result to the sink's write
 			template<typename Sink, typename... Args> requires 
 			(
-				is_valid_sink_toPrint_v<CharT, Sink> and
-				not _p::toPrint_has_own_buffer<CharT, Sink>::value and
+				_p::is_sink_toPrint_v<Sink> and
+				_p::toPrint_has_write<CharT, Sink>::value and
 				( is_toPrint_v<Args> and... )
 			)
-			NO_INLINE static void push_toPrint(Sink& sink,  Args const&... args)
+			NO_INLINE static void write_toPrint(Sink& sink,  Args const&... args)
 			{
 				constexpr uintptr_t arg_count = sizeof...(Args);
 				static_assert( arg_count > 0); 
@@ -151,6 +448,15 @@ namespace core
 				std::array<uintptr_t const, arg_count> sizeTable { add_ret(args.size(CharT{}), char_count)... };
 
 				CharT* const buff = sink.buffer_acquire(char_count);
+				if constexpr(_p::toPrint_has_write<CharT, Sink>::value)
+				{
+					//the sink had no room, nothing was acquired
+					if(!buff)
+					{
+						write_toPrint(sink, args...);
+						return;
+					}
+				}
 				if (char_count and buff)
 				{
 					CharT* pivot = buff;
@@ -162,6 +468,84 @@ namespace core
 				sink.buffer_released(buff, 0);
 			}
 
+			template<typename Sink, typename... Args> requires 
+			(
+				_p::is_sink_toPrint_v<Sink> and
+				_p::toPrint_has_write<CharT, Sink>::value and
+				( is_toPrint_v<Args> and... )
+			)
+			NO_INLINE static void write_toPrint_single_pass(Sink& sink,  Args const&... args)
+			{
+				if constexpr(( c_toPrint_single_pass<CharT, Args> and ... ))
+				{
+					uintptr_t const max_count = (toPrint_max_size<CharT>(args) + ...);
+
+					if(max_count)
+					{
+						constexpr uintptr_t alloca_treshold = (0x10000 / sizeof(CharT));
+
+						std::vector<CharT> buff2;
+						CharT* buff;
+						if(max_count > alloca_treshold)
+						{
+							buff2.resize(max_count);
+							buff = buff2.data();
+						}
+						else
+						{
+							buff = reinterpret_cast<CharT*>(core_alloca(max_count * sizeof(CharT)));
+						}
+
+						CharT* pivot = buff;
+						((pivot = args.get_print(pivot)), ...);
+
+						sink.write(std::basic_string_view<CharT>{buff, static_cast<uintptr_t>(pivot - buff)});
+						return;
+					}
+					sink.write(std::basic_string_view<CharT>{nullptr, 0});
+				}
+				else
+				{
+					write_toPrint(sink, args...);
+				}
+			}
+
+			template<typename Sink, typename... Args> requires (
+				is_valid_sink_toPrint_v<CharT, Sink> and
+				_p::toPrint_has_own_buffer<CharT, Sink>::value and
+				( is_toPrint_v<Args> and... )
+				)
+			NO_INLINE static void push_toPrint_single_pass(Sink& sink,  Args const&... args)
+			{
+				if constexpr(( c_toPrint_single_pass<CharT, Args> and ... ))
+				{
+					uintptr_t const max_count = (toPrint_max_size<CharT>(args) + ...);
+
+					CharT* const buff = sink.buffer_acquire(max_count);
+					if constexpr(_p::toPrint_has_write<CharT, Sink>::value)
+					{
+						//the sink had no room, nothing was acquired
+						if(!buff)
+						{
+							write_toPrint_single_pass(sink, args...);
+							return;
+						}
+					}
+					if (max_count and buff)
+					{
+						CharT* pivot = buff;
+						((pivot = args.get_print(pivot)), ...);
+						sink.buffer_released(buff, static_cast<uintptr_t>(pivot - buff));
+						return;
+					}
+					sink.buffer_released(buff, 0);
+				}
+				else
+				{
+					push_toPrint(sink, args...);
+				}
+			}
+
 		public:
 			template<typename Sink, typename... Args> requires
 			(
@@ -216,7 +600,41 @@ namespace core
 				}
 				else
 				{
-					push_toPrint(sink, _p::to_print_transform(args)...);
+					write_toPrint(sink, _p::to_print_transform(args)...);
+				}
+			}
+
+			template<typename Sink, typename... Args> requires
+			(
+				_p::is_sink_toPrint_v<Sink> and
+				_p::toPrint_has_own_buffer<CharT, Sink>::value
+			)
+			FORCE_INLINE static void print_single_pass(Sink& sink, Args const&... args)
+			{
+				if constexpr(sizeof...(Args) == 0)
+				{
+					print(sink);
+				}
+				else
+				{
+					push_toPrint_single_pass(sink, _p::to_print_transform(args)...);
+				}
+			}
+
+			template<typename Sink, typename... Args> requires
+			(
+				_p::is_sink_toPrint_v<Sink> and
+				not _p::toPrint_has_own_buffer<CharT, Sink>::value
+			)
+			FORCE_INLINE static void print_single_pass(Sink& sink, Args const&... args)
+			{
+				if constexpr(sizeof...(Args) == 0 || (sizeof...(Args) == 1 && _p::to_print_short_opt<CharT, core::pack<std::remove_cvref_t<Args>...>>::value))
+				{
+					print(sink, args...);
+				}
+				else
+				{
+					write_toPrint_single_pass(sink, _p::to_print_transform(args)...);
 				}
 			}
 
@@ -224,6 +642,23 @@ namespace core
 
 	} //namespace _p
 
+	///	\brief Compile time checked format string.
+	///	\param[in] args - Values to print, one for each field.
+	///	\return An encoder that can be passed to \ref print.
+	///	\remarks Fields are "{}" for the default \ref toPrint, "{:x}" \ref toPrint_hex, "{:X}" \ref toPrint_hex_fix,
+	///		"{:b}" \ref toPrint_bin, "{:B}" \ref toPrint_bin_fix and "{:e}" \ref toPrint_fp_fancy.
+	///		Use "{{" and "}}" to print the braces.
+	///		The format is parsed at compile time, malformed formats and mismatched argument counts fail to build.
+	///	\code
+	///		core::print<char8_t>(sink, core::toPrint_format<"Received {} bytes from {:x}">(count, id));
+	///	\endcode
+	template<_p::format_literal Fmt, typename... Args>
+	[[nodiscard]] FORCE_INLINE auto toPrint_format(Args const&... args)
+	{
+		static_assert(sizeof...(Args) == _p::format_parsed_v<Fmt>.field_count, "Number of arguments does not match the number of fields in the format string");
+		return _p::make_format<Fmt>(std::index_sequence_for<Args...>{}, args...);
+	}
+
 
 	template<_p::c_toPrint_char CharT, typename Sink, typename... Args>
 	FORCE_INLINE void print(Sink& sink, Args const&... args)
@@ -255,4 +690,39 @@ namespace core
 		}
 	}
 
+	///	\brief Same as \ref print, but skips the size pre-pass.
+	///	\remarks The sink buffer is sized for the worst case of every argument and only the used length is committed.
+	///		Useful when encoders are expensive to size (ex. numbers), at the cost of a larger scratch buffer.
+	///		Sinks with their own buffer must honour the size given on buffer_released.
+	///		Falls back to \ref print if an argument's get_print does not return the end of its output.
+	template<_p::c_toPrint_char CharT, typename Sink, typename... Args>
+	FORCE_INLINE void print_single_pass(Sink& sink, Args const&... args)
+	{
+		if constexpr(::core::_p::is_sink_toPrint_v<Sink>)
+		{
+			::core::_p::toPrint_assist<CharT>::print_single_pass(sink, args...);
+		}
+		else
+		{
+			using compatible_sink_t = ::core::sink_toPrint<std::remove_cvref_t<Sink>>;
+			compatible_sink_t real_sink{sink};
+			::core::_p::toPrint_assist<CharT>::print_single_pass(real_sink, args...);
+		}
+	}
+
+	template<_p::c_toPrint_char CharT, typename Sink, typename... Args>
+	FORCE_INLINE void print_single_pass(Sink&& sink, Args const&... args)
+	{
+		if constexpr(::core::_p::is_sink_toPrint_v<Sink>)
+		{
+			::core::_p::toPrint_assist<CharT>::print_single_pass(sink, args...);
+		}
+		else
+		{
+			using compatible_sink_t = ::core::sink_toPrint<std::remove_cvref_t<Sink>>;
+			compatible_sink_t real_sink{sink};
+			::core::_p::toPrint_assist<CharT>::print_single_pass(real_sink, args...);
+		}
+	}
+
 } //namespace core
@@ -0,0 +1,182 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#include "toPrint_base.hpp"
+
+#include <CoreLib/core_cpu.hpp>
+#include <CoreLib/string/core_string_numeric.hpp>
+
+namespace core
+{
+#if defined(_M_AMD64) or defined(__amd64__)
+
+///	\brief	Prints a \ref amd64::cpu_topology, one cache or TLB per line. Ex.:
+///		"L1d: 48KiB, 12-way, 64B line, shared by 2"
+///		"L2 TLB 4K/2M/4M: 1024 entries, 8-way, shared by 2"
+///		"hybrid, core: performance"
+class toPrint_cpu_topology: public toPrint_base
+{
+public:
+	toPrint_cpu_topology(amd64::cpu_topology const& p_topology)
+	{
+		for(amd64::cache_info const& info: p_topology.caches)
+		{
+			new_line();
+			append_level(info.level, static_cast<uint8_t>(info.type));
+			m_text.append(u8": ");
+			append_size(info.size);
+			m_text.append(u8", ");
+			append_ways(info.ways, info.fully_associative);
+			m_text.append(u8", ");
+			append_number(info.line_size);
+			m_text.append(u8"B line, shared by ");
+			append_number(info.shared_by);
+			if(info.inclusive) m_text.append(u8", inclusive");
+		}
+
+		for(amd64::tlb_info const& info: p_topology.tlbs)
+		{
+			new_line();
+			append_level(info.level, static_cast<uint8_t>(info.type));
+			m_text.append(u8" TLB ");
+			append_pages(info.page_sizes);
+			m_text.append(u8": ");
+			append_number(info.entries);
+			m_text.append(u8" entries, ");
+			append_ways(info.ways, info.fully_associative);
+			if(info.shared_by)
+			{
+				m_text.append(u8", shared by ");
+				append_number(info.shared_by);
+			}
+		}
+
+		if(p_topology.hybrid)
+		{
+			new_line();
+			m_text.append(u8"hybrid, core: ");
+			switch(p_topology.core)
+			{
+				case amd64::core_type::performance:	m_text.append(u8"performance");	break;
+				case amd64::core_type::efficiency:	m_text.append(u8"efficiency");	break;
+				default:							m_text.append(u8"unknown");		break;
+			}
+		}
+	}
+
+	template<_p::c_toPrint_char CharT>
+	inline uintptr_t size(CharT const&) const { return m_text.size(); }
+
+	template<_p::c_toPrint_char CharT>
+	CharT* get_print(CharT* p_out) const
+	{
+		for(char8_t const tchar: m_text)
+		{
+			*(p_out++) = tchar;
+		}
+		return p_out;
+	}
+
+private:
+	void new_line()
+	{
+		if(!m_text.empty()) m_text.push_back(u8'\n');
+	}
+
+	template<typename num_T>
+	void append_number(num_T const p_value)
+	{
+		std::array<char8_t, to_chars_dec_max_size_v<num_T>> buff;
+		m_text.append(buff.data(), to_chars(p_value, buff));
+	}
+
+	void append_level(uint8_t const p_level, uint8_t const p_type)
+	{
+		static constexpr std::array<std::u8string_view, 6> suffix{u8"", u8"d", u8"i", u8"", u8"ld", u8"st"};
+		m_text.push_back(u8'L');
+		append_number(p_level);
+		if(p_type < suffix.size()) m_text.append(suffix[p_type]);
+	}
+
+	void append_size(uint64_t const p_size)
+	{
+		if(p_size && (p_size % (1024 * 1024)) == 0)
+		{
+			append_number(p_size / (1024 * 1024));
+			m_text.append(u8"MiB");
+		}
+		else if(p_size && (p_size % 1024) == 0)
+		{
+			append_number(p_size / 1024);
+			m_text.append(u8"KiB");
+		}
+		else
+		{
+			append_number(p_size);
+			m_text.push_back(u8'B');
+		}
+	}
+
+	void append_ways(uint16_t const p_ways, bool const p_fully)
+	{
+		if(p_fully)
+		{
+			m_text.append(u8"fully associative");
+		}
+		else
+		{
+			append_number(p_ways);
+			m_text.append(u8"-way");
+		}
+	}
+
+	void append_pages(uint8_t const p_pages)
+	{
+		static constexpr std::array<std::u8string_view, 4> names{u8"4K", u8"2M", u8"4M", u8"1G"};
+		bool first = true;
+		for(uint8_t bit = 0; bit < names.size(); ++bit)
+		{
+			if(!((p_pages >> bit) & 1)) continue;
+			if(!first) m_text.push_back(u8'/');
+			m_text.append(names[bit]);
+			first = false;
+		}
+	}
+
+private:
+	std::u8string m_text;
+};
+
+#endif
+
+} //namespace core
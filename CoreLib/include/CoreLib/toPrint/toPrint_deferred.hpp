@@ -0,0 +1,318 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <new>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <system_error>
+
+#include <CoreLib/core_sync.hpp>
+#include <CoreLib/core_thread.hpp>
+
+#include "toPrint.hpp"
+
+namespace core
+{
+	class deferred_printer;
+
+	namespace _p
+	{
+		struct deferred_ring;
+
+		///	\brief Renders the payload of a record, appending the text to p_out
+		using deferred_decode_t = void (*)(std::byte const* p_payload, std::u8string& p_out);
+
+		struct deferred_record_header
+		{
+			uint32_t			size;	//!< Size of the whole record including this header
+			uint32_t			reserved;
+			deferred_decode_t	decode;	//!< nullptr marks the padding before the ring wraps around
+		};
+
+		static constexpr uintptr_t deferred_field_align		= 8;
+		static constexpr uintptr_t deferred_record_align	= sizeof(deferred_record_header);
+
+		inline constexpr uintptr_t deferred_round(uintptr_t const p_size, uintptr_t const p_align)
+		{
+			return (p_size + p_align - 1) & ~(p_align - 1);
+		}
+
+		///	\brief How an argument is stored in a record, and how it is read back
+		template<typename T>
+		struct deferred_arg;
+
+		template<typename T> requires
+		(
+			std::is_copy_constructible_v<T> and
+			std::is_trivially_destructible_v<T> and
+			not is_toPrint_v<T> and
+			(alignof(T) <= deferred_field_align)
+		)
+		struct deferred_arg<T>
+		{
+			using view_t = T const&;
+
+			static inline constexpr uintptr_t size(T const&) { return deferred_round(sizeof(T), deferred_field_align); }
+
+			static inline std::byte* store(std::byte* const p_out, T const& p_val)
+			{
+				new (p_out) T(p_val);
+				return p_out + size(p_val);
+			}
+
+			static inline view_t load(std::byte const*& p_in)
+			{
+				T const& res = *std::launder(reinterpret_cast<T const*>(p_in));
+				p_in += deferred_round(sizeof(T), deferred_field_align);
+				return res;
+			}
+		};
+
+		template<typename char_t> requires toPrint_is_one_of_chars_v<char_t>
+		struct deferred_arg<std::basic_string_view<char_t>>
+		{
+			using view_t = std::basic_string_view<char_t>;
+
+			static inline uintptr_t size(view_t const p_val)
+			{
+				return sizeof(uint64_t) + deferred_round(p_val.size() * sizeof(char_t), deferred_field_align);
+			}
+
+			static inline std::byte* store(std::byte* const p_out, view_t const p_val)
+			{
+				uint64_t const t_size = p_val.size();
+				memcpy(p_out, &t_size, sizeof(uint64_t));
+				memcpy(p_out + sizeof(uint64_t), p_val.data(), p_val.size() * sizeof(char_t));
+				return p_out + size(p_val);
+			}
+
+			static inline view_t load(std::byte const*& p_in)
+			{
+				uint64_t t_size;
+				memcpy(&t_size, p_in, sizeof(uint64_t));
+				view_t const res{reinterpret_cast<char_t const*>(p_in + sizeof(uint64_t)), static_cast<uintptr_t>(t_size)};
+				p_in += sizeof(uint64_t) + deferred_round(res.size() * sizeof(char_t), deferred_field_align);
+				return res;
+			}
+		};
+
+		template<typename char_t>
+		struct deferred_arg<std::basic_string<char_t>>: public deferred_arg<std::basic_string_view<char_t>> {};
+
+		///	\brief String literals and character arrays, stored as the text up to the first null
+		template<typename char_t, uintptr_t N> requires toPrint_is_one_of_chars_v<char_t>
+		struct deferred_arg<char_t[N]>: public deferred_arg<std::basic_string_view<char_t>>
+		{
+			using base_t = deferred_arg<std::basic_string_view<char_t>>;
+
+			static inline std::basic_string_view<char_t> as_view(char_t const (&p_val)[N])
+			{
+				return std::basic_string_view<char_t>{p_val, static_cast<uintptr_t>(std::find(p_val, p_val + N, char_t{0}) - p_val)};
+			}
+
+			static inline uintptr_t size(char_t const (&p_val)[N]) { return base_t::size(as_view(p_val)); }
+
+			static inline std::byte* store(std::byte* const p_out, char_t const (&p_val)[N])
+			{
+				return base_t::store(p_out, as_view(p_val));
+			}
+		};
+
+		///	\brief Appends to a string instead of replacing its content
+		class deferred_render_sink: public sink_toPrint_base
+		{
+		public:
+			static constexpr sink_toPrint_properties_t sink_toPrint_properties{ .has_own_buffer = true };
+
+		public:
+			deferred_render_sink(std::u8string& p_string): m_string(p_string){}
+
+			inline char8_t* buffer_acquire(uintptr_t const p_size)
+			{
+				m_base = m_string.size();
+				m_string.resize(m_base + p_size);
+				return m_string.data() + m_base;
+			}
+
+			inline void buffer_released(char8_t* const, uintptr_t const p_size)
+			{
+				m_string.resize(m_base + p_size);
+			}
+
+		private:
+			std::u8string&	m_string;
+			uintptr_t		m_base = 0;
+		};
+
+		template<format_literal Fmt, typename... Stored>
+		void deferred_decode(std::byte const* const p_payload, std::u8string& p_out)
+		{
+			[[maybe_unused]] std::byte const* pivot = p_payload;
+			//braced initialization is evaluated left to right
+			std::tuple<typename deferred_arg<Stored>::view_t...> const t_values{ deferred_arg<Stored>::load(pivot)... };
+			deferred_render_sink t_sink{p_out};
+			std::apply(
+				[&t_sink](auto const&... p_values)
+				{
+					::core::print_single_pass<char8_t>(t_sink, ::core::toPrint_format<Fmt>(p_values...));
+				}, t_values);
+		}
+
+	} //namespace _p
+
+
+	///	\brief Moves the formatting of prints to a background thread.
+	///	\remarks Each thread records the raw values of its prints, and a static decoder for their format, into its own ring.
+	///		The background thread renders them with \ref toPrint_format and hands the text over to the sink given on \ref start.
+	///		Prints from the same thread keep their order, prints from different threads are only ordered per drain.
+	///		Arguments that refer to memory they do not own (ex. pointers) must still be valid when rendered.
+	///	\see print_deferred
+	class deferred_printer
+	{
+	public:
+		///	\brief What to do when a thread's ring is full
+		enum class overflow: uint8_t
+		{
+			block,	//!< Wait for the background thread to make room
+			drop,	//!< Discard the print, see \ref dropped
+		};
+
+		using output_t = void (*)(void* p_context, std::u8string_view p_text);
+
+	public:
+		deferred_printer() = default;
+		~deferred_printer();
+
+		///	\param[in] p_sink - Where the rendered text is printed to, must remain valid until \ref stop
+		///	\param[in] p_ring_size - Size of each thread's ring, rounded up to a power of 2
+		///	\param[in] p_flush_interval - Maximum time in milliseconds a print is held before being rendered, 0 to only render when a ring is half full
+		///	\param[in] p_policy - What to do when a ring is full
+		template<typename Sink>
+		inline std::errc start(Sink& p_sink, uintptr_t const p_ring_size = 0x10000, uint32_t const p_flush_interval = 100, overflow const p_policy = overflow::block)
+		{
+			return start(
+				[](void* const p_context, std::u8string_view const p_text)
+				{
+					::core::print<char8_t>(*static_cast<Sink*>(p_context), p_text);
+				}, &p_sink, p_ring_size, p_flush_interval, p_policy);
+		}
+
+		std::errc start(output_t p_output, void* p_context, uintptr_t p_ring_size, uint32_t p_flush_interval, overflow p_policy);
+
+		///	\brief Renders all pending prints and stops the background thread
+		void stop();
+
+		[[nodiscard]] inline bool is_running() const { return m_output != nullptr; }
+
+		///	\brief Renders all prints recorded so far, from the calling thread
+		void flush();
+
+		///	\return Number of prints discarded, due to \ref overflow::drop or for being larger than a ring
+		[[nodiscard]] inline uint64_t dropped() const { return m_dropped.load(std::memory_order::relaxed); }
+
+		///	\brief Reserves a contiguous record in the calling thread's ring
+		///	\return nullptr if the printer is not running or the record was dropped
+		[[nodiscard]] std::byte* reserve(uintptr_t p_size);
+
+		///	\brief Publishes the record obtained with \ref reserve
+		void commit(uintptr_t p_size);
+
+	private:
+		_p::deferred_ring* bind();
+		void wake();
+		void drain();
+		void renderer(void*);
+
+	private:
+		output_t	m_output			= nullptr;
+		void*		m_context			= nullptr;
+		uint64_t	m_id				= 0;
+		uintptr_t	m_ring_size			= 0;
+		uint32_t	m_flush_interval	= 0;
+		overflow	m_policy			= overflow::block;
+
+		std::atomic<bool>		m_stop		{false};
+		std::atomic<bool>		m_wake		{false};
+		std::atomic<uint64_t>	m_dropped	{0};
+
+		atomic_spinlock						m_lock;			//!< Protects m_rings
+		std::vector<_p::deferred_ring*>		m_rings;
+		mutex								m_drain_lock;
+		std::u8string						m_render;		//!< Protected by m_drain_lock
+
+		event_trap	m_trap;
+		thread		m_thread;
+
+	private:
+		deferred_printer(deferred_printer const&) = delete;
+		deferred_printer(deferred_printer&&) = delete;
+		deferred_printer& operator = (deferred_printer const&) = delete;
+		deferred_printer& operator = (deferred_printer&&) = delete;
+	};
+
+	///	\brief Records a print to be rendered later by p_printer's background thread
+	///	\remarks Same format as \ref toPrint_format, only the argument values are copied on the calling thread.
+	///	\code
+	///		core::print_deferred<"Received {} bytes from {}\n">(printer, count, address);
+	///	\endcode
+	template<_p::format_literal Fmt, typename... Args>
+	inline void print_deferred(deferred_printer& p_printer, Args const&... args)
+	{
+		static_assert(sizeof...(Args) == _p::format_parsed_v<Fmt>.field_count, "Number of arguments does not match the number of fields in the format string");
+
+		constexpr uintptr_t header_size = sizeof(_p::deferred_record_header);
+		uintptr_t const t_size = _p::deferred_round(
+			(header_size + ... + _p::deferred_arg<std::remove_cvref_t<Args>>::size(args)), _p::deferred_record_align);
+
+		std::byte* const t_record = p_printer.reserve(t_size);
+		if(!t_record) return;
+
+		_p::deferred_record_header const t_header
+		{
+			.size		= static_cast<uint32_t>(t_size),
+			.reserved	= 0,
+			.decode		= &_p::deferred_decode<Fmt, std::remove_cvref_t<Args>...>,
+		};
+		memcpy(t_record, &t_header, header_size);
+
+		[[maybe_unused]] std::byte* pivot = t_record + header_size;
+		((pivot = _p::deferred_arg<std::remove_cvref_t<Args>>::store(pivot, args)), ...);
+
+		p_printer.commit(t_size);
+	}
+
+} //namespace core
@@ -281,6 +281,9 @@ public:
 		return UTF8_to_UCS4_faulty_size(m_data);
 	}
 
+	template<_p::c_toPrint_char CharT>
+	inline constexpr uintptr_t max_size(CharT const&) const { return m_data.size(); }
+
 	char8_t* get_print(char8_t* const p_out) const
 	{
 		memcpy(p_out, m_data.data(), m_data.size());
@@ -321,6 +324,10 @@ public:
 		return UTF16_to_UCS4_faulty_size(m_data);
 	}
 
+	inline constexpr uintptr_t max_size(char8_t  const&) const { return m_data.size() * 3; }
+	inline constexpr uintptr_t max_size(char16_t const&) const { return m_data.size(); }
+	inline constexpr uintptr_t max_size(char32_t const&) const { return m_data.size(); }
+
 	char8_t* get_print(char8_t* const p_out) const
 	{
 		return UTF16_to_UTF8_faulty_unsafe(m_data, '?', p_out);
@@ -365,6 +372,10 @@ public:
 		return m_data.size();
 	}
 
+	inline constexpr uintptr_t max_size(char8_t  const&) const { return m_data.size() * 4; }
+	inline constexpr uintptr_t max_size(char16_t const&) const { return m_data.size() * 2; }
+	inline constexpr uintptr_t max_size(char32_t const&) const { return m_data.size(); }
+
 	char8_t* get_print(char8_t* const p_out) const
 	{
 		return UCS4_to_UTF8_faulty_unsafe(m_data, '?', p_out);
@@ -502,6 +513,9 @@ public:
 	template<_p::c_toPrint_char CharT>
 	inline uintptr_t size(CharT const&) const { return size(); }
 
+	template<_p::c_toPrint_char CharT>
+	static inline constexpr uintptr_t max_size(CharT const&) { return core::to_chars_dec_max_size_v<Num_T>; }
+
 	template<_p::c_toPrint_char CharT>
 	inline CharT* get_print(CharT* const p_out) const
 	{
@@ -625,8 +639,8 @@ public:
 	template<_p::c_toPrint_char CharT>
 	CharT* get_print(CharT* p_out) const
 	{
-		char8_t const* pivot = m_preCalc.data();
-		char8_t const* const last = pivot + m_size;
+		char16_t const* pivot = m_preCalc.data();
+		char16_t const* const last = pivot + m_size;
 		while(pivot != last)
 		{
 			*(p_out++) = *(pivot++);
@@ -640,6 +654,11 @@ public:
 			std::u16string_view{m_preCalc.data(), m_size}, static_cast<char32_t>(-1));
 	}
 
+	template<_p::c_toPrint_char CharT>
+	inline uintptr_t max_size(CharT const&) const { return m_size; }
+
+	inline uintptr_t max_size(char8_t const&) const { return m_size * 3; }
+
 	char8_t* get_print(char8_t* const p_out) const
 	{
 		return UTF16_to_UTF8_faulty_unsafe(
@@ -671,6 +690,9 @@ public:
 	template<_p::c_toPrint_char CharT>
 	inline uintptr_t size(CharT const&) const { return size(); }
 
+	template<_p::c_toPrint_char CharT>
+	static inline constexpr uintptr_t max_size(CharT const&) { return core::to_chars_hex_max_size_v<Num_T>; }
+
 	template<_p::c_toPrint_char CharT>
 	inline CharT* get_print(CharT* const p_out) const
 	{
@@ -749,6 +771,9 @@ public:
 	template<_p::c_toPrint_char CharT>
 	inline uintptr_t size(CharT const&) const { return size(); }
 
+	template<_p::c_toPrint_char CharT>
+	static inline constexpr uintptr_t max_size(CharT const&) { return core::to_chars_bin_max_size_v<Num_T>; }
+
 	template<_p::c_toPrint_char CharT>
 	inline CharT* get_print(CharT* const p_out) const
 	{
@@ -36,6 +36,7 @@
 
 #include <CoreLib/core_extra_compiler.hpp>
 #include <CoreLib/core_file.hpp>
+#include <CoreLib/core_file_async.hpp>
 #include <CoreLib/core_alloca.hpp>
 #include <CoreLib/core_endian.hpp>
 #include <CoreLib/string/core_wchar_alias.hpp>
@@ -49,7 +50,7 @@ namespace core
 	}
 	namespace _p
 	{
-		template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex>)
+		template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex> || std::is_same_v<file_t, file_write_async>)
 		class sink_file_locked
 		{
 		protected:
@@ -64,6 +65,37 @@ namespace core
 			file_t& m_file;
 		};
 
+		///	\brief Formats directly into the writer's staging ring when there is room, and the space is suitably aligned.
+		///		Otherwise toPrint formats into its own scratch space and the text goes through write.
+		template<>
+		class sink_file_locked<file_write_async>
+		{
+		protected:
+			inline sink_file_locked(file_write_async& p_file): m_file(p_file){}
+
+			inline void push_out(void const* const p_data, uintptr_t const p_size) const
+			{
+				m_file.write(p_data, p_size);
+			}
+
+			///	\return nullptr if there is no suitable room, in which case nothing is reserved
+			inline void* acquire_out(uintptr_t const p_size, uintptr_t const p_alignment)
+			{
+				return m_file.reserve(p_size, p_alignment);
+			}
+
+			inline void release_out(void const* const p_data, uintptr_t const p_size)
+			{
+				if(p_data)
+				{
+					m_file.commit(p_size);
+				}
+			}
+
+		private:
+			file_write_async& m_file;
+		};
+
 		template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex>)
 		class sink_file_unlocked
 		{
@@ -82,15 +114,29 @@ namespace core
 
 
 	//======== ======== ======== ======== Locked ======== ======== ======== ========
+	//	These also take a \ref file_write_async, in which case printing does not block on I/O.
 
-	template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex>)
+	template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex> || std::is_same_v<file_t, file_write_async>)
 	class sink_file_UTF8: public sink_toPrint_base, private _p::sink_file_locked<file_t>
 	{
 	private:
 		using sink_t = _p::sink_file_locked<file_t>;
+	public:
+		static constexpr sink_toPrint_properties_t sink_toPrint_properties{ .has_own_buffer = std::is_same_v<file_t, file_write_async> };
+
 	public:
 		sink_file_UTF8(file_t& p_file): sink_t(p_file){}
 
+		inline char8_t* buffer_acquire(uintptr_t const p_size) requires std::is_same_v<file_t, file_write_async>
+		{
+			return reinterpret_cast<char8_t*>(sink_t::acquire_out(p_size, alignof(char8_t)));
+		}
+
+		inline void buffer_released(char8_t* const p_buff, uintptr_t const p_size) requires std::is_same_v<file_t, file_write_async>
+		{
+			sink_t::release_out(p_buff, p_size);
+		}
+
 		void write(std::u8string_view const p_out) const
 		{
 			sink_t::push_out(p_out.data(), p_out.size());
@@ -133,13 +179,13 @@ namespace core
 		}
 	};
 
-	template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex>)
+	template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex> || std::is_same_v<file_t, file_write_async>)
 	class sink_file_UTF16BE: public sink_toPrint_base, private _p::sink_file_locked<file_t>
 	{
 	private:
 		using sink_t = _p::sink_file_locked<file_t>;
 
-		inline void commit(std::span<char16_t> const p_out) const
+		static inline void to_order(std::span<char16_t> const p_out)
 		{
 			if constexpr(std::endian::native == std::endian::little)
 			{
@@ -148,12 +194,31 @@ namespace core
 					tchar = byte_swap(tchar);
 				}
 			}
+		}
+
+		inline void commit(std::span<char16_t> const p_out) const
+		{
+			to_order(p_out);
 			sink_t::push_out(p_out.data(), p_out.size() * sizeof(char16_t));
 		}
 
+	public:
+		static constexpr sink_toPrint_properties_t sink_toPrint_properties{ .has_own_buffer = std::is_same_v<file_t, file_write_async> };
+
 	public:
 		sink_file_UTF16BE(file_t& p_file): sink_t(p_file){}
 
+		inline char16_t* buffer_acquire(uintptr_t const p_size) requires std::is_same_v<file_t, file_write_async>
+		{
+			return reinterpret_cast<char16_t*>(sink_t::acquire_out(p_size * sizeof(char16_t), alignof(char16_t)));
+		}
+
+		inline void buffer_released(char16_t* const p_buff, uintptr_t const p_size) requires std::is_same_v<file_t, file_write_async>
+		{
+			to_order(std::span<char16_t>{p_buff, p_size});
+			sink_t::release_out(p_buff, p_size * sizeof(char16_t));
+		}
+
 		NO_INLINE void write(std::u8string_view const p_out) const
 		{
 			const uintptr_t count = UTF8_to_UTF16_faulty_size(p_out, '?');
@@ -218,13 +283,13 @@ namespace core
 		}
 	};
 
-	template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex>)
+	template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex> || std::is_same_v<file_t, file_write_async>)
 	class sink_file_UTF16LE: public sink_toPrint_base, private _p::sink_file_locked<file_t>
 	{
 	private:
 		using sink_t = _p::sink_file_locked<file_t>;
 
-		inline void commit(std::span<char16_t> const p_out) const
+		static inline void to_order(std::span<char16_t> const p_out)
 		{
 			if constexpr(std::endian::native == std::endian::big)
 			{
@@ -233,12 +298,31 @@ namespace core
 					tchar = byte_swap(tchar);
 				}
 			}
+		}
+
+		inline void commit(std::span<char16_t> const p_out) const
+		{
+			to_order(p_out);
 			sink_t::push_out(p_out.data(), p_out.size() * sizeof(char16_t));
 		}
 
+	public:
+		static constexpr sink_toPrint_properties_t sink_toPrint_properties{ .has_own_buffer = std::is_same_v<file_t, file_write_async> };
+
 	public:
 		sink_file_UTF16LE(file_t& p_file): sink_t(p_file){}
 
+		inline char16_t* buffer_acquire(uintptr_t const p_size) requires std::is_same_v<file_t, file_write_async>
+		{
+			return reinterpret_cast<char16_t*>(sink_t::acquire_out(p_size * sizeof(char16_t), alignof(char16_t)));
+		}
+
+		inline void buffer_released(char16_t* const p_buff, uintptr_t const p_size) requires std::is_same_v<file_t, file_write_async>
+		{
+			to_order(std::span<char16_t>{p_buff, p_size});
+			sink_t::release_out(p_buff, p_size * sizeof(char16_t));
+		}
+
 		NO_INLINE void write(std::u8string_view const p_out) const
 		{
 			uintptr_t const count = UTF8_to_UTF16_faulty_size(p_out, '?');
@@ -303,13 +387,13 @@ namespace core
 		}
 	};
 
-	template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex>)
+	template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex> || std::is_same_v<file_t, file_write_async>)
 	class sink_file_UCS4BE: public sink_toPrint_base, private _p::sink_file_locked<file_t>
 	{
 	private:
 		using sink_t = _p::sink_file_locked<file_t>;
 
-		inline void commit(std::span<char32_t> const p_out) const
+		static inline void to_order(std::span<char32_t> const p_out)
 		{
 			if constexpr(std::endian::native == std::endian::little)
 			{
@@ -318,12 +402,31 @@ namespace core
 					tchar = byte_swap(tchar);
 				}
 			}
+		}
+
+		inline void commit(std::span<char32_t> const p_out) const
+		{
+			to_order(p_out);
 			sink_t::push_out(p_out.data(), p_out.size() * sizeof(char32_t));
 		}
 
+	public:
+		static constexpr sink_toPrint_properties_t sink_toPrint_properties{ .has_own_buffer = std::is_same_v<file_t, file_write_async> };
+
 	public:
 		sink_file_UCS4BE(file_t& p_file): sink_t(p_file){}
 
+		inline char32_t* buffer_acquire(uintptr_t const p_size) requires std::is_same_v<file_t, file_write_async>
+		{
+			return reinterpret_cast<char32_t*>(sink_t::acquire_out(p_size * sizeof(char32_t), alignof(char32_t)));
+		}
+
+		inline void buffer_released(char32_t* const p_buff, uintptr_t const p_size) requires std::is_same_v<file_t, file_write_async>
+		{
+			to_order(std::span<char32_t>{p_buff, p_size});
+			sink_t::release_out(p_buff, p_size * sizeof(char32_t));
+		}
+
 		NO_INLINE void write(std::u8string_view const p_out) const
 		{
 			uintptr_t const count = UTF8_to_UCS4_faulty_size(p_out);
@@ -376,7 +479,7 @@ namespace core
 				}
 				else
 				{
-					char32_t* const buff = reinterpret_cast<char16_t*>(core_alloca(count * sizeof(char32_t)));
+					char32_t* const buff = reinterpret_cast<char32_t*>(core_alloca(count * sizeof(char32_t)));
 					memcpy(buff, p_out.data(), count * sizeof(char32_t));
 					commit({buff, count});
 				}
@@ -388,13 +491,13 @@ namespace core
 		}
 	};
 
-	template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex>)
+	template<typename file_t> requires (std::is_same_v<file_t, file_write> || std::is_same_v<file_t, file_duplex> || std::is_same_v<file_t, file_write_async>)
 	class sink_file_UCS4LE: public sink_toPrint_base, private _p::sink_file_locked<file_t>
 	{
 	private:
 		using sink_t = _p::sink_file_locked<file_t>;
 
-		inline void commit(std::span<char32_t> const p_out) const
+		static inline void to_order(std::span<char32_t> const p_out)
 		{
 			if constexpr(std::endian::native == std::endian::big)
 			{
@@ -403,12 +506,31 @@ namespace core
 					tchar = byte_swap(tchar);
 				}
 			}
+		}
+
+		inline void commit(std::span<char32_t> const p_out) const
+		{
+			to_order(p_out);
 			sink_t::push_out(p_out.data(), p_out.size() * sizeof(char32_t));
 		}
 
+	public:
+		static constexpr sink_toPrint_properties_t sink_toPrint_properties{ .has_own_buffer = std::is_same_v<file_t, file_write_async> };
+
 	public:
 		sink_file_UCS4LE(file_t& p_file): sink_t(p_file){}
 
+		inline char32_t* buffer_acquire(uintptr_t const p_size) requires std::is_same_v<file_t, file_write_async>
+		{
+			return reinterpret_cast<char32_t*>(sink_t::acquire_out(p_size * sizeof(char32_t), alignof(char32_t)));
+		}
+
+		inline void buffer_released(char32_t* const p_buff, uintptr_t const p_size) requires std::is_same_v<file_t, file_write_async>
+		{
+			to_order(std::span<char32_t>{p_buff, p_size});
+			sink_t::release_out(p_buff, p_size * sizeof(char32_t));
+		}
+
 		NO_INLINE void write(std::u8string_view const p_out) const
 		{
 			uintptr_t const count = UTF8_to_UCS4_faulty_size(p_out);
@@ -461,7 +583,7 @@ namespace core
 				}
 				else
 				{
-					char32_t* const buff = reinterpret_cast<char16_t*>(core_alloca(count * sizeof(char32_t)));
+					char32_t* const buff = reinterpret_cast<char32_t*>(core_alloca(count * sizeof(char32_t)));
 					memcpy(buff, p_out.data(), count * sizeof(char32_t));
 					commit({buff, count});
 				}
@@ -770,7 +892,7 @@ namespace core
 				}
 				else
 				{
-					char32_t* const buff = reinterpret_cast<char16_t*>(core_alloca(count * sizeof(char32_t)));
+					char32_t* const buff = reinterpret_cast<char32_t*>(core_alloca(count * sizeof(char32_t)));
 					memcpy(buff, p_out.data(), count * sizeof(char32_t));
 					commit({buff, count});
 				}
@@ -855,7 +977,7 @@ namespace core
 				}
 				else
 				{
-					char32_t* const buff = reinterpret_cast<char16_t*>(core_alloca(count * sizeof(char32_t)));
+					char32_t* const buff = reinterpret_cast<char32_t*>(core_alloca(count * sizeof(char32_t)));
 					memcpy(buff, p_out.data(), count * sizeof(char32_t));
 					commit({buff, count});
 				}
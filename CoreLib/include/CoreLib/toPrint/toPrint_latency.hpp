@@ -0,0 +1,96 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <array>
+
+#include "toPrint_base.hpp"
+
+#include <CoreLib/core_latency.hpp>
+#include <CoreLib/string/core_string_numeric.hpp>
+
+namespace core
+{
+
+///	\brief	Prints a summary of a \ref latency_histogram,
+///			"n=<count> min=<>ns p50=<>ns p90=<>ns p99=<>ns p99.9=<>ns max=<>ns mean=<>ns"
+class toPrint_latency: public toPrint_base
+{
+private:
+	static constexpr uintptr_t max_number_size = to_chars_dec_max_size_v<uint64_t>;
+	static constexpr uintptr_t max_size = 8 * max_number_size + 64;
+
+public:
+	toPrint_latency(latency_histogram const& p_histogram)
+	{
+		char8_t* pivot = m_text.data();
+		append(pivot, u8"n=", p_histogram.count());
+		append(pivot, u8" min=", p_histogram.min());
+		append(pivot, u8"ns p50=", p_histogram.percentile(50.0));
+		append(pivot, u8"ns p90=", p_histogram.percentile(90.0));
+		append(pivot, u8"ns p99=", p_histogram.percentile(99.0));
+		append(pivot, u8"ns p99.9=", p_histogram.percentile(99.9));
+		append(pivot, u8"ns max=", p_histogram.max());
+		append(pivot, u8"ns mean=", p_histogram.mean());
+		*(pivot++) = u8'n';
+		*(pivot++) = u8's';
+		m_size = static_cast<uintptr_t>(pivot - m_text.data());
+	}
+
+	template<_p::c_toPrint_char CharT>
+	inline uintptr_t size(CharT const&) const { return m_size; }
+
+	template<_p::c_toPrint_char CharT>
+	CharT* get_print(CharT* p_out) const
+	{
+		char8_t const* pivot = m_text.data();
+		char8_t const* const last = pivot + m_size;
+		while(pivot != last)
+		{
+			*(p_out++) = *(pivot++);
+		}
+		return p_out;
+	}
+
+private:
+	template<uintptr_t N>
+	static inline void append(char8_t*& p_out, char8_t const (&p_label)[N], uint64_t const p_value)
+	{
+		for(uintptr_t i = 0; i < N - 1; ++i)
+		{
+			*(p_out++) = p_label[i];
+		}
+		p_out = to_chars_unsafe(p_value, p_out);
+	}
+
+private:
+	std::array<char8_t, max_size> m_text;
+	uintptr_t m_size;
+};
+
+} //namespace core
@@ -48,6 +48,9 @@ template<typename T> sink_toPrint(T) -> sink_toPrint<std::remove_cvref_t<T>>;
 
 struct sink_toPrint_properties_t
 {
+	///	\brief The sink provides buffer_acquire and buffer_released, text is formatted directly into its buffer.
+	///	\remarks If the sink also has a write, buffer_acquire may return nullptr when it has no room.
+	///		The text is then formatted into scratch space and passed to write, buffer_released is not called.
 	bool const has_own_buffer;
 };
 
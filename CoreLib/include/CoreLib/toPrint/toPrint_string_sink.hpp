@@ -52,9 +52,9 @@ namespace core
 			return m_string.data();
 		}
 
-		inline void buffer_released(char_t* const, uintptr_t const)
+		inline void buffer_released(char_t* const, uintptr_t const p_size)
 		{
-
+			m_string.resize(p_size);
 		}
 
 	private:
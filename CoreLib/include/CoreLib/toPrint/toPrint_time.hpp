@@ -0,0 +1,68 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include "toPrint_base.hpp"
+
+#include <CoreLib/core_time.hpp>
+
+namespace core
+{
+
+///	\brief	Prints a date as an ISO 8601 (RFC 3339) UTC timestamp, "YYYY-MM-DDTHH:MM:SS.fffffffffZ"
+///	\remarks	The output has a fixed width and is written straight into the sink's buffer.
+///			The fractional seconds are truncated to the requested number of digits (up to 9), 0 omits them.
+class toPrint_iso8601: public toPrint_base
+{
+public:
+	toPrint_iso8601(date_time_t const& p_date, uint8_t const p_fraction_digits = 9)
+		: m_date(p_date)
+		, m_fraction_digits(p_fraction_digits < 9 ? p_fraction_digits : uint8_t{9})
+	{}
+
+	toPrint_iso8601(time_point_t const p_time, uint8_t const p_fraction_digits = 9)
+		: toPrint_iso8601(system_time_to_date(p_time), p_fraction_digits)
+	{}
+
+	inline uintptr_t size() const { return to_chars_iso8601_size(m_fraction_digits); }
+
+	template<_p::c_toPrint_char CharT>
+	inline uintptr_t size(CharT const&) const { return size(); }
+
+	template<_p::c_toPrint_char CharT>
+	inline CharT* get_print(CharT* const p_out) const
+	{
+		return to_chars_iso8601_unsafe(m_date, m_fraction_digits, p_out);
+	}
+
+private:
+	date_time_t const m_date;
+	uint8_t const m_fraction_digits;
+};
+
+} //namespace core
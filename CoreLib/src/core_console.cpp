@@ -34,6 +34,8 @@
 #include <vector>
 #include <span>
 #include <limits>
+#include <cstring>
+#include <utility>
 
 #if defined(_WIN32)
 #include <Windows.h>
@@ -136,6 +138,227 @@ namespace core
 		}
 	}
 
+	//======== ======== ======== console_out_buffered ======== ======== ========
+
+	console_out_buffered::console_out_buffered(console_out const& p_out, uintptr_t const p_flush_size, bool const p_line_flush, uint32_t const p_flush_interval)
+		: m_out(p_out)
+		, m_flush_size(p_flush_size ? p_flush_size : 1)
+		, m_flush_interval(p_flush_interval)
+		, m_line_flush(p_line_flush)
+	{
+		m_front.resize(m_flush_size);
+	}
+
+	console_out_buffered::~console_out_buffered()
+	{
+		stop_writer();
+		flush();
+	}
+
+	std::errc console_out_buffered::start_writer()
+	{
+		if(m_has_writer) return std::errc{};
+
+		m_stop.store(false, std::memory_order::relaxed);
+		m_trap.reset();
+		m_has_writer = true;
+		if(m_thread.create(this, &console_out_buffered::writer, nullptr) != thread::Error::None)
+		{
+			m_has_writer = false;
+			return std::errc::resource_unavailable_try_again;
+		}
+		return std::errc{};
+	}
+
+	void console_out_buffered::stop_writer()
+	{
+		if(!m_has_writer) return;
+
+		flush();
+		m_stop.store(true, std::memory_order::release);
+		m_trap.signal();
+		m_thread.join();
+		m_has_writer = false;
+	}
+
+	void console_out_buffered::flush()
+	{
+		atomic_spinlock::scope_locker const lock(m_lock);
+		flush_locked();
+		while(m_back_busy.load(std::memory_order::acquire))
+		{
+			thread_yield();
+		}
+	}
+
+	void console_out_buffered::flush_locked()
+	{
+		if(!m_used) return;
+
+		if(m_has_writer)
+		{
+			while(m_back_busy.load(std::memory_order::acquire))
+			{
+				thread_yield();
+			}
+			std::swap(m_front, m_back);
+			m_back_used = m_used;
+			m_used = 0;
+			if(m_front.size() < m_flush_size)
+			{
+				m_front.resize(m_flush_size);
+			}
+			m_back_busy.store(true, std::memory_order::release);
+			m_trap.signal();
+		}
+		else
+		{
+			m_out.write(std::u8string_view{m_front.data(), m_used});
+			m_used = 0;
+		}
+	}
+
+	char8_t* console_out_buffered::buffer_acquire(uintptr_t const p_size)
+	{
+		m_lock.lock();
+		if(p_size > m_front.size() - m_used)
+		{
+			flush_locked();
+			if(p_size > m_front.size())
+			{
+				m_front.resize(p_size);
+			}
+		}
+		return m_front.data() + m_used;
+	}
+
+	void console_out_buffered::buffer_released(char8_t* const p_buff, uintptr_t const p_size)
+	{
+		bool const was_empty = (m_used == 0);
+		m_used += p_size;
+
+		if(m_used >= m_flush_size || (m_line_flush && p_size && memchr(p_buff, '\n', p_size)))
+		{
+			flush_locked();
+		}
+		else if(m_flush_interval && p_size)
+		{
+			clock_t::time_point const now = clock_t::now();
+			if(was_empty)
+			{
+				m_pending_since = now;
+			}
+			else if(!m_has_writer && now - m_pending_since >= std::chrono::milliseconds{m_flush_interval})
+			{
+				flush_locked();
+			}
+		}
+		m_lock.unlock();
+	}
+
+	void console_out_buffered::write(std::string_view const p_out)
+	{
+		write(std::u8string_view{reinterpret_cast<char8_t const*>(p_out.data()), p_out.size()});
+	}
+
+	void console_out_buffered::write(std::wstring_view const p_out)
+	{
+		write(std::basic_string_view<wchar_alias>{reinterpret_cast<wchar_alias const*>(p_out.data()), p_out.size()});
+	}
+
+	void console_out_buffered::write(std::u8string_view const p_out)
+	{
+		char8_t* const buff = buffer_acquire(p_out.size());
+		memcpy(buff, p_out.data(), p_out.size());
+		buffer_released(buff, p_out.size());
+	}
+
+	void console_out_buffered::write(std::u16string_view const p_out)
+	{
+		uintptr_t const buff_size = UTF16_to_UTF8_faulty_size(p_out, '?');
+		char8_t* const buff = buffer_acquire(buff_size);
+		UTF16_to_UTF8_faulty_unsafe(p_out, '?', buff);
+		buffer_released(buff, buff_size);
+	}
+
+	void console_out_buffered::write(std::u32string_view const p_out)
+	{
+		uintptr_t const buff_size = UCS4_to_UTF8_faulty_size(p_out, '?');
+		char8_t* const buff = buffer_acquire(buff_size);
+		UCS4_to_UTF8_faulty_unsafe(p_out, '?', buff);
+		buffer_released(buff, buff_size);
+	}
+
+	void console_out_buffered::put(char const p_out)
+	{
+		put(static_cast<char8_t>(p_out));
+	}
+
+	void console_out_buffered::put(wchar_t const p_out)
+	{
+		put(static_cast<wchar_alias>(p_out));
+	}
+
+	void console_out_buffered::put(char8_t const p_out)
+	{
+		char8_t* const buff = buffer_acquire(1);
+		*buff = p_out;
+		buffer_released(buff, 1);
+	}
+
+	void console_out_buffered::put(char16_t const p_out)
+	{
+		put(static_cast<char32_t>(p_out));
+	}
+
+	void console_out_buffered::put(char32_t const p_out)
+	{
+		std::array<char8_t, 4> buff;
+		uint8_t const size = encode_UTF8(p_out, buff);
+		if(size)
+		{
+			write(std::u8string_view{buff.data(), size});
+		}
+		else
+		{
+			put(u8'?');
+		}
+	}
+
+	void console_out_buffered::writer(void*)
+	{
+		while(true)
+		{
+			if(m_flush_interval)
+			{
+				m_trap.timed_wait(m_flush_interval);
+			}
+			else
+			{
+				m_trap.wait();
+			}
+			m_trap.reset();
+
+			//the printing thread may be holding the lock while waiting on the back buffer, so never block on it
+			if(m_flush_interval && !m_back_busy.load(std::memory_order::acquire) && m_lock.try_lock())
+			{
+				if(m_used && clock_t::now() - m_pending_since >= std::chrono::milliseconds{m_flush_interval})
+				{
+					flush_locked();
+				}
+				m_lock.unlock();
+			}
+
+			if(m_back_busy.load(std::memory_order::acquire))
+			{
+				m_out.write(std::u8string_view{m_back.data(), m_back_used});
+				m_back_busy.store(false, std::memory_order::release);
+			}
+
+			if(m_stop.load(std::memory_order::acquire)) break;
+		}
+	}
+
 } //namespace core
 
 
@@ -27,9 +27,11 @@
 
 #include <CoreLib/core_cpu.hpp>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <cstdint>
+#include <vector>
 
 #include <CoreLib/core_type.hpp>
 
@@ -181,6 +183,9 @@ namespace core
 			bool m_AVX512_FP16			= false;
 			bool m_AMX_TILE				= false;
 			bool m_AMX_INT8				= false;
+
+			bool m_RDTSCP				= false;
+			bool m_TSC_invariant		= false;
 		};
 
 		static CPU_Data get_cpu_features()
@@ -316,18 +321,25 @@ namespace core
 			}
 
 			// ---- Extra data ----
-			//{
-			//	get_cpu_id(reg, 0x80000000_ui32);
-			//	uint32_t const maxId = reg.eax;
-			//
-			//	if(maxId > 0x80000000_ui32)
-			//	{
-			//
-			//		if(maxId > 0x80000003_ui32)
-			//		{
-			//		}
-			//	}
-			//}
+			{
+				EX_Reg reg;
+				cpu_id(reg, 0x80000000_ui32);
+				uint32_t const maxId = reg.eax;
+
+				if(maxId >= 0x80000001_ui32)
+				{
+					cpu_id(reg, 0x80000001_ui32);
+					std::bitset<32> const data = reg.edx;
+					outp.m_RDTSCP = data[27];
+				}
+
+				if(maxId >= 0x80000007_ui32)
+				{
+					cpu_id(reg, 0x80000007_ui32);
+					std::bitset<32> const data = reg.edx;
+					outp.m_TSC_invariant = data[8];
+				}
+			}
 			return outp;
 		}
 
@@ -435,6 +447,9 @@ namespace core
 	bool CPU_feature_g::AMX_TILE			() { return g_cpu_data.m_AMX_TILE			; }
 	bool CPU_feature_g::AMX_INT8			() { return g_cpu_data.m_AMX_INT8			; }
 
+	bool CPU_feature_g::RDTSCP				() { return g_cpu_data.m_RDTSCP				; }
+	bool CPU_feature_g::TSC_invariant		() { return g_cpu_data.m_TSC_invariant		; }
+
 
 	EX_Reg CPU_feature_g::Fn0		() { return g_cpu_data.m_Fn0; }
 	EX_Reg CPU_feature_g::Fn1		() { return g_cpu_data.m_Fn1; }
@@ -444,13 +459,21 @@ namespace core
 
 
 
-	template<uint32_t Fn, uint8_t Register, uint8_t Offset> requires ((Fn == 1 || Fn == 7) && (Register < 4) && (Offset < 32))
+	template<uint32_t Fn, uint8_t Register, uint8_t Offset> requires ((Fn == 1 || Fn == 7 || Fn == 0x80000001_ui32 || Fn == 0x80000007_ui32) && (Register < 4) && (Offset < 32))
 	static inline bool help_fecth_single_cpu_id_bit()
 	{
 		EX_Reg reg;
-		cpu_id(reg, 0);
+		cpu_id(reg, Fn < 0x80000000_ui32 ? 0 : 0x80000000_ui32);
 
-		if constexpr (Fn == 1)
+		if constexpr (Fn >= 0x80000000_ui32)
+		{
+			if(reg.eax < Fn)
+			{
+				return false;
+			}
+			cpu_id(reg, Fn);
+		}
+		else if constexpr (Fn == 1)
 		{
 			if(reg.eax < 1)
 			{
@@ -510,26 +533,26 @@ namespace core
 		return 0;
 	}
 
-	bool CPU_feature_su::SSE3			() { return help_fecth_single_cpu_id_bit<1, 1,  0>(); }
-	bool CPU_feature_su::PCLMULQDQ		() { return help_fecth_single_cpu_id_bit<1, 1,  1>(); }
-	bool CPU_feature_su::MONITOR		() { return help_fecth_single_cpu_id_bit<1, 1,  3>(); }
-	bool CPU_feature_su::VMX			() { return help_fecth_single_cpu_id_bit<1, 1,  5>(); }
-	bool CPU_feature_su::SMX			() { return help_fecth_single_cpu_id_bit<1, 1,  6>(); }
-	bool CPU_feature_su::SSSE3			() { return help_fecth_single_cpu_id_bit<1, 1,  9>(); }
-	bool CPU_feature_su::FMA			() { return help_fecth_single_cpu_id_bit<1, 1, 12>(); }
-	bool CPU_feature_su::CMPXCHG16B		() { return help_fecth_single_cpu_id_bit<1, 1, 13>(); }
-	bool CPU_feature_su::PCID			() { return help_fecth_single_cpu_id_bit<1, 1, 17>(); }
-	bool CPU_feature_su::SSE41			() { return help_fecth_single_cpu_id_bit<1, 1, 19>(); }
-	bool CPU_feature_su::SSE42			() { return help_fecth_single_cpu_id_bit<1, 1, 20>(); }
-	bool CPU_feature_su::X2APIC			() { return help_fecth_single_cpu_id_bit<1, 1, 21>(); }
-	bool CPU_feature_su::MOVBE			() { return help_fecth_single_cpu_id_bit<1, 1, 22>(); }
-	bool CPU_feature_su::POPCNT			() { return help_fecth_single_cpu_id_bit<1, 1, 23>(); }
-	bool CPU_feature_su::AES			() { return help_fecth_single_cpu_id_bit<1, 1, 25>(); }
-	bool CPU_feature_su::XSAVE			() { return help_fecth_single_cpu_id_bit<1, 1, 26>(); }
-	bool CPU_feature_su::OSXSAVE		() { return help_fecth_single_cpu_id_bit<1, 1, 27>(); }
-	bool CPU_feature_su::AVX			() { return help_fecth_single_cpu_id_bit<1, 1, 28>(); }
-	bool CPU_feature_su::F16C			() { return help_fecth_single_cpu_id_bit<1, 1, 29>(); }
-	bool CPU_feature_su::RDRAND			() { return help_fecth_single_cpu_id_bit<1, 1, 30>(); }
+	bool CPU_feature_su::SSE3			() { return help_fecth_single_cpu_id_bit<1, 2,  0>(); }
+	bool CPU_feature_su::PCLMULQDQ		() { return help_fecth_single_cpu_id_bit<1, 2,  1>(); }
+	bool CPU_feature_su::MONITOR		() { return help_fecth_single_cpu_id_bit<1, 2,  3>(); }
+	bool CPU_feature_su::VMX			() { return help_fecth_single_cpu_id_bit<1, 2,  5>(); }
+	bool CPU_feature_su::SMX			() { return help_fecth_single_cpu_id_bit<1, 2,  6>(); }
+	bool CPU_feature_su::SSSE3			() { return help_fecth_single_cpu_id_bit<1, 2,  9>(); }
+	bool CPU_feature_su::FMA			() { return help_fecth_single_cpu_id_bit<1, 2, 12>(); }
+	bool CPU_feature_su::CMPXCHG16B		() { return help_fecth_single_cpu_id_bit<1, 2, 13>(); }
+	bool CPU_feature_su::PCID			() { return help_fecth_single_cpu_id_bit<1, 2, 17>(); }
+	bool CPU_feature_su::SSE41			() { return help_fecth_single_cpu_id_bit<1, 2, 19>(); }
+	bool CPU_feature_su::SSE42			() { return help_fecth_single_cpu_id_bit<1, 2, 20>(); }
+	bool CPU_feature_su::X2APIC			() { return help_fecth_single_cpu_id_bit<1, 2, 21>(); }
+	bool CPU_feature_su::MOVBE			() { return help_fecth_single_cpu_id_bit<1, 2, 22>(); }
+	bool CPU_feature_su::POPCNT			() { return help_fecth_single_cpu_id_bit<1, 2, 23>(); }
+	bool CPU_feature_su::AES			() { return help_fecth_single_cpu_id_bit<1, 2, 25>(); }
+	bool CPU_feature_su::XSAVE			() { return help_fecth_single_cpu_id_bit<1, 2, 26>(); }
+	bool CPU_feature_su::OSXSAVE		() { return help_fecth_single_cpu_id_bit<1, 2, 27>(); }
+	bool CPU_feature_su::AVX			() { return help_fecth_single_cpu_id_bit<1, 2, 28>(); }
+	bool CPU_feature_su::F16C			() { return help_fecth_single_cpu_id_bit<1, 2, 29>(); }
+	bool CPU_feature_su::RDRAND			() { return help_fecth_single_cpu_id_bit<1, 2, 30>(); }
 
 	bool CPU_feature_su::FPU			() { return help_fecth_single_cpu_id_bit<1, 3,  0>(); }
 	bool CPU_feature_su::VME			() { return help_fecth_single_cpu_id_bit<1, 3,  1>(); }
@@ -610,6 +633,9 @@ namespace core
 	bool CPU_feature_su::AMX_TILE			() { return help_fecth_single_cpu_id_bit<7, 3, 24>(); }
 	bool CPU_feature_su::AMX_INT8			() { return help_fecth_single_cpu_id_bit<7, 3, 25>(); }
 
+	bool CPU_feature_su::RDTSCP				() { return help_fecth_single_cpu_id_bit<0x80000001_ui32, 3, 27>(); }
+	bool CPU_feature_su::TSC_invariant		() { return help_fecth_single_cpu_id_bit<0x80000007_ui32, 3,  8>(); }
+
 	EX_Reg CPU_feature_su::Fn0()
 	{
 		EX_Reg reg;
@@ -643,6 +669,236 @@ namespace core
 		return reg;
 	}
 
+	namespace
+	{
+		static constexpr uint32_t vendor_amd	= 0x68747541_ui32; //"Auth"enticAMD
+		static constexpr uint32_t vendor_hygon	= 0x6F677948_ui32; //"Hygo"nGenuine
+
+		//CPUID leaf 4 and 0x8000001D share the same layout
+		static void query_caches(std::vector<cache_info>& p_out, uint32_t const p_leaf)
+		{
+			for(uint32_t subleaf = 0; subleaf < 32; ++subleaf)
+			{
+				EX_Reg reg;
+				cpu_id_ex(reg, p_leaf, subleaf);
+				uint8_t const type = static_cast<uint8_t>(reg.eax & 0x1F);
+				if(type == 0) break;
+				if(type > 3) continue;
+
+				cache_info info;
+				info.level				= static_cast<uint8_t>((reg.eax >> 5) & 0x07);
+				info.type				= static_cast<cache_type>(type);
+				info.fully_associative	= (reg.eax >> 9) & 1;
+				info.shared_by			= static_cast<uint16_t>(((reg.eax >> 14) & 0x0FFF) + 1);
+				info.line_size			= static_cast<uint16_t>((reg.ebx & 0x0FFF) + 1);
+				info.partitions			= static_cast<uint16_t>(((reg.ebx >> 12) & 0x03FF) + 1);
+				info.ways				= static_cast<uint16_t>((reg.ebx >> 22) + 1);
+				info.sets				= reg.ecx + 1;
+				info.inclusive			= (reg.edx >> 1) & 1;
+				info.size				= uint64_t{info.ways} * info.partitions * info.line_size * info.sets;
+				p_out.push_back(info);
+			}
+		}
+
+		static void query_tlbs_intel(std::vector<tlb_info>& p_out)
+		{
+			EX_Reg reg;
+			cpu_id_ex(reg, 0x18, 0);
+			uint32_t const max_subleaf = reg.eax;
+
+			for(uint32_t subleaf = 0; subleaf <= max_subleaf && subleaf < 64; ++subleaf)
+			{
+				if(subleaf) cpu_id_ex(reg, 0x18, subleaf);
+				uint8_t const type = static_cast<uint8_t>(reg.edx & 0x1F);
+				if(type == 0 || type > 5) continue;
+
+				tlb_info info;
+				info.level				= static_cast<uint8_t>((reg.edx >> 5) & 0x07);
+				info.type				= static_cast<tlb_type>(type);
+				info.fully_associative	= (reg.edx >> 8) & 1;
+				info.shared_by			= static_cast<uint16_t>(((reg.edx >> 14) & 0x0FFF) + 1);
+				info.page_sizes			= static_cast<uint8_t>(reg.ebx & 0x0F);
+				info.ways				= static_cast<uint16_t>(reg.ebx >> 16);
+				info.entries			= info.ways * reg.ecx;
+				p_out.push_back(info);
+			}
+		}
+
+		static void add_amd_tlb(std::vector<tlb_info>& p_out, uint8_t const p_level, tlb_type const p_type, uint8_t const p_pages, uint32_t const p_entries, uint16_t const p_ways, bool const p_fully)
+		{
+			if(p_entries == 0 || (p_ways == 0 && !p_fully)) return;
+
+			tlb_info info;
+			info.entries			= p_entries;
+			info.ways				= p_fully ? static_cast<uint16_t>(p_entries) : p_ways;
+			info.shared_by			= 0;
+			info.level				= p_level;
+			info.type				= p_type;
+			info.page_sizes			= p_pages;
+			info.fully_associative	= p_fully;
+			p_out.push_back(info);
+		}
+
+		//packed 8 bit entries and associativity, as used by CPUID 0x80000005, 0xFF is fully associative
+		static void add_amd_tlb_l1(std::vector<tlb_info>& p_out, uint8_t const p_pages, uint32_t const p_reg)
+		{
+			uint16_t const dways = static_cast<uint16_t>(p_reg >> 24);
+			uint16_t const iways = static_cast<uint16_t>((p_reg >> 8) & 0xFF);
+			add_amd_tlb(p_out, 1, tlb_type::data		, p_pages, (p_reg >> 16) & 0xFF, dways, dways == 0xFF);
+			add_amd_tlb(p_out, 1, tlb_type::instruction	, p_pages,  p_reg        & 0xFF, iways, iways == 0xFF);
+		}
+
+		//4 bit associativity encoding of CPUID 0x80000006 and 0x80000019, 0xFFFF is fully associative
+		static constexpr std::array<uint16_t, 16> amd_l2_ways
+		{
+			0, 1, 2, 3, 4, 6, 8, 0, 16, 0, 32, 48, 64, 96, 128, 0xFFFF
+		};
+
+		//packed 12 bit entries and 4 bit associativity, as used by CPUID 0x80000006 and 0x80000019
+		static void add_amd_tlb_l2(std::vector<tlb_info>& p_out, uint8_t const p_level, uint8_t const p_pages, uint32_t const p_reg)
+		{
+			uint16_t const dways = amd_l2_ways[p_reg >> 28];
+			uint16_t const iways = amd_l2_ways[(p_reg >> 12) & 0x0F];
+			add_amd_tlb(p_out, p_level, tlb_type::data		, p_pages, (p_reg >> 16) & 0x0FFF, dways, dways == 0xFFFF);
+			add_amd_tlb(p_out, p_level, tlb_type::instruction	, p_pages,  p_reg        & 0x0FFF, iways, iways == 0xFFFF);
+		}
+
+		static void query_tlbs_amd(std::vector<tlb_info>& p_out, uint32_t const p_maxExtId)
+		{
+			constexpr uint8_t pages_large = tlb_page::size_2M | tlb_page::size_4M;
+			EX_Reg reg;
+
+			if(p_maxExtId >= 0x80000005_ui32)
+			{
+				cpu_id(reg, 0x80000005_ui32);
+				add_amd_tlb_l1(p_out, tlb_page::size_4K, reg.ebx);
+				add_amd_tlb_l1(p_out, pages_large, reg.eax);
+			}
+
+			if(p_maxExtId >= 0x80000006_ui32)
+			{
+				cpu_id(reg, 0x80000006_ui32);
+				add_amd_tlb_l2(p_out, 2, tlb_page::size_4K, reg.ebx);
+				add_amd_tlb_l2(p_out, 2, pages_large, reg.eax);
+			}
+
+			if(p_maxExtId >= 0x80000019_ui32)
+			{
+				cpu_id(reg, 0x80000019_ui32);
+				add_amd_tlb_l2(p_out, 1, tlb_page::size_1G, reg.eax);
+				add_amd_tlb_l2(p_out, 2, tlb_page::size_1G, reg.ebx);
+			}
+		}
+	} //namespace
+
+	cache_info const* cpu_topology::data_cache(uint8_t const p_level) const
+	{
+		for(cache_info const& info: caches)
+		{
+			if(info.level == p_level && info.type != cache_type::instruction)
+			{
+				return &info;
+			}
+		}
+		return nullptr;
+	}
+
+	uint16_t cpu_topology::line_size() const
+	{
+		cache_info const* const l1 = data_cache(1);
+		return l1 ? l1->line_size : uint16_t{64};
+	}
+
+	uint64_t cpu_topology::last_level_size() const
+	{
+		return caches.empty() ? 0 : caches.back().size;
+	}
+
+	cpu_topology query_cpu_topology()
+	{
+		cpu_topology outp;
+
+		EX_Reg reg;
+		cpu_id(reg, 0);
+		uint32_t const maxId = reg.eax;
+		bool const amd = (reg.ebx == vendor_amd || reg.ebx == vendor_hygon);
+
+		cpu_id(reg, 0x80000000_ui32);
+		uint32_t const maxExtId = reg.eax;
+
+		if(amd)
+		{
+			bool topology_extensions = false;
+			if(maxExtId >= 0x80000001_ui32)
+			{
+				cpu_id(reg, 0x80000001_ui32);
+				topology_extensions = (reg.ecx >> 22) & 1;
+			}
+			if(topology_extensions && maxExtId >= 0x8000001D_ui32)
+			{
+				query_caches(outp.caches, 0x8000001D_ui32);
+			}
+			query_tlbs_amd(outp.tlbs, maxExtId);
+		}
+		else
+		{
+			if(maxId >= 4)
+			{
+				query_caches(outp.caches, 4);
+			}
+			if(maxId >= 0x18)
+			{
+				query_tlbs_intel(outp.tlbs);
+			}
+		}
+
+		if(maxId >= 7)
+		{
+			cpu_id_ex(reg, 7, 0);
+			outp.hybrid = (reg.edx >> 15) & 1;
+		}
+
+		if(outp.hybrid && maxId >= 0x1A)
+		{
+			cpu_id_ex(reg, 0x1A, 0);
+			outp.core = static_cast<core_type>(reg.eax >> 24);
+			outp.native_model = reg.eax & 0x00FFFFFF;
+		}
+
+		std::stable_sort(outp.caches.begin(), outp.caches.end(),
+			[](cache_info const& p_1, cache_info const& p_2)
+			{
+				return p_1.level < p_2.level || (p_1.level == p_2.level && p_1.type < p_2.type);
+			});
+
+		std::stable_sort(outp.tlbs.begin(), outp.tlbs.end(),
+			[](tlb_info const& p_1, tlb_info const& p_2)
+			{
+				return p_1.level < p_2.level || (p_1.level == p_2.level && p_1.type < p_2.type);
+			});
+
+		return outp;
+	}
+
+	cpu_topology const& cpu_topology_g()
+	{
+		static cpu_topology const topology = query_cpu_topology();
+		return topology;
+	}
+
+	core_type current_core_type()
+	{
+		EX_Reg reg;
+		cpu_id(reg, 0);
+		if(reg.eax < 0x1A) return core_type::unknown;
+
+		cpu_id_ex(reg, 7, 0);
+		if(!((reg.edx >> 15) & 1)) return core_type::unknown;
+
+		cpu_id_ex(reg, 0x1A, 0);
+		return static_cast<core_type>(reg.eax >> 24);
+	}
+
 } //namespace amd64
 
 #endif
@@ -0,0 +1,184 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <CoreLib/core_cpu_dispatch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <CoreLib/core_os.hpp>
+
+#if defined(_M_AMD64) || defined(__amd64__)
+#	include <CoreLib/core_cpu.hpp>
+#	if defined(_WIN32)
+#		include <intrin.h>
+#	endif
+#endif
+
+namespace core
+{
+	namespace
+	{
+		static constexpr std::array<std::u8string_view, isa_level_count> g_isa_names
+		{
+			u8"scalar",
+			u8"sse4.2",
+			u8"avx2",
+			u8"avx512",
+		};
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		//XCR0 state components that the OS must save for each tier
+		static constexpr uint64_t xcr0_ymm = 0x06; //SSE, AVX
+		static constexpr uint64_t xcr0_zmm = 0xE6; //SSE, AVX, opmask, ZMM_Hi256, Hi16_ZMM
+
+		static uint64_t xcr0()
+		{
+#	if defined(_WIN32)
+			return _xgetbv(0);
+#	else
+			uint32_t low;
+			uint32_t high;
+			__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+			return (static_cast<uint64_t>(high) << 32) | low;
+#	endif
+		}
+
+		static isa_level detect_isa_level()
+		{
+			using feature = amd64::CPU_feature_su;
+
+			if(!(feature::SSSE3() && feature::SSE41() && feature::SSE42() && feature::POPCNT()))
+			{
+				return isa_level::scalar;
+			}
+
+			if(!(feature::OSXSAVE() && feature::AVX() && feature::AVX2() && feature::BMI1() && feature::BMI2() && feature::FMA()))
+			{
+				return isa_level::sse4_2;
+			}
+
+			uint64_t const xcr = xcr0();
+			if((xcr & xcr0_ymm) != xcr0_ymm)
+			{
+				return isa_level::sse4_2;
+			}
+
+			if(!(feature::AVX512F() && feature::AVX512BW() && feature::AVX512DQ() && feature::AVX512CD() && feature::AVX512VL())
+				|| (xcr & xcr0_zmm) != xcr0_zmm)
+			{
+				return isa_level::avx2;
+			}
+
+			return isa_level::avx512;
+		}
+#else
+		static isa_level detect_isa_level()
+		{
+			return isa_level::scalar;
+		}
+#endif
+
+		static isa_level resolve_active_level()
+		{
+			isa_level const supported = isa_level_supported();
+
+#if defined(_WIN32)
+			std::optional<os_string> const env = get_env(L"CORELIB_ISA");
+#else
+			std::optional<os_string> const env = get_env("CORELIB_ISA");
+#endif
+			if(!env.has_value())
+			{
+				return supported;
+			}
+
+			std::u8string name;
+			name.reserve(env.value().size());
+			for(os_char const tchar: env.value())
+			{
+				if(static_cast<uint32_t>(tchar) > 0x7F) return supported;
+				name.push_back(static_cast<char8_t>(tchar));
+			}
+
+			std::optional<isa_level> const requested = isa_level_from_name(name);
+			if(requested.has_value() && requested.value() < supported)
+			{
+				return requested.value();
+			}
+			return supported;
+		}
+	} //namespace
+
+	isa_level isa_level_supported()
+	{
+		static isa_level const level = detect_isa_level();
+		return level;
+	}
+
+	isa_level isa_level_active()
+	{
+		static isa_level const level = resolve_active_level();
+		return level;
+	}
+
+	std::u8string_view isa_level_name(isa_level const p_level)
+	{
+		uintptr_t const index = static_cast<uintptr_t>(p_level);
+		if(index < isa_level_count)
+		{
+			return g_isa_names[index];
+		}
+		return {};
+	}
+
+	std::optional<isa_level> isa_level_from_name(std::u8string_view const p_name)
+	{
+		for(uintptr_t index = 0; index < isa_level_count; ++index)
+		{
+			std::u8string_view const candidate = g_isa_names[index];
+			if(candidate.size() != p_name.size()) continue;
+
+			bool match = true;
+			for(uintptr_t pos = 0; pos < candidate.size(); ++pos)
+			{
+				char8_t tchar = p_name[pos];
+				if(tchar >= u8'A' && tchar <= u8'Z') tchar += (u8'a' - u8'A');
+				if(tchar != candidate[pos])
+				{
+					match = false;
+					break;
+				}
+			}
+			if(match) return static_cast<isa_level>(index);
+		}
+		return {};
+	}
+
+} //namespace core
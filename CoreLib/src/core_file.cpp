@@ -27,13 +27,19 @@
 
 #ifdef _WIN32
 #	include <io.h>
+#	include <Windows.h>
 #else
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif
 
 #include <CoreLib/core_file.hpp>
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <new>
 #include <fcntl.h>
 
 namespace core
@@ -229,6 +235,38 @@ namespace core
 			return p_handle ? _fwrite_nolock(p_buff, 1, p_size, reinterpret_cast<FILE*>(p_handle)) : 0;
 		}
 
+		static inline uintptr_t os_read_vector(void* const p_handle, std::span<std::span<uint8_t> const> const p_buffers)
+		{
+			if(!p_handle) return 0;
+			FILE* const stream = reinterpret_cast<FILE*>(p_handle);
+			uintptr_t done = 0;
+			_lock_file(stream);
+			for(std::span<uint8_t> const& buffer : p_buffers)
+			{
+				uintptr_t const res = _fread_nolock(buffer.data(), 1, buffer.size(), stream);
+				done += res;
+				if(res != buffer.size()) break;
+			}
+			_unlock_file(stream);
+			return done;
+		}
+
+		static inline uintptr_t os_write_vector(void* const p_handle, std::span<std::span<uint8_t const> const> const p_buffers)
+		{
+			if(!p_handle) return 0;
+			FILE* const stream = reinterpret_cast<FILE*>(p_handle);
+			uintptr_t done = 0;
+			_lock_file(stream);
+			for(std::span<uint8_t const> const& buffer : p_buffers)
+			{
+				uintptr_t const res = _fwrite_nolock(buffer.data(), 1, buffer.size(), stream);
+				done += res;
+				if(res != buffer.size()) break;
+			}
+			_unlock_file(stream);
+			return done;
+		}
+
 		static inline void os_flush(void* const p_handle)
 		{
 			if(p_handle) fflush(reinterpret_cast<FILE*>(p_handle));
@@ -418,6 +456,112 @@ namespace core
 			return (res == -1) ? 0 : static_cast<uintptr_t>(res);
 		}
 
+		//transfers a list of buffers in as few calls as possible, resuming after partial transfers
+		//p_op: ssize_t(iovec const*, int count, uintptr_t already_done)
+		template<typename buffer_t, typename op_t>
+		static uintptr_t os_vector_io(std::span<buffer_t const> const p_buffers, op_t const& p_op)
+		{
+			constexpr uintptr_t batch_size = 64;
+			iovec vec[batch_size];
+			uintptr_t done = 0;
+			uintptr_t index = 0;
+			uintptr_t skip = 0; //bytes already transferred from p_buffers[index]
+
+			while(index < p_buffers.size())
+			{
+				int count = 0;
+				for(uintptr_t i = index; i < p_buffers.size() && count < static_cast<int>(batch_size); ++i)
+				{
+					uintptr_t const start = (i == index) ? skip : 0;
+					if(p_buffers[i].size() == start) continue;
+					vec[count++] = iovec{const_cast<uint8_t*>(p_buffers[i].data()) + start, p_buffers[i].size() - start};
+				}
+				if(count == 0) break;
+
+				ssize_t const res = p_op(vec, count, done);
+				if(res <= 0)
+				{
+					if(res == -1 && errno == EINTR) continue;
+					break;
+				}
+				done += static_cast<uintptr_t>(res);
+
+				uintptr_t remaining = static_cast<uintptr_t>(res);
+				while(index < p_buffers.size())
+				{
+					uintptr_t const available = p_buffers[index].size() - skip;
+					if(remaining < available)
+					{
+						skip += remaining;
+						break;
+					}
+					remaining -= available;
+					++index;
+					skip = 0;
+				}
+			}
+			return done;
+		}
+
+		static inline uintptr_t os_read_offset_vector(void* const p_handle, std::span<std::span<uint8_t> const> const p_buffers, int64_t const p_offset)
+		{
+			if(!p_handle) return 0;
+			int const fd = fileno(reinterpret_cast<FILE*>(p_handle));
+			return os_vector_io(p_buffers,
+				[fd, p_offset](iovec const* const p_vec, int const p_count, uintptr_t const p_done)
+				{
+					return preadv64(fd, p_vec, p_count, p_offset + static_cast<int64_t>(p_done));
+				});
+		}
+
+		static inline uintptr_t os_write_offset_vector(void* const p_handle, std::span<std::span<uint8_t const> const> const p_buffers, int64_t const p_offset)
+		{
+			if(!p_handle) return 0;
+			int const fd = fileno(reinterpret_cast<FILE*>(p_handle));
+			return os_vector_io(p_buffers,
+				[fd, p_offset](iovec const* const p_vec, int const p_count, uintptr_t const p_done)
+				{
+					return pwritev64(fd, p_vec, p_count, p_offset + static_cast<int64_t>(p_done));
+				});
+		}
+
+		//the stream buffer is flushed and the transfer done directly at the stream position,
+		//which is then moved past the transferred data
+		static inline uintptr_t os_read_vector(void* const p_handle, std::span<std::span<uint8_t> const> const p_buffers)
+		{
+			if(!p_handle) return 0;
+			FILE* const stream = reinterpret_cast<FILE*>(p_handle);
+			uintptr_t done = 0;
+			flockfile(stream);
+			off64_t const pos = ftello64(stream);
+			if(pos != -1 && fflush_unlocked(stream) == 0)
+			{
+				done = os_read_offset_vector(p_handle, p_buffers, pos);
+				fseeko64(stream, pos + static_cast<off64_t>(done), SEEK_SET);
+			}
+			funlockfile(stream);
+			return done;
+		}
+
+		static inline uintptr_t os_write_vector(void* const p_handle, std::span<std::span<uint8_t const> const> const p_buffers)
+		{
+			if(!p_handle) return 0;
+			FILE* const stream = reinterpret_cast<FILE*>(p_handle);
+			uintptr_t done = 0;
+			flockfile(stream);
+			if(fflush_unlocked(stream) == 0)
+			{
+				off64_t const pos = ftello64(stream);
+				if(pos != -1)
+				{
+					done = os_write_offset_vector(p_handle, p_buffers, pos);
+					fseeko64(stream, pos + static_cast<off64_t>(done), SEEK_SET);
+				}
+			}
+			funlockfile(stream);
+			return done;
+		}
+
 		static inline void os_flush(void* const p_handle)
 		{
 			if(p_handle) fflush(reinterpret_cast<FILE*>(p_handle));
@@ -449,6 +593,7 @@ namespace core
 				os_close(m_handle);
 				m_handle = nullptr;
 			}
+			m_buffer.reset();
 		}
 
 		int64_t file_base::pos() const
@@ -506,6 +651,23 @@ namespace core
 			os_unlock_file(m_handle);
 		}
 
+		std::errc file_base::set_buffer_size(uintptr_t const p_size)
+		{
+			if(!m_handle) return std::errc::bad_file_descriptor;
+			FILE* const fd = reinterpret_cast<FILE*>(m_handle);
+			if(p_size == 0)
+			{
+				if(setvbuf(fd, nullptr, _IONBF, 0)) return std::errc::invalid_argument;
+				m_buffer.reset();
+				return std::errc{};
+			}
+
+			std::unique_ptr<char[]> buffer{new char[p_size]};
+			if(setvbuf(fd, buffer.get(), _IOFBF, p_size)) return std::errc::invalid_argument;
+			m_buffer = std::move(buffer);
+			return std::errc{};
+		}
+
 #ifdef _WIN32
 		void file_base::close_unlocked()
 		{
@@ -514,6 +676,7 @@ namespace core
 				os_close_unlocked(m_handle);
 				m_handle = nullptr;
 			}
+			m_buffer.reset();
 		}
 
 		int64_t file_base::pos_unlocked() const
@@ -584,11 +747,21 @@ namespace core
 		return os_read_unlocked(m_handle, p_buff, p_size);
 	}
 
+	uintptr_t file_read::read(std::span<std::span<uint8_t> const> const p_buffers)
+	{
+		return os_read_vector(m_handle, p_buffers);
+	}
+
 #ifndef _WIN32
 	uintptr_t file_read::read_offset(void* const p_buff, uintptr_t const p_size, int64_t const p_offset)
 	{
 		return os_read_offset(m_handle, p_buff, p_size, p_offset);
 	}
+
+	uintptr_t file_read::read_offset(std::span<std::span<uint8_t> const> const p_buffers, int64_t const p_offset)
+	{
+		return os_read_offset_vector(m_handle, p_buffers, p_offset);
+	}
 #endif
 
 
@@ -611,6 +784,11 @@ namespace core
 		return os_write(m_handle, p_buff, p_size);
 	}
 
+	uintptr_t file_write::write(std::span<std::span<uint8_t const> const> const p_buffers)
+	{
+		return os_write_vector(m_handle, p_buffers);
+	}
+
 	void file_write::flush()
 	{
 		os_flush(m_handle);
@@ -636,6 +814,11 @@ namespace core
 	{
 		return os_write_offset(m_handle, p_buff, p_size, p_offset);
 	}
+
+	uintptr_t file_write::write_offset(std::span<std::span<uint8_t const> const> const p_buffers, int64_t const p_offset)
+	{
+		return os_write_offset_vector(m_handle, p_buffers, p_offset);
+	}
 #endif
 
 	std::errc file_duplex::open(std::filesystem::path const& p_path, open_mode const p_mode, bool const p_create_directories)
@@ -662,6 +845,16 @@ namespace core
 		return os_write(m_handle, p_buff, p_size);
 	}
 
+	uintptr_t file_duplex::read(std::span<std::span<uint8_t> const> const p_buffers)
+	{
+		return os_read_vector(m_handle, p_buffers);
+	}
+
+	uintptr_t file_duplex::write(std::span<std::span<uint8_t const> const> const p_buffers)
+	{
+		return os_write_vector(m_handle, p_buffers);
+	}
+
 	void file_duplex::flush()
 	{
 		os_flush(m_handle);
@@ -698,5 +891,873 @@ namespace core
 	{
 		return os_write_offset(m_handle, p_buff, p_size, p_offset);
 	}
+
+	uintptr_t file_duplex::read_offset(std::span<std::span<uint8_t> const> const p_buffers, int64_t const p_offset)
+	{
+		return os_read_offset_vector(m_handle, p_buffers, p_offset);
+	}
+
+	uintptr_t file_duplex::write_offset(std::span<std::span<uint8_t const> const> const p_buffers, int64_t const p_offset)
+	{
+		return os_write_offset_vector(m_handle, p_buffers, p_offset);
+	}
+#endif
+
+#ifndef _WIN32
+	//======== ======== ======== raw ======== ======== ========
+
+	namespace
+	{
+		static inline int os_raw_open(std::filesystem::path const& p_path, int const p_access, _p::file_base::open_mode const p_mode)
+		{
+			int flags;
+			switch(p_mode)
+			{
+			case _p::file_base::open_mode::create:
+				flags = O_CREAT | O_TRUNC;
+				break;
+			case _p::file_base::open_mode::crete_if_new:
+				flags = O_CREAT | O_EXCL;
+				break;
+			case _p::file_base::open_mode::open_or_create:
+				flags = O_CREAT;
+				break;
+			case _p::file_base::open_mode::open_existing:
+				flags = 0;
+				break;
+			default:
+				errno = EINVAL;
+				return -1;
+			}
+			return open64(p_path.native().c_str(), p_access | flags | fixed_flags, fixed_permissions);
+		}
+
+		static inline uintptr_t os_raw_read(int const p_fd, void* const p_buff, uintptr_t const p_size)
+		{
+			uintptr_t done = 0;
+			while(done < p_size)
+			{
+				ssize_t const res = read(p_fd, reinterpret_cast<uint8_t*>(p_buff) + done, p_size - done);
+				if(res <= 0)
+				{
+					if(res == -1 && errno == EINTR) continue;
+					break;
+				}
+				done += static_cast<uintptr_t>(res);
+			}
+			return done;
+		}
+
+		static inline uintptr_t os_raw_read_offset(int const p_fd, void* const p_buff, uintptr_t const p_size, int64_t const p_offset)
+		{
+			uintptr_t done = 0;
+			while(done < p_size)
+			{
+				ssize_t const res = pread64(p_fd, reinterpret_cast<uint8_t*>(p_buff) + done, p_size - done, p_offset + static_cast<int64_t>(done));
+				if(res <= 0)
+				{
+					if(res == -1 && errno == EINTR) continue;
+					break;
+				}
+				done += static_cast<uintptr_t>(res);
+			}
+			return done;
+		}
+
+		static inline std::errc os_raw_read_offset_nowait(int const p_fd, void* const p_buff, uintptr_t const p_size, int64_t const p_offset, uintptr_t& p_read)
+		{
+			p_read = 0;
+			if(p_fd == -1) return std::errc::bad_file_descriptor;
+#ifdef RWF_NOWAIT
+			iovec vec{p_buff, p_size};
+			ssize_t res;
+			do
+			{
+				res = preadv2(p_fd, &vec, 1, p_offset, RWF_NOWAIT);
+			}
+			while(res == -1 && errno == EINTR);
+
+			if(res == -1)
+			{
+				return (errno == EOPNOTSUPP || errno == ENOSYS) ? std::errc::not_supported : std::errc{errno};
+			}
+			p_read = static_cast<uintptr_t>(res);
+			return std::errc{};
+#else
+			static_cast<void>(p_buff);
+			static_cast<void>(p_size);
+			static_cast<void>(p_offset);
+			return std::errc::not_supported;
+#endif
+		}
+
+		static inline uintptr_t os_raw_write(int const p_fd, void const* const p_buff, uintptr_t const p_size)
+		{
+			uintptr_t done = 0;
+			while(done < p_size)
+			{
+				ssize_t const res = write(p_fd, reinterpret_cast<uint8_t const*>(p_buff) + done, p_size - done);
+				if(res <= 0)
+				{
+					if(res == -1 && errno == EINTR) continue;
+					break;
+				}
+				done += static_cast<uintptr_t>(res);
+			}
+			return done;
+		}
+
+		static inline uintptr_t os_raw_write_offset(int const p_fd, void const* const p_buff, uintptr_t const p_size, int64_t const p_offset)
+		{
+			uintptr_t done = 0;
+			while(done < p_size)
+			{
+				ssize_t const res = pwrite64(p_fd, reinterpret_cast<uint8_t const*>(p_buff) + done, p_size - done, p_offset + static_cast<int64_t>(done));
+				if(res <= 0)
+				{
+					if(res == -1 && errno == EINTR) continue;
+					break;
+				}
+				done += static_cast<uintptr_t>(res);
+			}
+			return done;
+		}
+
+		static inline std::errc os_raw_seek(int const p_fd, int64_t const p_pos, int const p_mode)
+		{
+			if(p_fd == -1) return std::errc::bad_file_descriptor;
+			return std::errc{lseek64(p_fd, p_pos, p_mode) == -1 ? errno : 0};
+		}
+
+		static inline std::errc os_raw_resize(int const p_fd, int64_t const p_size)
+		{
+			if(p_fd == -1) return std::errc::bad_file_descriptor;
+			return std::errc{ftruncate64(p_fd, p_size) ? errno : 0};
+		}
+	} //namespace
+
+	namespace _p
+	{
+		file_raw_base::~file_raw_base()
+		{
+			if(m_fd != -1)
+			{
+				::close(m_fd);
+			}
+		}
+
+		void file_raw_base::close()
+		{
+			if(m_fd != -1)
+			{
+				::close(m_fd);
+				m_fd = -1;
+			}
+		}
+
+		int64_t file_raw_base::pos() const
+		{
+			return m_fd == -1 ? -1 : lseek64(m_fd, 0, SEEK_CUR);
+		}
+
+		std::errc file_raw_base::seek(int64_t const p_pos)
+		{
+			return os_raw_seek(m_fd, p_pos, SEEK_SET);
+		}
+
+		std::errc file_raw_base::seek_current(int64_t const p_pos)
+		{
+			return os_raw_seek(m_fd, p_pos, SEEK_CUR);
+		}
+
+		std::errc file_raw_base::seek_end(int64_t const p_pos)
+		{
+			return os_raw_seek(m_fd, p_pos, SEEK_END);
+		}
+
+		int64_t file_raw_base::size() const
+		{
+			if(m_fd == -1) return -1;
+			struct stat64 stat_value;
+			if(fstat64(m_fd, &stat_value))
+			{
+				return -1;
+			}
+			return stat_value.st_size;
+		}
+	} //namespace _p
+
+	std::errc file_read_raw::open(std::filesystem::path const& p_path)
+	{
+		close();
+		int const fd = open64(p_path.native().c_str(), O_RDONLY | fixed_flags);
+		if(fd < 0) return std::errc{errno};
+		m_fd = fd;
+		return std::errc{};
+	}
+
+	uintptr_t file_read_raw::read(void* const p_buff, uintptr_t const p_size)
+	{
+		return m_fd == -1 ? 0 : os_raw_read(m_fd, p_buff, p_size);
+	}
+
+	uintptr_t file_read_raw::read_offset(void* const p_buff, uintptr_t const p_size, int64_t const p_offset)
+	{
+		return m_fd == -1 ? 0 : os_raw_read_offset(m_fd, p_buff, p_size, p_offset);
+	}
+
+	std::errc file_read_raw::read_offset_nowait(void* const p_buff, uintptr_t const p_size, int64_t const p_offset, uintptr_t& p_read)
+	{
+		return os_raw_read_offset_nowait(m_fd, p_buff, p_size, p_offset, p_read);
+	}
+
+
+	file_write_raw::~file_write_raw()
+	{
+		flush();
+	}
+
+	std::errc file_write_raw::open(std::filesystem::path const& p_path, open_mode const p_mode, bool const p_create_directories)
+	{
+		close();
+		if(p_create_directories && p_mode != open_mode::open_existing)
+		{
+			std::error_code ec;
+			std::filesystem::create_directories(p_path.parent_path(), ec);
+		}
+
+		int const fd = os_raw_open(p_path, O_WRONLY, p_mode);
+		if(fd < 0) return std::errc{errno};
+		m_fd = fd;
+		return std::errc{};
+	}
+
+	void file_write_raw::close()
+	{
+		flush();
+		m_used = 0;
+		file_raw_base::close();
+	}
+
+	std::errc file_write_raw::set_buffer_size(uintptr_t const p_size)
+	{
+		std::errc const res = flush();
+		if(res != std::errc{}) return res;
+
+		if(p_size == 0)
+		{
+			m_buffer.reset();
+		}
+		else if(p_size != m_capacity)
+		{
+			m_buffer.reset(new uint8_t[p_size]);
+		}
+		m_capacity = p_size;
+		return std::errc{};
+	}
+
+	uintptr_t file_write_raw::write(void const* const p_buff, uintptr_t const p_size)
+	{
+		if(m_fd == -1 || p_size == 0) return 0;
+
+		if(m_used + p_size > m_capacity)
+		{
+			if(flush() != std::errc{}) return 0;
+			if(p_size >= m_capacity)
+			{
+				return os_raw_write(m_fd, p_buff, p_size);
+			}
+		}
+
+		memcpy(m_buffer.get() + m_used, p_buff, p_size);
+		m_used += p_size;
+		return p_size;
+	}
+
+	std::errc file_write_raw::flush()
+	{
+		if(m_used == 0) return std::errc{};
+		if(m_fd == -1) return std::errc::bad_file_descriptor;
+
+		errno = 0;
+		uintptr_t const written = os_raw_write(m_fd, m_buffer.get(), m_used);
+		if(written != m_used)
+		{
+			int const error = errno;
+			memmove(m_buffer.get(), m_buffer.get() + written, m_used - written);
+			m_used -= written;
+			return error ? std::errc{error} : std::errc::io_error;
+		}
+		m_used = 0;
+		return std::errc{};
+	}
+
+	std::errc file_write_raw::resize(int64_t const p_size)
+	{
+		std::errc const res = flush();
+		if(res != std::errc{}) return res;
+		return os_raw_resize(m_fd, p_size);
+	}
+
+	uintptr_t file_write_raw::write_offset(void const* const p_buff, uintptr_t const p_size, int64_t const p_offset)
+	{
+		if(m_fd == -1 || flush() != std::errc{}) return 0;
+		return os_raw_write_offset(m_fd, p_buff, p_size, p_offset);
+	}
+
+	int64_t file_write_raw::pos() const
+	{
+		int64_t const res = file_raw_base::pos();
+		return res == -1 ? -1 : res + static_cast<int64_t>(m_used);
+	}
+
+	int64_t file_write_raw::size() const
+	{
+		int64_t const res = file_raw_base::size();
+		if(res == -1 || m_used == 0) return res;
+		//pending data goes to the current position, and may extend the file
+		int64_t const end = pos();
+		if(end == -1) return -1;
+		return std::max(res, end);
+	}
+
+	std::errc file_write_raw::seek(int64_t const p_pos)
+	{
+		std::errc const res = flush();
+		if(res != std::errc{}) return res;
+		return file_raw_base::seek(p_pos);
+	}
+
+	std::errc file_write_raw::seek_current(int64_t const p_pos)
+	{
+		std::errc const res = flush();
+		if(res != std::errc{}) return res;
+		return file_raw_base::seek_current(p_pos);
+	}
+
+	std::errc file_write_raw::seek_end(int64_t const p_pos)
+	{
+		std::errc const res = flush();
+		if(res != std::errc{}) return res;
+		return file_raw_base::seek_end(p_pos);
+	}
+
+
+	std::errc file_duplex_raw::open(std::filesystem::path const& p_path, open_mode const p_mode, bool const p_create_directories)
+	{
+		close();
+		if(p_create_directories && p_mode != open_mode::open_existing)
+		{
+			std::error_code ec;
+			std::filesystem::create_directories(p_path.parent_path(), ec);
+		}
+
+		int const fd = os_raw_open(p_path, O_RDWR, p_mode);
+		if(fd < 0) return std::errc{errno};
+		m_fd = fd;
+		return std::errc{};
+	}
+
+	uintptr_t file_duplex_raw::read(void* const p_buff, uintptr_t const p_size)
+	{
+		return m_fd == -1 ? 0 : os_raw_read(m_fd, p_buff, p_size);
+	}
+
+	uintptr_t file_duplex_raw::write(void const* const p_buff, uintptr_t const p_size)
+	{
+		return m_fd == -1 ? 0 : os_raw_write(m_fd, p_buff, p_size);
+	}
+
+	std::errc file_duplex_raw::resize(int64_t const p_size)
+	{
+		return os_raw_resize(m_fd, p_size);
+	}
+
+	uintptr_t file_duplex_raw::read_offset(void* const p_buff, uintptr_t const p_size, int64_t const p_offset)
+	{
+		return m_fd == -1 ? 0 : os_raw_read_offset(m_fd, p_buff, p_size, p_offset);
+	}
+
+	uintptr_t file_duplex_raw::write_offset(void const* const p_buff, uintptr_t const p_size, int64_t const p_offset)
+	{
+		return m_fd == -1 ? 0 : os_raw_write_offset(m_fd, p_buff, p_size, p_offset);
+	}
+
+	std::errc file_duplex_raw::read_offset_nowait(void* const p_buff, uintptr_t const p_size, int64_t const p_offset, uintptr_t& p_read)
+	{
+		return os_raw_read_offset_nowait(m_fd, p_buff, p_size, p_offset, p_read);
+	}
+
+
+	std::errc file_direct::open(std::filesystem::path const& p_path, access const p_access, open_mode const p_mode, bool const p_create_directories)
+	{
+		close();
+		int fd;
+		if(p_access == access::read_only)
+		{
+			if(p_mode != open_mode::open_existing) return std::errc::invalid_argument;
+			fd = open64(p_path.native().c_str(), O_RDONLY | O_DIRECT | fixed_flags);
+		}
+		else
+		{
+			if(p_create_directories && p_mode != open_mode::open_existing)
+			{
+				std::error_code ec;
+				std::filesystem::create_directories(p_path.parent_path(), ec);
+			}
+			fd = os_raw_open(p_path, O_RDWR | O_DIRECT, p_mode);
+		}
+		if(fd < 0) return std::errc{errno};
+		m_fd = fd;
+
+		//conservative default, correct for any device with logical blocks of up to 4KiB
+		m_offset_alignment = 4096;
+		m_memory_alignment = 4096;
+#ifdef STATX_DIOALIGN
+		struct statx info;
+		if(statx(fd, "", AT_EMPTY_PATH, STATX_DIOALIGN, &info) == 0 && (info.stx_mask & STATX_DIOALIGN) && info.stx_dio_offset_align)
+		{
+			m_offset_alignment = info.stx_dio_offset_align;
+			m_memory_alignment = info.stx_dio_mem_align;
+		}
+#endif
+		return std::errc{};
+	}
+
+	bool file_direct::is_aligned(void const* const p_buff, uintptr_t const p_size, int64_t const p_offset) const
+	{
+		return
+			(reinterpret_cast<uintptr_t>(p_buff) & (m_memory_alignment - 1)) == 0 &&
+			(p_size & (m_offset_alignment - 1)) == 0 &&
+			(static_cast<uint64_t>(p_offset) & (m_offset_alignment - 1)) == 0;
+	}
+
+	std::errc file_direct::read_offset(void* const p_buff, uintptr_t const p_size, int64_t const p_offset, uintptr_t& p_read)
+	{
+		p_read = 0;
+		if(m_fd == -1) return std::errc::bad_file_descriptor;
+		if(p_offset < 0 || !is_aligned(p_buff, p_size, p_offset)) return std::errc::invalid_argument;
+
+		while(p_read < p_size)
+		{
+			ssize_t const res = pread64(m_fd, reinterpret_cast<uint8_t*>(p_buff) + p_read, p_size - p_read, p_offset + static_cast<int64_t>(p_read));
+			if(res == -1)
+			{
+				if(errno == EINTR) continue;
+				return std::errc{errno};
+			}
+			p_read += static_cast<uintptr_t>(res);
+			//an unaligned transfer only happens at the end of the file
+			if(res == 0 || (static_cast<uintptr_t>(res) & (m_offset_alignment - 1))) break;
+		}
+		return std::errc{};
+	}
+
+	std::errc file_direct::write_offset(void const* const p_buff, uintptr_t const p_size, int64_t const p_offset, uintptr_t& p_written)
+	{
+		p_written = 0;
+		if(m_fd == -1) return std::errc::bad_file_descriptor;
+		if(p_offset < 0 || !is_aligned(p_buff, p_size, p_offset)) return std::errc::invalid_argument;
+
+		while(p_written < p_size)
+		{
+			ssize_t const res = pwrite64(m_fd, reinterpret_cast<uint8_t const*>(p_buff) + p_written, p_size - p_written, p_offset + static_cast<int64_t>(p_written));
+			if(res == -1)
+			{
+				if(errno == EINTR) continue;
+				return std::errc{errno};
+			}
+			if(res == 0 || (static_cast<uintptr_t>(res) & (m_offset_alignment - 1)))
+			{
+				p_written += static_cast<uintptr_t>(res);
+				return std::errc::io_error;
+			}
+			p_written += static_cast<uintptr_t>(res);
+		}
+		return std::errc{};
+	}
+
+	std::errc file_direct::resize(int64_t const p_size)
+	{
+		return os_raw_resize(m_fd, p_size);
+	}
+#endif
+
+	//======== ======== ======== aligned_buffer ======== ======== ========
+
+	void aligned_buffer_deleter::operator () (uint8_t* const p_buffer) const
+	{
+		::operator delete[](p_buffer, std::align_val_t{alignment});
+	}
+
+	aligned_buffer make_aligned_buffer(uintptr_t const p_size, uintptr_t const p_alignment)
+	{
+		if(p_alignment == 0 || (p_alignment & (p_alignment - 1))) return aligned_buffer{nullptr, aligned_buffer_deleter{p_alignment}};
+
+		uintptr_t const size = (p_size + p_alignment - 1) & ~(p_alignment - 1);
+		void* const buffer = ::operator new[](size ? size : p_alignment, std::align_val_t{p_alignment}, std::nothrow);
+		return aligned_buffer{reinterpret_cast<uint8_t*>(buffer), aligned_buffer_deleter{p_alignment}};
+	}
+
+	//======== ======== ======== file_mmap ======== ======== ========
+
+	namespace
+	{
+#ifdef _WIN32
+		static inline uintptr_t os_map_granularity()
+		{
+			static uintptr_t const granularity = []()
+			{
+				SYSTEM_INFO info;
+				GetSystemInfo(&info);
+				return static_cast<uintptr_t>(info.dwAllocationGranularity);
+			}();
+			return granularity;
+		}
+
+#else
+		static inline uintptr_t os_map_granularity()
+		{
+			static uintptr_t const granularity = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+			return granularity;
+		}
+
+		static inline uintptr_t os_page_size()
+		{
+			return os_map_granularity();
+		}
+#endif
+	} //namespace
+
+	file_mmap::~file_mmap()
+	{
+		close();
+	}
+
+	std::errc file_mmap::map(int64_t const p_offset, uintptr_t p_size)
+	{
+		unmap();
+		if(!is_open()) return std::errc::bad_file_descriptor;
+		if(p_offset < 0) return std::errc::invalid_argument;
+
+		if(p_size == 0)
+		{
+			int64_t const total = file_size();
+			if(total < 0) return std::errc::io_error;
+			if(total <= p_offset) return std::errc::invalid_argument;
+			uint64_t const remaining = static_cast<uint64_t>(total - p_offset);
+			if(remaining > UINTPTR_MAX) return std::errc::value_too_large;
+			p_size = static_cast<uintptr_t>(remaining);
+		}
+
+		uintptr_t const lead = static_cast<uintptr_t>(static_cast<uint64_t>(p_offset) % os_map_granularity());
+		if(p_size > UINTPTR_MAX - lead) return std::errc::value_too_large;
+		int64_t const base = p_offset - static_cast<int64_t>(lead);
+		uintptr_t const view_size = p_size + lead;
+
+#ifdef _WIN32
+		uint64_t const end = static_cast<uint64_t>(p_offset) + p_size;
+		HANDLE const mapping = CreateFileMappingW(m_file, nullptr,
+			m_access == access::read_write ? PAGE_READWRITE : PAGE_READONLY,
+			static_cast<DWORD>(end >> 32), static_cast<DWORD>(end), nullptr);
+		if(!mapping) return std::errc::io_error;
+
+		void* const view = MapViewOfFile(mapping,
+			m_access == access::read_write ? FILE_MAP_WRITE : FILE_MAP_READ,
+			static_cast<DWORD>(static_cast<uint64_t>(base) >> 32), static_cast<DWORD>(base), view_size);
+		if(!view)
+		{
+			CloseHandle(mapping);
+			return std::errc::not_enough_memory;
+		}
+		m_mapping = mapping;
+#else
+		void* const view = mmap64(nullptr, view_size,
+			m_access == access::read_write ? PROT_READ | PROT_WRITE : PROT_READ,
+			MAP_SHARED, m_fd, base);
+		if(view == MAP_FAILED) return std::errc{errno};
+#endif
+
+		m_view		= reinterpret_cast<uint8_t*>(view);
+		m_lead		= lead;
+		m_size		= p_size;
+		m_offset	= p_offset;
+		return std::errc{};
+	}
+
+	std::errc file_mmap::advise(advice const p_advice)
+	{
+		return advise(p_advice, 0, m_size);
+	}
+
+	std::errc file_mmap::flush(bool const p_wait)
+	{
+		return flush(0, m_size, p_wait);
+	}
+
+#ifdef _WIN32
+	std::errc file_mmap::open(std::filesystem::path const& p_path, access const p_access, open_mode const p_mode, bool const p_create_directories)
+	{
+		close();
+		if(p_access == access::read_only && p_mode != open_mode::open_existing) return std::errc::invalid_argument;
+
+		DWORD disposition;
+		switch(p_mode)
+		{
+		case open_mode::create:
+			disposition = CREATE_ALWAYS;
+			break;
+		case open_mode::crete_if_new:
+			disposition = CREATE_NEW;
+			break;
+		case open_mode::open_or_create:
+			disposition = OPEN_ALWAYS;
+			break;
+		case open_mode::open_existing:
+			disposition = OPEN_EXISTING;
+			break;
+		default:
+			return std::errc::invalid_argument;
+		}
+
+		if(p_create_directories && p_mode != open_mode::open_existing)
+		{
+			std::error_code ec;
+			std::filesystem::create_directories(p_path.parent_path(), ec);
+		}
+
+		HANDLE const file = CreateFileW(p_path.native().c_str(),
+			p_access == access::read_write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+			FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if(file == INVALID_HANDLE_VALUE)
+		{
+			return GetLastError() == ERROR_FILE_NOT_FOUND ? std::errc::no_such_file_or_directory : std::errc::io_error;
+		}
+
+		m_file		= file;
+		m_access	= p_access;
+		return std::errc{};
+	}
+
+	void file_mmap::close()
+	{
+		unmap();
+		if(m_file)
+		{
+			CloseHandle(m_file);
+			m_file = nullptr;
+		}
+	}
+
+	bool file_mmap::is_open() const
+	{
+		return m_file != nullptr;
+	}
+
+	int64_t file_mmap::file_size() const
+	{
+		LARGE_INTEGER size;
+		if(!m_file || !GetFileSizeEx(m_file, &size)) return -1;
+		return size.QuadPart;
+	}
+
+	std::errc file_mmap::resize(int64_t const p_size)
+	{
+		if(!m_file) return std::errc::bad_file_descriptor;
+		if(m_access != access::read_write) return std::errc::permission_denied;
+
+		FILE_END_OF_FILE_INFO info;
+		info.EndOfFile.QuadPart = p_size;
+		return SetFileInformationByHandle(m_file, FileEndOfFileInfo, &info, sizeof(info)) ? std::errc{} : std::errc::io_error;
+	}
+
+	void file_mmap::unmap()
+	{
+		if(m_view)
+		{
+			UnmapViewOfFile(m_view);
+			CloseHandle(m_mapping);
+			m_view		= nullptr;
+			m_mapping	= nullptr;
+			m_lead		= 0;
+			m_size		= 0;
+			m_offset	= 0;
+		}
+	}
+
+	std::errc file_mmap::advise(advice const p_advice, uintptr_t const p_offset, uintptr_t const p_size)
+	{
+		if(!m_view) return std::errc::bad_address;
+		if(p_offset > m_size || p_size > m_size - p_offset) return std::errc::invalid_argument;
+
+		switch(p_advice)
+		{
+		case advice::normal:
+		case advice::sequential:
+		case advice::random:
+			return std::errc{};
+		case advice::will_need:
+			{
+				WIN32_MEMORY_RANGE_ENTRY range;
+				range.VirtualAddress	= m_view + m_lead + p_offset;
+				range.NumberOfBytes		= p_size;
+				return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0) ? std::errc{} : std::errc::io_error;
+			}
+		default:
+			break;
+		}
+		return std::errc::not_supported;
+	}
+
+	std::errc file_mmap::flush(uintptr_t const p_offset, uintptr_t const p_size, bool const p_wait)
+	{
+		if(!m_view) return std::errc::bad_address;
+		if(p_offset > m_size || p_size > m_size - p_offset) return std::errc::invalid_argument;
+
+		if(!FlushViewOfFile(m_view + m_lead + p_offset, p_size)) return std::errc::io_error;
+		if(p_wait && !FlushFileBuffers(m_file)) return std::errc::io_error;
+		return std::errc{};
+	}
+#else
+	std::errc file_mmap::open(std::filesystem::path const& p_path, access const p_access, open_mode const p_mode, bool const p_create_directories)
+	{
+		close();
+		if(p_access == access::read_only)
+		{
+			if(p_mode != open_mode::open_existing) return std::errc::invalid_argument;
+
+			int const fd = open64(p_path.native().c_str(), O_RDONLY | fixed_flags);
+			if(fd < 0) return std::errc{errno};
+			m_fd = fd;
+			m_access = p_access;
+			return std::errc{};
+		}
+
+		int flags;
+		switch(p_mode)
+		{
+		case open_mode::create:
+			flags = O_RDWR | O_CREAT | O_TRUNC;
+			break;
+		case open_mode::crete_if_new:
+			flags = O_RDWR | O_CREAT | O_EXCL;
+			break;
+		case open_mode::open_or_create:
+			flags = O_RDWR | O_CREAT;
+			break;
+		case open_mode::open_existing:
+			flags = O_RDWR;
+			break;
+		default:
+			return std::errc::invalid_argument;
+		}
+
+		if(p_create_directories && p_mode != open_mode::open_existing)
+		{
+			std::error_code ec;
+			std::filesystem::create_directories(p_path.parent_path(), ec);
+		}
+
+		int const fd = open64(p_path.native().c_str(), flags | fixed_flags, fixed_permissions);
+		if(fd < 0) return std::errc{errno};
+		m_fd = fd;
+		m_access = p_access;
+		return std::errc{};
+	}
+
+	void file_mmap::close()
+	{
+		unmap();
+		if(m_fd != -1)
+		{
+			::close(m_fd);
+			m_fd = -1;
+		}
+	}
+
+	bool file_mmap::is_open() const
+	{
+		return m_fd != -1;
+	}
+
+	int64_t file_mmap::file_size() const
+	{
+		if(m_fd == -1) return -1;
+		struct stat64 stat_value;
+		if(fstat64(m_fd, &stat_value))
+		{
+			return -1;
+		}
+		return stat_value.st_size;
+	}
+
+	std::errc file_mmap::resize(int64_t const p_size)
+	{
+		if(m_fd == -1) return std::errc::bad_file_descriptor;
+		if(m_access != access::read_write) return std::errc::permission_denied;
+		return std::errc{ftruncate64(m_fd, p_size) ? errno : 0};
+	}
+
+	void file_mmap::unmap()
+	{
+		if(m_view)
+		{
+			munmap(m_view, m_size + m_lead);
+			m_view		= nullptr;
+			m_lead		= 0;
+			m_size		= 0;
+			m_offset	= 0;
+		}
+	}
+
+	std::errc file_mmap::advise(advice const p_advice, uintptr_t const p_offset, uintptr_t const p_size)
+	{
+		if(!m_view) return std::errc::bad_address;
+		if(p_offset > m_size || p_size > m_size - p_offset) return std::errc::invalid_argument;
+
+		int native;
+		switch(p_advice)
+		{
+		case advice::normal:
+			native = MADV_NORMAL;
+			break;
+		case advice::sequential:
+			native = MADV_SEQUENTIAL;
+			break;
+		case advice::random:
+			native = MADV_RANDOM;
+			break;
+		case advice::will_need:
+			native = MADV_WILLNEED;
+			break;
+		case advice::dont_need:
+			native = MADV_DONTNEED;
+			break;
+		case advice::huge_page:
+#ifdef MADV_HUGEPAGE
+			native = MADV_HUGEPAGE;
+			break;
+#else
+			return std::errc::not_supported;
+#endif
+		default:
+			return std::errc::invalid_argument;
+		}
+
+		//the range must start on a page boundary
+		uintptr_t const start = m_lead + p_offset;
+		uintptr_t const aligned_start = start - start % os_page_size();
+		return std::errc{madvise(m_view + aligned_start, p_size + (start - aligned_start), native) ? errno : 0};
+	}
+
+	std::errc file_mmap::flush(uintptr_t const p_offset, uintptr_t const p_size, bool const p_wait)
+	{
+		if(!m_view) return std::errc::bad_address;
+		if(p_offset > m_size || p_size > m_size - p_offset) return std::errc::invalid_argument;
+
+		uintptr_t const start = m_lead + p_offset;
+		uintptr_t const aligned_start = start - start % os_page_size();
+		return std::errc{msync(m_view + aligned_start, p_size + (start - aligned_start), p_wait ? MS_SYNC : MS_ASYNC) ? errno : 0};
+	}
 #endif
 } //namespace core
@@ -0,0 +1,691 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+
+#include <CoreLib/core_file_async.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "core_thread_binding.hpp"
+
+#ifdef __linux__
+#	include <linux/io_uring.h>
+#	include <sys/mman.h>
+#	include <sys/syscall.h>
+#	include <sys/uio.h>
+#	include <unistd.h>
+#endif
+
+namespace core
+{
+#ifdef __linux__
+	namespace
+	{
+		//liburing is not a dependency, the ring is operated directly through the system calls
+		static inline int os_uring_setup(uint32_t const p_entries, io_uring_params& p_params)
+		{
+			return static_cast<int>(syscall(__NR_io_uring_setup, p_entries, &p_params));
+		}
+
+		static inline int os_uring_enter(int const p_ring, uint32_t const p_submit, uint32_t const p_min_complete, uint32_t const p_flags)
+		{
+			return static_cast<int>(syscall(__NR_io_uring_enter, p_ring, p_submit, p_min_complete, p_flags, nullptr, 0));
+		}
+
+		static inline int os_uring_register(int const p_ring, uint32_t const p_opcode, void const* const p_arg, uint32_t const p_count)
+		{
+			return static_cast<int>(syscall(__NR_io_uring_register, p_ring, p_opcode, p_arg, p_count));
+		}
+
+		static inline uint32_t load_acquire(uint32_t* const p_value)
+		{
+			return std::atomic_ref<uint32_t>{*p_value}.load(std::memory_order_acquire);
+		}
+
+		static inline void store_release(uint32_t* const p_value, uint32_t const p_new)
+		{
+			std::atomic_ref<uint32_t>{*p_value}.store(p_new, std::memory_order_release);
+		}
+
+		static inline void prep_rw(io_uring_sqe& p_sqe, uint8_t const p_opcode, file_async::target const p_file, void const* const p_buff, uint32_t const p_size, int64_t const p_offset, uint64_t const p_user_data)
+		{
+			p_sqe.opcode	= p_opcode;
+			p_sqe.flags		= p_file.registered ? IOSQE_FIXED_FILE : 0;
+			p_sqe.fd		= p_file.value;
+			p_sqe.off		= static_cast<uint64_t>(p_offset);
+			p_sqe.addr		= reinterpret_cast<uintptr_t>(p_buff);
+			p_sqe.len		= p_size;
+			p_sqe.user_data	= p_user_data;
+		}
+
+		static inline void prep_fsync(io_uring_sqe& p_sqe, file_async::target const p_file, bool const p_data_only, uint64_t const p_user_data)
+		{
+			p_sqe.opcode		= IORING_OP_FSYNC;
+			p_sqe.flags			= p_file.registered ? IOSQE_FIXED_FILE : 0;
+			p_sqe.fd			= p_file.value;
+			p_sqe.fsync_flags	= p_data_only ? IORING_FSYNC_DATASYNC : 0;
+			p_sqe.user_data		= p_user_data;
+		}
+	} //namespace
+
+	file_async::~file_async()
+	{
+		close();
+	}
+
+	std::errc file_async::open(uint32_t const p_depth)
+	{
+		close();
+		if(p_depth == 0) return std::errc::invalid_argument;
+
+		io_uring_params params;
+		memset(&params, 0, sizeof(params));
+		int const ring = os_uring_setup(p_depth, params);
+		if(ring < 0)
+		{
+			int const error = errno;
+			if(error == ENOSYS || error == EPERM) return std::errc::not_supported;
+			return std::errc{error};
+		}
+
+		m_ring = ring;
+		m_sq_entries = params.sq_entries;
+
+		m_sq_map_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+		m_cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		bool const single_map = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if(single_map)
+		{
+			if(m_cq_map_size > m_sq_map_size) m_sq_map_size = m_cq_map_size;
+			m_cq_map_size = 0;
+		}
+
+		void* const sq_map = mmap64(nullptr, m_sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+		if(sq_map == MAP_FAILED)
+		{
+			int const error = errno;
+			close();
+			return std::errc{error};
+		}
+		m_sq_map = sq_map;
+
+		void* cq_map = sq_map;
+		if(!single_map)
+		{
+			cq_map = mmap64(nullptr, m_cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING);
+			if(cq_map == MAP_FAILED)
+			{
+				int const error = errno;
+				close();
+				return std::errc{error};
+			}
+			m_cq_map = cq_map;
+		}
+
+		m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+		void* const sqes = mmap64(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES);
+		if(sqes == MAP_FAILED)
+		{
+			int const error = errno;
+			close();
+			return std::errc{error};
+		}
+		m_sqes = sqes;
+
+		uint8_t* const sq_base = static_cast<uint8_t*>(sq_map);
+		m_sq_head_ptr	= reinterpret_cast<uint32_t*>(sq_base + params.sq_off.head);
+		m_sq_tail_ptr	= reinterpret_cast<uint32_t*>(sq_base + params.sq_off.tail);
+		m_sq_array		= reinterpret_cast<uint32_t*>(sq_base + params.sq_off.array);
+		m_sq_mask		= *reinterpret_cast<uint32_t*>(sq_base + params.sq_off.ring_mask);
+		m_sq_tail		= *m_sq_tail_ptr;
+
+		uint8_t* const cq_base = static_cast<uint8_t*>(cq_map);
+		m_cq_head_ptr	= reinterpret_cast<uint32_t*>(cq_base + params.cq_off.head);
+		m_cq_tail_ptr	= reinterpret_cast<uint32_t*>(cq_base + params.cq_off.tail);
+		m_cq_mask		= *reinterpret_cast<uint32_t*>(cq_base + params.cq_off.ring_mask);
+		m_cqes			= cq_base + params.cq_off.cqes;
+
+		return std::errc{};
+	}
+
+	void file_async::close()
+	{
+		if(m_sqes) munmap(m_sqes, m_sqes_size);
+		if(m_cq_map) munmap(m_cq_map, m_cq_map_size);
+		if(m_sq_map) munmap(m_sq_map, m_sq_map_size);
+		if(m_ring != -1) ::close(m_ring);
+
+		m_ring			= -1;
+		m_sq_entries	= 0;
+		m_queued		= 0;
+		m_sq_tail		= 0;
+		m_sq_head_ptr	= nullptr;
+		m_sq_tail_ptr	= nullptr;
+		m_sq_array		= nullptr;
+		m_sq_mask		= 0;
+		m_sqes			= nullptr;
+		m_cq_head_ptr	= nullptr;
+		m_cq_tail_ptr	= nullptr;
+		m_cq_mask		= 0;
+		m_cqes			= nullptr;
+		m_sq_map		= nullptr;
+		m_sq_map_size	= 0;
+		m_cq_map		= nullptr;
+		m_cq_map_size	= 0;
+		m_sqes_size		= 0;
+	}
+
+	file_async::target file_async::descriptor(_p::file_base& p_file)
+	{
+		FILE* const handle = static_cast<FILE*>(p_file.handle());
+		return target{handle ? fileno(handle) : -1, false};
+	}
+
+	std::errc file_async::register_files(std::span<int const> const p_fds)
+	{
+		if(m_ring == -1) return std::errc::bad_file_descriptor;
+		if(p_fds.empty()) return std::errc::invalid_argument;
+		return std::errc{os_uring_register(m_ring, IORING_REGISTER_FILES, p_fds.data(), static_cast<uint32_t>(p_fds.size())) < 0 ? errno : 0};
+	}
+
+	std::errc file_async::unregister_files()
+	{
+		if(m_ring == -1) return std::errc::bad_file_descriptor;
+		return std::errc{os_uring_register(m_ring, IORING_UNREGISTER_FILES, nullptr, 0) < 0 ? errno : 0};
+	}
+
+	std::errc file_async::register_buffers(std::span<std::span<uint8_t> const> const p_buffers)
+	{
+		if(m_ring == -1) return std::errc::bad_file_descriptor;
+		if(p_buffers.empty()) return std::errc::invalid_argument;
+
+		std::vector<iovec> vectors;
+		vectors.reserve(p_buffers.size());
+		for(std::span<uint8_t> const& buffer : p_buffers)
+		{
+			vectors.push_back(iovec{buffer.data(), buffer.size()});
+		}
+		return std::errc{os_uring_register(m_ring, IORING_REGISTER_BUFFERS, vectors.data(), static_cast<uint32_t>(vectors.size())) < 0 ? errno : 0};
+	}
+
+	std::errc file_async::unregister_buffers()
+	{
+		if(m_ring == -1) return std::errc::bad_file_descriptor;
+		return std::errc{os_uring_register(m_ring, IORING_UNREGISTER_BUFFERS, nullptr, 0) < 0 ? errno : 0};
+	}
+
+	void* file_async::acquire_entries(uint32_t const p_count)
+	{
+		if(m_ring == -1) return nullptr;
+
+		if(m_sq_entries - (m_sq_tail - load_acquire(m_sq_head_ptr)) < p_count)
+		{
+			//make room by handing the queued entries to the kernel
+			if(m_queued) enter(0, 0);
+			if(m_sq_entries - (m_sq_tail - load_acquire(m_sq_head_ptr)) < p_count) return nullptr;
+		}
+
+		io_uring_sqe* const sqe = static_cast<io_uring_sqe*>(m_sqes) + (m_sq_tail & m_sq_mask);
+		memset(sqe, 0, sizeof(io_uring_sqe));
+		return sqe;
+	}
+
+	void file_async::push_entry()
+	{
+		uint32_t const index = m_sq_tail & m_sq_mask;
+		m_sq_array[index] = index;
+		store_release(m_sq_tail_ptr, ++m_sq_tail);
+		++m_queued;
+	}
+
+	std::errc file_async::queue_read(target const p_file, void* const p_buff, uint32_t const p_size, int64_t const p_offset, uint64_t const p_user_data)
+	{
+		io_uring_sqe* const sqe = static_cast<io_uring_sqe*>(acquire_entries(1));
+		if(!sqe) return m_ring == -1 ? std::errc::bad_file_descriptor : std::errc::resource_unavailable_try_again;
+		prep_rw(*sqe, IORING_OP_READ, p_file, p_buff, p_size, p_offset, p_user_data);
+		push_entry();
+		return std::errc{};
+	}
+
+	std::errc file_async::queue_write(target const p_file, void const* const p_buff, uint32_t const p_size, int64_t const p_offset, uint64_t const p_user_data)
+	{
+		io_uring_sqe* const sqe = static_cast<io_uring_sqe*>(acquire_entries(1));
+		if(!sqe) return m_ring == -1 ? std::errc::bad_file_descriptor : std::errc::resource_unavailable_try_again;
+		prep_rw(*sqe, IORING_OP_WRITE, p_file, p_buff, p_size, p_offset, p_user_data);
+		push_entry();
+		return std::errc{};
+	}
+
+	std::errc file_async::queue_read_fixed(target const p_file, uint16_t const p_buffer_index, void* const p_buff, uint32_t const p_size, int64_t const p_offset, uint64_t const p_user_data)
+	{
+		io_uring_sqe* const sqe = static_cast<io_uring_sqe*>(acquire_entries(1));
+		if(!sqe) return m_ring == -1 ? std::errc::bad_file_descriptor : std::errc::resource_unavailable_try_again;
+		prep_rw(*sqe, IORING_OP_READ_FIXED, p_file, p_buff, p_size, p_offset, p_user_data);
+		sqe->buf_index = p_buffer_index;
+		push_entry();
+		return std::errc{};
+	}
+
+	std::errc file_async::queue_write_fixed(target const p_file, uint16_t const p_buffer_index, void const* const p_buff, uint32_t const p_size, int64_t const p_offset, uint64_t const p_user_data)
+	{
+		io_uring_sqe* const sqe = static_cast<io_uring_sqe*>(acquire_entries(1));
+		if(!sqe) return m_ring == -1 ? std::errc::bad_file_descriptor : std::errc::resource_unavailable_try_again;
+		prep_rw(*sqe, IORING_OP_WRITE_FIXED, p_file, p_buff, p_size, p_offset, p_user_data);
+		sqe->buf_index = p_buffer_index;
+		push_entry();
+		return std::errc{};
+	}
+
+	std::errc file_async::queue_fsync(target const p_file, bool const p_data_only, uint64_t const p_user_data)
+	{
+		io_uring_sqe* const sqe = static_cast<io_uring_sqe*>(acquire_entries(1));
+		if(!sqe) return m_ring == -1 ? std::errc::bad_file_descriptor : std::errc::resource_unavailable_try_again;
+		prep_fsync(*sqe, p_file, p_data_only, p_user_data);
+		push_entry();
+		return std::errc{};
+	}
+
+	std::errc file_async::queue_write_fsync(target const p_file, void const* const p_buff, uint32_t const p_size, int64_t const p_offset, uint64_t const p_write_user_data, uint64_t const p_fsync_user_data, bool const p_data_only)
+	{
+		//both entries must be reserved up front, a link can not span across submissions
+		if(m_sq_entries < 2) return std::errc::invalid_argument;
+		io_uring_sqe* const write_sqe = static_cast<io_uring_sqe*>(acquire_entries(2));
+		if(!write_sqe) return m_ring == -1 ? std::errc::bad_file_descriptor : std::errc::resource_unavailable_try_again;
+		prep_rw(*write_sqe, IORING_OP_WRITE, p_file, p_buff, p_size, p_offset, p_write_user_data);
+		write_sqe->flags |= IOSQE_IO_LINK;
+		push_entry();
+
+		//the ring may wrap around, the second entry is not necessarily contiguous
+		io_uring_sqe* const fsync_sqe = static_cast<io_uring_sqe*>(m_sqes) + (m_sq_tail & m_sq_mask);
+		memset(fsync_sqe, 0, sizeof(io_uring_sqe));
+		prep_fsync(*fsync_sqe, p_file, p_data_only, p_fsync_user_data);
+		push_entry();
+		return std::errc{};
+	}
+
+	std::errc file_async::enter(uint32_t const p_min_complete, uint32_t const p_flags)
+	{
+		while(true)
+		{
+			int const res = os_uring_enter(m_ring, m_queued, p_min_complete, p_flags);
+			if(res >= 0)
+			{
+				m_queued -= static_cast<uint32_t>(res);
+				return std::errc{};
+			}
+			if(errno != EINTR) return std::errc{errno};
+		}
+	}
+
+	std::errc file_async::submit()
+	{
+		if(m_ring == -1) return std::errc::bad_file_descriptor;
+		if(m_queued == 0) return std::errc{};
+		return enter(0, 0);
+	}
+
+	std::errc file_async::wait(uint32_t const p_count)
+	{
+		if(m_ring == -1) return std::errc::bad_file_descriptor;
+		return enter(p_count, p_count ? IORING_ENTER_GETEVENTS : 0);
+	}
+
+	uint32_t file_async::reap(std::span<completion> const p_out)
+	{
+		if(m_ring == -1) return 0;
+
+		uint32_t head = *m_cq_head_ptr;
+		uint32_t const tail = load_acquire(m_cq_tail_ptr);
+		io_uring_cqe const* const cqes = static_cast<io_uring_cqe const*>(m_cqes);
+
+		uint32_t count = 0;
+		uint32_t const max_count = static_cast<uint32_t>(p_out.size());
+		for(; head != tail && count < max_count; ++head, ++count)
+		{
+			io_uring_cqe const& cqe = cqes[head & m_cq_mask];
+			p_out[count] = completion{cqe.user_data, cqe.res};
+		}
+
+		store_release(m_cq_head_ptr, head);
+		return count;
+	}
+#endif // __linux__
+
+	//======== ======== ======== file_write_async ======== ======== ========
+
+	namespace _p
+	{
+		///	\brief Single producer (the owning thread), single consumer (the flusher) byte ring.
+		struct file_write_async_ring
+		{
+			alignas(64) std::atomic<uint64_t>	m_head	{0};	//!< Written by the producer
+			alignas(64) std::atomic<uint64_t>	m_tail	{0};	//!< Written by the consumer
+			alignas(64) std::atomic<bool>		m_owned	{false};
+			uintptr_t const						m_mask;
+			std::unique_ptr<uint8_t[]> const	m_data;
+
+			file_write_async_ring(uintptr_t const p_size)
+				: m_mask(p_size - 1)
+				, m_data(new (std::nothrow) uint8_t[p_size])
+			{
+			}
+		};
+
+		///	\brief Rings bound by a thread to the writers it has used.
+		static thread_local thread_binding_cache<file_write_async_ring> t_async_cache;
+	} //namespace _p
+
+	namespace
+	{
+		static inline uintptr_t ring_used(_p::file_write_async_ring const& p_ring)
+		{
+			return static_cast<uintptr_t>(p_ring.m_head.load(std::memory_order::relaxed) - p_ring.m_tail.load(std::memory_order::acquire));
+		}
+
+		///	\warning Only the producer may call this, p_size must fit in the free space
+		static inline void ring_push(_p::file_write_async_ring& p_ring, uint8_t const* const p_data, uintptr_t const p_size)
+		{
+			uint64_t const head = p_ring.m_head.load(std::memory_order::relaxed);
+			uintptr_t const start = static_cast<uintptr_t>(head) & p_ring.m_mask;
+			uintptr_t const first = std::min(p_size, p_ring.m_mask + 1 - start);
+			memcpy(p_ring.m_data.get() + start, p_data, first);
+			memcpy(p_ring.m_data.get(), p_data + first, p_size - first);
+			p_ring.m_head.store(head + p_size, std::memory_order::seq_cst);
+		}
+	} //namespace
+
+	file_write_async::~file_write_async()
+	{
+		stop();
+	}
+
+	std::errc file_write_async::start(file_write& p_file, uintptr_t const p_staging_size, uintptr_t const p_flush_bytes, uint32_t const p_flush_interval, overflow const p_policy)
+	{
+		stop();
+		if(!p_file.is_open()) return std::errc::bad_file_descriptor;
+		if(p_staging_size == 0 || p_staging_size > (uintptr_t{1} << (sizeof(uintptr_t) * 8 - 2))) return std::errc::invalid_argument;
+
+		m_staging_size		= std::bit_ceil(p_staging_size);
+		m_flush_bytes		= std::clamp<uintptr_t>(p_flush_bytes, 1, m_staging_size);
+		m_flush_interval	= p_flush_interval;
+		m_policy			= p_policy;
+		m_stop.store(false, std::memory_order::relaxed);
+		m_wake.store(false, std::memory_order::relaxed);
+		m_dropped.store(0, std::memory_order::relaxed);
+		m_write_errors.store(0, std::memory_order::relaxed);
+		m_trap.reset();
+
+		m_file = &p_file;
+		if(m_thread.create(this, &file_write_async::flusher, nullptr) != thread::Error::None)
+		{
+			m_file = nullptr;
+			return std::errc::resource_unavailable_try_again;
+		}
+		m_id = _p::owner_registry::instance().add();
+		return std::errc{};
+	}
+
+	void file_write_async::stop()
+	{
+		if(!m_file) return;
+
+		m_stop.store(true, std::memory_order::release);
+		m_trap.signal();
+		m_thread.join();
+
+		//after this no thread will try to give back its ring
+		_p::owner_registry::instance().remove(m_id);
+		m_id = 0;
+
+		drain();
+		for(_p::file_write_async_ring* const t_ring : m_rings)
+		{
+			//could not be written out
+			m_dropped.fetch_add(ring_used(*t_ring), std::memory_order::relaxed);
+			delete t_ring;
+		}
+		m_rings.clear();
+		m_segments.clear();
+		m_file = nullptr;
+	}
+
+	_p::file_write_async_ring* file_write_async::bind()
+	{
+		_p::thread_binding_cache<_p::file_write_async_ring>& t_cache = _p::t_async_cache;
+
+		_p::file_write_async_ring* t_ring = t_cache.find(m_id);
+		if(t_ring) return t_ring;
+
+		t_ring = _p::claim_free_slot(m_lock, m_rings);
+		if(!t_ring)
+		{
+			t_ring = new (std::nothrow) _p::file_write_async_ring(m_staging_size);
+			if(!t_ring) return nullptr;
+			if(!t_ring->m_data)
+			{
+				delete t_ring;
+				return nullptr;
+			}
+			t_ring->m_owned.store(true, std::memory_order::relaxed);
+			atomic_spinlock::scope_locker const lock(m_lock);
+			m_rings.push_back(t_ring);
+		}
+
+		t_cache.bind(m_id, t_ring);
+		return t_ring;
+	}
+
+	void file_write_async::wake()
+	{
+		if(!m_wake.exchange(true, std::memory_order::seq_cst))
+		{
+			m_trap.signal();
+		}
+	}
+
+	std::errc file_write_async::write(void const* const p_data, uintptr_t const p_size)
+	{
+		if(!m_file) return std::errc::bad_file_descriptor;
+		if(p_size == 0) return std::errc{};
+
+		_p::file_write_async_ring* const t_ring = bind();
+		if(!t_ring)
+		{
+			m_dropped.fetch_add(p_size, std::memory_order::relaxed);
+			return std::errc::no_buffer_space;
+		}
+
+		uint8_t const* t_data = reinterpret_cast<uint8_t const*>(p_data);
+		uintptr_t t_remain = p_size;
+		uintptr_t const t_capacity = t_ring->m_mask + 1;
+
+		if(m_policy == overflow::drop)
+		{
+			if(t_remain > t_capacity - ring_used(*t_ring))
+			{
+				m_dropped.fetch_add(p_size, std::memory_order::relaxed);
+				wake();
+				return std::errc::no_buffer_space;
+			}
+			ring_push(*t_ring, t_data, t_remain);
+		}
+		else
+		{
+			uint64_t const t_errors = m_write_errors.load(std::memory_order::acquire);
+			while(true)
+			{
+				uintptr_t const t_free = t_capacity - ring_used(*t_ring);
+				//keeps the data contiguous unless it is larger than the entire ring
+				uintptr_t const t_chunk = std::min(t_remain, t_capacity);
+				if(t_chunk <= t_free)
+				{
+					ring_push(*t_ring, t_data, t_chunk);
+					t_data		+= t_chunk;
+					t_remain	-= t_chunk;
+					if(t_remain == 0) break;
+				}
+				//the file failed to take data since this started waiting, room may never be made
+				if(m_write_errors.load(std::memory_order::acquire) != t_errors)
+				{
+					m_dropped.fetch_add(t_remain, std::memory_order::relaxed);
+					return std::errc::io_error;
+				}
+				wake();
+				thread_yield();
+			}
+		}
+
+		if(ring_used(*t_ring) >= m_flush_bytes)
+		{
+			wake();
+		}
+		return std::errc{};
+	}
+
+	void* file_write_async::reserve(uintptr_t const p_size, uintptr_t const p_alignment)
+	{
+		if(!m_file || p_size == 0) return nullptr;
+
+		_p::file_write_async_ring* const t_ring = bind();
+		if(!t_ring) return nullptr;
+
+		uintptr_t const t_capacity = t_ring->m_mask + 1;
+		uintptr_t const t_start = static_cast<uintptr_t>(t_ring->m_head.load(std::memory_order::relaxed)) & t_ring->m_mask;
+		if(p_size > t_capacity - ring_used(*t_ring) || p_size > t_capacity - t_start) return nullptr;
+		uint8_t* const t_space = t_ring->m_data.get() + t_start;
+		if(reinterpret_cast<uintptr_t>(t_space) & (p_alignment - 1)) return nullptr;
+		return t_space;
+	}
+
+	void file_write_async::commit(uintptr_t const p_size)
+	{
+		if(!m_file || p_size == 0) return;
+
+		//the binding was made by reserve
+		_p::file_write_async_ring* const t_ring = bind();
+		t_ring->m_head.fetch_add(p_size, std::memory_order::seq_cst);
+
+		if(ring_used(*t_ring) >= m_flush_bytes)
+		{
+			wake();
+		}
+	}
+
+	void file_write_async::flush()
+	{
+		if(m_file) drain();
+	}
+
+	void file_write_async::drain()
+	{
+		mutex::scope_locker const drain_lock(m_drain_lock);
+
+		struct pending
+		{
+			_p::file_write_async_ring*	m_ring;
+			uint64_t					m_head;
+		};
+		std::vector<pending> t_pending;
+		{
+			atomic_spinlock::scope_locker const lock(m_lock);
+			t_pending.reserve(m_rings.size());
+			for(_p::file_write_async_ring* const t_ring : m_rings)
+			{
+				t_pending.push_back(pending{t_ring, 0});
+			}
+		}
+
+		m_segments.clear();
+		for(pending& t_item : t_pending)
+		{
+			_p::file_write_async_ring& t_ring = *t_item.m_ring;
+			uint64_t const tail = t_ring.m_tail.load(std::memory_order::relaxed);
+			uint64_t const head = t_ring.m_head.load(std::memory_order::acquire);
+			t_item.m_head = head;
+			if(head == tail) continue;
+
+			uintptr_t const size = static_cast<uintptr_t>(head - tail);
+			uintptr_t const start = static_cast<uintptr_t>(tail) & t_ring.m_mask;
+			uintptr_t const first = std::min(size, t_ring.m_mask + 1 - start);
+			m_segments.emplace_back(t_ring.m_data.get() + start, first);
+			if(first != size)
+			{
+				m_segments.emplace_back(t_ring.m_data.get(), size - first);
+			}
+		}
+
+		if(m_segments.empty()) return;
+
+		uintptr_t t_total = 0;
+		for(std::span<uint8_t const> const& t_segment : m_segments)
+		{
+			t_total += t_segment.size();
+		}
+
+		//on a short write only release what made it to the file, the rest stays queued for the next drain
+		uintptr_t t_written = m_file->write(m_segments);
+		if(t_written != t_total)
+		{
+			m_write_errors.fetch_add(1, std::memory_order::release);
+		}
+
+		for(pending const& t_item : t_pending)
+		{
+			if(t_written == 0) break;
+			uint64_t const tail = t_item.m_ring->m_tail.load(std::memory_order::relaxed);
+			uintptr_t const t_release = std::min(static_cast<uintptr_t>(t_item.m_head - tail), t_written);
+			t_item.m_ring->m_tail.store(tail + t_release, std::memory_order::release);
+			t_written -= t_release;
+		}
+	}
+
+	void file_write_async::flusher(void*)
+	{
+		while(!m_stop.load(std::memory_order::acquire))
+		{
+			if(m_flush_interval)
+			{
+				m_trap.timed_wait(m_flush_interval);
+			}
+			else
+			{
+				m_trap.wait();
+			}
+			m_trap.reset();
+			m_wake.store(false, std::memory_order::seq_cst);
+			drain();
+		}
+	}
+} //namespace core
@@ -0,0 +1,210 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <CoreLib/core_latency.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "core_thread_binding.hpp"
+
+namespace core
+{
+	namespace _p
+	{
+		///	\brief Counters written by a single thread, read by \ref latency_recorder::snapshot
+		struct latency_shard
+		{
+			alignas(64) std::atomic<bool>	m_owned	{false};
+			std::atomic<uint64_t>			m_sum	{0};
+			std::atomic<uint64_t>			m_min	{~uint64_t{0}};
+			std::atomic<uint64_t>			m_max	{0};
+			std::unique_ptr<std::atomic<uint64_t>[]> const m_buckets;
+
+			latency_shard()
+				: m_buckets(new (std::nothrow) std::atomic<uint64_t>[latency_histogram::bucket_count]{})
+			{
+			}
+		};
+
+		///	\brief Shards bound by a thread to the recorders it has used.
+		static thread_local thread_binding_cache<latency_shard> t_latency_cache;
+	} //namespace _p
+
+	namespace
+	{
+		///	\brief Only the owning thread writes, so a plain load and store is enough
+		static inline void shard_add(std::atomic<uint64_t>& p_counter, uint64_t const p_value)
+		{
+			p_counter.store(p_counter.load(std::memory_order::relaxed) + p_value, std::memory_order::relaxed);
+		}
+	} //namespace
+
+	//======== ======== ======== latency_histogram ======== ======== ========
+
+	latency_histogram::latency_histogram()
+		: m_buckets(bucket_count, 0)
+	{
+	}
+
+	void latency_histogram::merge(latency_histogram const& p_other)
+	{
+		for(uintptr_t i = 0; i < bucket_count; ++i)
+		{
+			m_buckets[i] += p_other.m_buckets[i];
+		}
+		m_count	+= p_other.m_count;
+		m_sum	+= p_other.m_sum;
+		m_min	= std::min(m_min, p_other.m_min);
+		m_max	= std::max(m_max, p_other.m_max);
+	}
+
+	void latency_histogram::reset()
+	{
+		std::fill(m_buckets.begin(), m_buckets.end(), uint64_t{0});
+		m_count	= 0;
+		m_sum	= 0;
+		m_min	= ~uint64_t{0};
+		m_max	= 0;
+	}
+
+	uint64_t latency_histogram::percentile(double const p_percentile) const
+	{
+		if(m_count == 0) return 0;
+		if(!(p_percentile > 0.0)) return m_min;
+		if(p_percentile >= 100.0) return m_max;
+
+		uint64_t const rank = std::max(uint64_t{1}, static_cast<uint64_t>(std::ceil(p_percentile / 100.0 * static_cast<double>(m_count))));
+		uint64_t accumulated = 0;
+		for(uintptr_t i = 0; i < bucket_count; ++i)
+		{
+			accumulated += m_buckets[i];
+			if(accumulated >= rank)
+			{
+				return std::clamp(bucket_highest(i), m_min, m_max);
+			}
+		}
+		return m_max;
+	}
+
+	//======== ======== ======== latency_recorder ======== ======== ========
+
+	latency_recorder::latency_recorder()
+		: m_id(_p::owner_registry::instance().add())
+	{
+	}
+
+	latency_recorder::~latency_recorder()
+	{
+		//after this no thread will try to give back its shard
+		_p::owner_registry::instance().remove(m_id);
+		for(_p::latency_shard* const t_shard : m_shards)
+		{
+			delete t_shard;
+		}
+	}
+
+	_p::latency_shard* latency_recorder::bind()
+	{
+		_p::thread_binding_cache<_p::latency_shard>& t_cache = _p::t_latency_cache;
+
+		_p::latency_shard* t_shard = t_cache.find(m_id);
+		if(t_shard) return t_shard;
+
+		t_shard = _p::claim_free_slot(m_lock, m_shards);
+		if(!t_shard)
+		{
+			t_shard = new (std::nothrow) _p::latency_shard;
+			if(!t_shard) return nullptr;
+			if(!t_shard->m_buckets)
+			{
+				delete t_shard;
+				return nullptr;
+			}
+			t_shard->m_owned.store(true, std::memory_order::relaxed);
+			atomic_spinlock::scope_locker const lock(m_lock);
+			m_shards.push_back(t_shard);
+		}
+
+		t_cache.bind(m_id, t_shard);
+		return t_shard;
+	}
+
+	void latency_recorder::record(uint64_t const p_value)
+	{
+		_p::latency_shard* const t_shard = bind();
+		if(!t_shard) return;
+
+		shard_add(t_shard->m_buckets[latency_histogram::bucket_index(p_value)], 1);
+		shard_add(t_shard->m_sum, p_value);
+		if(p_value < t_shard->m_min.load(std::memory_order::relaxed))
+		{
+			t_shard->m_min.store(p_value, std::memory_order::relaxed);
+		}
+		if(p_value > t_shard->m_max.load(std::memory_order::relaxed))
+		{
+			t_shard->m_max.store(p_value, std::memory_order::relaxed);
+		}
+	}
+
+	latency_histogram latency_recorder::snapshot() const
+	{
+		latency_histogram res;
+		atomic_spinlock::scope_locker const lock(m_lock);
+		for(_p::latency_shard const* const t_shard : m_shards)
+		{
+			//the count is taken from the buckets so that percentiles stay consistent while threads record
+			for(uintptr_t i = 0; i < latency_histogram::bucket_count; ++i)
+			{
+				uint64_t const t_value = t_shard->m_buckets[i].load(std::memory_order::relaxed);
+				res.m_buckets[i]	+= t_value;
+				res.m_count			+= t_value;
+			}
+			res.m_sum	+= t_shard->m_sum.load(std::memory_order::relaxed);
+			res.m_min	= std::min(res.m_min, t_shard->m_min.load(std::memory_order::relaxed));
+			res.m_max	= std::max(res.m_max, t_shard->m_max.load(std::memory_order::relaxed));
+		}
+		return res;
+	}
+
+	void latency_recorder::reset()
+	{
+		atomic_spinlock::scope_locker const lock(m_lock);
+		for(_p::latency_shard* const t_shard : m_shards)
+		{
+			for(uintptr_t i = 0; i < latency_histogram::bucket_count; ++i)
+			{
+				t_shard->m_buckets[i].store(0, std::memory_order::relaxed);
+			}
+			t_shard->m_sum	.store(0, std::memory_order::relaxed);
+			t_shard->m_min	.store(~uint64_t{0}, std::memory_order::relaxed);
+			t_shard->m_max	.store(0, std::memory_order::relaxed);
+		}
+	}
+
+} //namespace core
@@ -0,0 +1,466 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <CoreLib/core_profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#	include <cerrno>
+#	include <csignal>
+#	include <cstdlib>
+#	include <ctime>
+#	include <execinfo.h>
+#	include <sys/syscall.h>
+#	include <ucontext.h>
+#	include <unistd.h>
+#endif
+
+#include <CoreLib/core_os.hpp>
+#include <CoreLib/core_stacktrace.hpp>
+#include <CoreLib/string/core_string_numeric.hpp>
+
+namespace core
+{
+	namespace _p
+	{
+		struct profiler_sample
+		{
+			//room for the frames of the signal handler, which are dropped
+			static constexpr uintptr_t handler_frames = 8;
+
+			std::atomic<uint64_t>													m_sequence = 0;	//!< Ticket + 1 once the sample is published
+			uint32_t																m_depth = 0;
+			std::array<void*, sampling_profiler::max_frames + handler_frames>		m_frames;
+
+#ifndef _WIN32
+			static void on_signal(int, siginfo_t*, void* p_context);
+#endif
+		};
+	} //namespace _p
+
+	namespace
+	{
+		static std::atomic<sampling_profiler*>	g_owner		= nullptr;	//!< Profiler that owns SIGPROF
+		static std::atomic<sampling_profiler*>	g_active	= nullptr;	//!< Profiler the signal handler pushes into
+		static std::atomic<uint32_t>			g_in_flight	= 0;		//!< Number of handlers currently running
+
+		static void append_hex(std::u8string& p_out, uint64_t const p_value)
+		{
+			std::array<char8_t, to_chars_hex_max_size_v<uint64_t>> buff;
+			p_out.append(u8"0x");
+			p_out.append(buff.data(), to_chars_hex(p_value, std::span{buff}));
+		}
+
+		static void append_dec(std::u8string& p_out, uint64_t const p_value)
+		{
+			std::array<char8_t, to_chars_dec_max_size_v<uint64_t>> buff;
+			p_out.append(buff.data(), to_chars(p_value, std::span{buff}));
+		}
+
+#ifndef _WIN32
+		static uint64_t current_thread_id()
+		{
+			return static_cast<uint64_t>(syscall(SYS_gettid));
+		}
+
+		static bool thread_exists(uint64_t const p_tid)
+		{
+			return syscall(SYS_tgkill, getpid(), static_cast<pid_t>(p_tid), 0) == 0 || errno != ESRCH;
+		}
+
+		///	\brief Address the thread was executing when it was interrupted
+		static void* interrupted_address(void const* const p_context)
+		{
+			if(!p_context) return nullptr;
+			[[maybe_unused]] ucontext_t const* const t_context = reinterpret_cast<ucontext_t const*>(p_context);
+#if defined(__x86_64__)
+			return reinterpret_cast<void*>(t_context->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+			return reinterpret_cast<void*>(t_context->uc_mcontext.pc);
+#else
+			return nullptr;
+#endif
+		}
+#endif
+	} //namespace
+
+#ifndef _WIN32
+	void _p::profiler_sample::on_signal(int, siginfo_t*, void* const p_context)
+	{
+		int const saved_errno = errno;
+		//seq_cst pairs with stop(), either stop() sees the increment or this sees g_active cleared
+		g_in_flight.fetch_add(1, std::memory_order::seq_cst);
+		sampling_profiler* const profiler = g_active.load(std::memory_order::seq_cst);
+		if(profiler)
+		{
+			profiler->push(p_context);
+		}
+		g_in_flight.fetch_sub(1, std::memory_order::release);
+		errno = saved_errno;
+	}
+#endif
+
+	sampling_profiler::sampling_profiler() = default;
+
+	sampling_profiler::~sampling_profiler()
+	{
+		stop();
+	}
+
+	void sampling_profiler::push([[maybe_unused]] void* const p_context)
+	{
+#ifndef _WIN32
+		//claim a slot, or drop the sample if the collector is a full ring behind
+		uint64_t ticket = m_write.load(std::memory_order::relaxed);
+		do
+		{
+			if(ticket - m_read.load(std::memory_order::acquire) > m_mask)
+			{
+				m_dropped.fetch_add(1, std::memory_order::relaxed);
+				return;
+			}
+		}
+		while(!m_write.compare_exchange_weak(ticket, ticket + 1, std::memory_order::relaxed));
+
+		_p::profiler_sample& slot = m_ring[ticket & m_mask];
+		int const depth = backtrace(slot.m_frames.data(), static_cast<int>(slot.m_frames.size()));
+
+		//skip the frames of the handler, the stack starts at the interrupted address
+		int first = 0;
+		if(void* const pc = interrupted_address(p_context))
+		{
+			for(; first < depth; ++first)
+			{
+				if(slot.m_frames[first] == pc) break;
+			}
+			if(first == depth) first = 0;
+		}
+
+		uint32_t const count = static_cast<uint32_t>(std::min<int>(depth - first, static_cast<int>(max_frames)));
+		std::copy_n(slot.m_frames.data() + first, count, slot.m_frames.data());
+		slot.m_depth = count;
+		slot.m_sequence.store(ticket + 1, std::memory_order::release);
+#endif
+	}
+
+	std::errc sampling_profiler::start([[maybe_unused]] uint32_t const p_frequency, [[maybe_unused]] uintptr_t const p_capacity)
+	{
+#ifdef _WIN32
+		return std::errc::not_supported;
+#else
+		if(p_frequency == 0 || p_frequency > 1000000) return std::errc::invalid_argument;
+
+		sampling_profiler* expected = nullptr;
+		if(!g_owner.compare_exchange_strong(expected, this)) return std::errc::device_or_resource_busy;
+
+		uintptr_t const capacity = std::bit_ceil(std::max<uintptr_t>(p_capacity, 2));
+		if(capacity != m_mask + 1 || !m_ring)
+		{
+			collect();
+			m_ring = std::make_unique<_p::profiler_sample[]>(capacity);
+			m_mask = capacity - 1;
+			m_write.store(0, std::memory_order::relaxed);
+			m_read.store(0, std::memory_order::relaxed);
+		}
+		m_interval_ns = 1000000000 / p_frequency;
+
+		//the first call to backtrace may load libgcc, which allocates, get it out of the way before the first sample
+		{
+			std::array<void*, 1> warmup;
+			backtrace(warmup.data(), 1);
+		}
+
+		g_active.store(this, std::memory_order::release);
+
+		struct sigaction sig_action;
+		sig_action.sa_sigaction = _p::profiler_sample::on_signal;
+		sigemptyset(&sig_action.sa_mask);
+		sig_action.sa_flags = SA_SIGINFO | SA_RESTART;
+		if(sigaction(SIGPROF, &sig_action, nullptr))
+		{
+			g_active.store(nullptr, std::memory_order::release);
+			g_owner.store(nullptr, std::memory_order::release);
+			return std::errc::operation_not_permitted;
+		}
+
+		{
+			atomic_spinlock::scope_locker const lock(m_lock);
+			m_running = true;
+		}
+		return std::errc{};
+#endif
+	}
+
+	void sampling_profiler::stop()
+	{
+#ifndef _WIN32
+		{
+			//cleared under the lock so that no thread can attach after the timers are deleted
+			atomic_spinlock::scope_locker const lock(m_lock);
+			if(!m_running) return;
+			m_running = false;
+			for(std::pair<uint64_t, void*> const& entry: m_timers)
+			{
+				timer_delete(reinterpret_cast<timer_t>(entry.second));
+			}
+			m_timers.clear();
+		}
+
+		g_active.store(nullptr, std::memory_order::seq_cst);
+
+		//a signal from a deleted timer may still be pending, it must not reach the default action
+		struct sigaction sig_action;
+		sig_action.sa_handler = SIG_IGN;
+		sigemptyset(&sig_action.sa_mask);
+		sig_action.sa_flags = 0;
+		sigaction(SIGPROF, &sig_action, nullptr);
+
+		//wait for handlers running on other threads to finish with the ring
+		while(g_in_flight.load(std::memory_order::seq_cst));
+
+		g_owner.store(nullptr, std::memory_order::release);
+#endif
+	}
+
+	std::errc sampling_profiler::attach_thread()
+	{
+#ifdef _WIN32
+		return std::errc::not_supported;
+#else
+		uint64_t const tid = current_thread_id();
+
+		sigevent event{};
+		event.sigev_notify = SIGEV_THREAD_ID;
+		event.sigev_signo = SIGPROF;
+#ifdef sigev_notify_thread_id
+		event.sigev_notify_thread_id = static_cast<pid_t>(tid);
+#else
+		event._sigev_un._tid = static_cast<pid_t>(tid); //older glibc do not expose the field name
+#endif
+
+		timer_t timer;
+		if(timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer))
+		{
+			return static_cast<std::errc>(errno);
+		}
+
+		atomic_spinlock::scope_locker const lock(m_lock);
+		if(!m_running)
+		{
+			timer_delete(timer);
+			return std::errc::operation_not_permitted;
+		}
+
+		//threads that exited without detaching leave their timers behind, and their id may have been reused by this thread
+		std::erase_if(m_timers,
+			[tid](std::pair<uint64_t, void*> const& p_entry)
+			{
+				if(p_entry.first == tid || !thread_exists(p_entry.first))
+				{
+					timer_delete(reinterpret_cast<timer_t>(p_entry.second));
+					return true;
+				}
+				return false;
+			});
+
+		itimerspec spec;
+		spec.it_interval.tv_sec		= static_cast<time_t>(m_interval_ns / 1000000000);
+		spec.it_interval.tv_nsec	= static_cast<long>(m_interval_ns % 1000000000);
+		spec.it_value = spec.it_interval;
+		if(timer_settime(timer, 0, &spec, nullptr))
+		{
+			std::errc const error = static_cast<std::errc>(errno);
+			timer_delete(timer);
+			return error;
+		}
+
+		m_timers.emplace_back(tid, reinterpret_cast<void*>(timer));
+		return std::errc{};
+#endif
+	}
+
+	void sampling_profiler::detach_thread()
+	{
+#ifndef _WIN32
+		uint64_t const tid = current_thread_id();
+
+		atomic_spinlock::scope_locker const lock(m_lock);
+		auto const it = std::find_if(m_timers.begin(), m_timers.end(),
+			[tid](std::pair<uint64_t, void*> const& p_entry) { return p_entry.first == tid; });
+		if(it != m_timers.end())
+		{
+			timer_delete(reinterpret_cast<timer_t>(it->second));
+			m_timers.erase(it);
+		}
+#endif
+	}
+
+	uintptr_t sampling_profiler::collect()
+	{
+		if(!m_ring) return 0;
+
+		uintptr_t count = 0;
+		uint64_t read = m_read.load(std::memory_order::relaxed);
+		std::vector<uintptr_t> stack;
+		while(true)
+		{
+			_p::profiler_sample const& slot = m_ring[read & m_mask];
+			if(slot.m_sequence.load(std::memory_order::acquire) != read + 1) break;
+
+			stack.resize(slot.m_depth);
+			std::transform(slot.m_frames.data(), slot.m_frames.data() + slot.m_depth, stack.begin(),
+				[](void* const p_frame) { return reinterpret_cast<uintptr_t>(p_frame); });
+			++m_stacks[stack];
+
+			m_read.store(++read, std::memory_order::release);
+			++count;
+		}
+		m_samples += count;
+		return count;
+	}
+
+	std::u8string sampling_profiler::folded([[maybe_unused]] bool const p_names)
+	{
+		collect();
+
+		//module bases, sorted, with the file name of each module
+		std::vector<std::pair<uintptr_t, std::u8string>> modules;
+		{
+			std::list<ModuleAddr> t_list;
+			list_modules(t_list);
+			for(ModuleAddr const& module: t_list)
+			{
+				std::filesystem::path const path = module.m_name.empty() ? application_path() : std::filesystem::path{module.m_name};
+				modules.emplace_back(module.m_addr, path.filename().u8string());
+			}
+			std::sort(modules.begin(), modules.end(),
+				[](std::pair<uintptr_t, std::u8string> const& p_1, std::pair<uintptr_t, std::u8string> const& p_2) { return p_1.first < p_2.first; });
+		}
+
+		//return addresses point past the call, step back into it
+		auto const lookup_address = [](uintptr_t const p_addr, bool const p_leaf) { return p_leaf ? p_addr : p_addr - 1; };
+
+		std::map<uintptr_t, std::u8string> symbols;
+#ifndef _WIN32
+		if(p_names)
+		{
+			for(std::pair<std::vector<uintptr_t> const, uint64_t> const& entry: m_stacks)
+			{
+				for(uintptr_t index = 0; index < entry.first.size(); ++index)
+				{
+					symbols.try_emplace(lookup_address(entry.first[index], index == 0));
+				}
+			}
+
+			std::vector<uintptr_t> addresses;
+			addresses.reserve(symbols.size());
+			for(std::pair<uintptr_t const, std::u8string> const& symbol: symbols)
+			{
+				addresses.push_back(symbol.first);
+			}
+
+			std::vector<std::u8string> names;
+			if(resolve_symbols(addresses, names) == std::errc{})
+			{
+				auto name = names.begin();
+				for(std::pair<uintptr_t const, std::u8string>& symbol: symbols)
+				{
+					//';' separates frames in the folded format
+					std::replace(name->begin(), name->end(), u8';', u8':');
+					symbol.second = std::move(*name++);
+				}
+			}
+		}
+#endif
+
+		std::map<std::pair<uintptr_t, bool>, std::u8string> frame_names;
+		auto const frame_name = [&](uintptr_t const p_addr, bool const p_leaf) -> std::u8string const&
+		{
+			auto const [it, inserted] = frame_names.try_emplace(std::pair{p_addr, p_leaf});
+			if(!inserted) return it->second;
+
+			std::u8string& name = it->second;
+			auto const symbol = symbols.find(lookup_address(p_addr, p_leaf));
+			if(symbol != symbols.end() && !symbol->second.empty())
+			{
+				name = symbol->second;
+				return name;
+			}
+
+			auto const module = std::upper_bound(modules.begin(), modules.end(), p_addr,
+				[](uintptr_t const p_value, std::pair<uintptr_t, std::u8string> const& p_module) { return p_value < p_module.first; });
+			if(module == modules.begin())
+			{
+				append_hex(name, p_addr);
+			}
+			else
+			{
+				std::pair<uintptr_t, std::u8string> const& base = *std::prev(module);
+				name.append(base.second);
+				name.push_back(u8'+');
+				append_hex(name, p_addr - base.first);
+			}
+			return name;
+		};
+
+		std::u8string out;
+		for(std::pair<std::vector<uintptr_t> const, uint64_t> const& entry: m_stacks)
+		{
+			std::vector<uintptr_t> const& stack = entry.first;
+			if(stack.empty()) continue;
+			for(uintptr_t index = stack.size(); index--;)
+			{
+				out.append(frame_name(stack[index], index == 0));
+				out.push_back(index ? u8';' : u8' ');
+			}
+			append_dec(out, entry.second);
+			out.push_back(u8'\n');
+		}
+		return out;
+	}
+
+	void sampling_profiler::reset()
+	{
+		collect();
+		m_stacks.clear();
+		m_samples = 0;
+		m_dropped.store(0, std::memory_order::relaxed);
+	}
+
+} //namespace core
@@ -40,7 +40,20 @@
 #	include <link.h>
 #	include <cstring>
 #	include <sys/utsname.h>
+#	include <sys/syscall.h>
+#	include <fcntl.h>
+#	include <time.h>
+#	include <elf.h>
+#	include <cxxabi.h>
+#	include <algorithm>
+#	include <atomic>
+#	include <map>
+#	include <optional>
+#	include <span>
+#	include <vector>
 #	include <CoreLib/core_extra_compiler.hpp>
+#	include <CoreLib/toPrint/toPrint_time.hpp>
+#	include <CoreLib/toPrint/toPrint_string_sink.hpp>
 #endif
 
 #include <CoreLib/core_os.hpp>
@@ -938,6 +951,30 @@ namespace
 		OUTPUT(p_file, '\n');
 	}
 
+	///	\brief Gets the address where the crash occurred from the signal context
+	static void const* critical_address(void const* const context)
+	{
+		if(!context)
+		{
+			return nullptr;
+		}
+
+		[[maybe_unused]] ucontext_t const* t_context = reinterpret_cast<ucontext_t const*>(context);
+		static_assert(sizeof(struct sigcontext) == sizeof(decltype(t_context->uc_mcontext)));
+		static_assert(alignof(struct sigcontext) == alignof(decltype(t_context->uc_mcontext)));
+#if defined(__i386__) // gcc specific
+		return reinterpret_cast<void const*>(reinterpret_cast<struct sigcontext const&>(t_context->uc_mcontext).eip);
+#elif defined(__x86_64__) // gcc specific
+		return reinterpret_cast<void const*>(reinterpret_cast<struct sigcontext const&>(t_context->uc_mcontext).rip);
+#elif defined(__aarch64__) // gcc specific
+		return reinterpret_cast<void const*>(reinterpret_cast<struct sigcontext const&>(t_context->uc_mcontext).pc);
+#elif defined(__ppc__) || defined(__powerpc__)
+		return reinterpret_cast<void const*>(reinterpret_cast<struct sigcontext const&>(t_context->uc_mcontext).nip); //probably wrong
+#else
+		return nullptr;
+#endif
+	}
+
 	///	\brief	This function performs all tasks related to printing the stack trace information.
 	///	\details
 	///			If the stack trace service is registered, the system will call this function when
@@ -993,23 +1030,7 @@ namespace
 						, toPrint_fix_2{t_time.time.second}, '.',
 						toPrint_fix_3{static_cast<uint16_t>(t_time.time.nsecond/1000000)}, '\n');
 
-					void const* t_criticalAddr = nullptr;	// the address were the crash occurred
-
-					if(context)
-					{
-						[[maybe_unused]] ucontext_t const* t_context = reinterpret_cast<ucontext_t const*>(context);
-						static_assert(sizeof(struct sigcontext) == sizeof(decltype(t_context->uc_mcontext)));
-						static_assert(alignof(struct sigcontext) == alignof(decltype(t_context->uc_mcontext)));
-#if defined(__i386__) // gcc specific
-						t_criticalAddr = reinterpret_cast<void const*>(reinterpret_cast<struct sigcontext const&>(t_context->uc_mcontext).eip);
-#elif defined(__x86_64__) // gcc specific
-						t_criticalAddr = reinterpret_cast<void const*>(reinterpret_cast<struct sigcontext const&>(t_context->uc_mcontext).rip);
-#elif defined(__aarch64__) // gcc specific
-						t_criticalAddr = reinterpret_cast<void const*>(reinterpret_cast<struct sigcontext const&>(t_context->uc_mcontext).pc);
-#elif defined(__ppc__) || defined(__powerpc__)
-						t_criticalAddr = reinterpret_cast<void const*>(reinterpret_cast<struct sigcontext const&>(t_context->uc_mcontext).nip); //probably wrong
-#endif
-					}
+					void const* const t_criticalAddr = critical_address(context);	// the address were the crash occurred
 
 					OUTPUT(o_file,
 						"Sig:     0x"sv, toPrint_hex_fix{static_cast<uint32_t>(sig)}, //the signal that caused the crash
@@ -1146,6 +1167,196 @@ namespace
 		//_exit(EXIT_FAILURE);
 		_Exit(EXIT_FAILURE); //just in case this handler is called multiple times
 	}
+
+	static constexpr std::string_view raw_trace_magic = "CoreLib raw crash trace 1"sv;
+
+	///	\brief State of the raw crash trace, allocated up front so that the handler does not need to
+	class Raw_Trace_State
+	{
+	public:
+		static constexpr uintptr_t max_frames = 256;
+
+		std::array<char, PATH_MAX>			m_path;		//!< Null terminated output file path
+		std::array<void*, max_frames>		m_frames;
+		std::array<char, 4096>				m_buffer;	//!< Output staging buffer
+		std::atomic<pid_t>					m_owner = 0;	//!< Thread id of the thread writing the trace, 0 if none
+	};
+
+	static Raw_Trace_State g_raw_trace;
+
+	///	\brief Buffered writer that only uses async-signal-safe calls
+	class raw_writer
+	{
+	public:
+		raw_writer(int const p_fd, std::span<char> const p_buffer): m_fd{p_fd}, m_buffer{p_buffer} {}
+		~raw_writer() { flush(); }
+
+		void put(std::string_view const p_text)
+		{
+			for(char const tchar: p_text)
+			{
+				if(m_used == m_buffer.size()) flush();
+				m_buffer[m_used++] = tchar;
+			}
+		}
+
+		void put_hex(uintptr_t const p_value)
+		{
+			std::array<char, to_chars_hex_max_size_v<uintptr_t>> buff;
+			put("0x"sv);
+			put(std::string_view{buff.data(), to_chars_hex(p_value, std::span{buff})});
+		}
+
+		void put_dec(uint64_t const p_value)
+		{
+			std::array<char, to_chars_dec_max_size_v<uint64_t>> buff;
+			put(std::string_view{buff.data(), to_chars(p_value, std::span{buff})});
+		}
+
+		void flush()
+		{
+			char const* pivot = m_buffer.data();
+			while(m_used)
+			{
+				ssize_t const res = ::write(m_fd, pivot, m_used);
+				if(res < 0)
+				{
+					if(errno == EINTR) continue;
+					break;
+				}
+				pivot += res;
+				m_used -= static_cast<uintptr_t>(res);
+			}
+			m_used = 0;
+		}
+
+	private:
+		int const m_fd;
+		std::span<char> const m_buffer;
+		uintptr_t m_used = 0;
+	};
+
+	///	\brief Copies a file to the writer, used for /proc/self/maps
+	static void copy_file(char const* const p_path, raw_writer& p_out)
+	{
+		int const fd = ::open(p_path, O_RDONLY | O_CLOEXEC);
+		if(fd < 0) return;
+
+		std::array<char, 1024> buff;
+		while(true)
+		{
+			ssize_t const res = ::read(fd, buff.data(), buff.size());
+			if(res < 0 && errno == EINTR) continue;
+			if(res <= 0) break;
+			p_out.put(std::string_view{buff.data(), static_cast<uintptr_t>(res)});
+		}
+		::close(fd);
+	}
+
+	///	\brief	Signal handler of \ref register_crash_trace_raw
+	///	\details
+	///			Only async-signal-safe functions are called, all buffers are preallocated.
+	///			backtrace is warmed up during registration, so that it does not need to load libgcc here.
+	///	\note The file format is read by \ref symbolize_crash_trace, keep both in sync
+	static void Linux_raw_exception_handler(int const sig, siginfo_t* const siginfo, void* const context)
+	{
+		pid_t const this_tid = static_cast<pid_t>(syscall(SYS_gettid));
+		pid_t owner = 0;
+		if(g_raw_trace.m_owner.compare_exchange_strong(owner, this_tid))
+		{
+			//handlers stay installed while the trace is written, so that other crashing threads park below
+			//instead of killing the process half way through the file
+			int const fd = ::open(g_raw_trace.m_path.data(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+			if(fd >= 0)
+			{
+				uintptr_t const t_criticalAddr = reinterpret_cast<uintptr_t>(critical_address(context));
+				timespec t_time{};
+				clock_gettime(CLOCK_REALTIME, &t_time);
+
+				raw_writer out{fd, g_raw_trace.m_buffer};
+				out.put(raw_trace_magic);
+				out.put("\nsig "sv);		out.put_dec(static_cast<uint32_t>(sig));
+				out.put("\ncode "sv);		out.put_dec(static_cast<uint32_t>(siginfo->si_code));
+				out.put("\naddr "sv);		out.put_hex(t_criticalAddr);
+				out.put("\npid "sv);		out.put_dec(static_cast<uint64_t>(getpid()));
+				out.put("\ntid "sv);		out.put_dec(static_cast<uint64_t>(this_tid));
+				out.put("\ntime "sv);		out.put_dec(static_cast<uint64_t>(t_time.tv_sec));
+				out.put("."sv);				out.put_dec(static_cast<uint64_t>(t_time.tv_nsec));
+				out.put("\nframes\n"sv);
+				out.flush(); //in case the stack walk crashes
+
+				int const trace_size = backtrace(g_raw_trace.m_frames.data(), static_cast<int>(g_raw_trace.m_frames.size()));
+
+				//skip the frames of the handler itself
+				int i = 0;
+				if(t_criticalAddr)
+				{
+					for(; i < trace_size; ++i)
+					{
+						if(reinterpret_cast<uintptr_t>(g_raw_trace.m_frames[i]) == t_criticalAddr) break;
+					}
+					if(i >= trace_size) i = 0;
+				}
+
+				for(; i < trace_size; ++i)
+				{
+					out.put_hex(reinterpret_cast<uintptr_t>(g_raw_trace.m_frames[i]));
+					out.put("\n"sv);
+				}
+
+				out.put("maps\n"sv);
+				copy_file("/proc/self/maps", out);
+				out.flush();
+				::close(fd);
+			}
+		}
+		else if(owner != this_tid)
+		{
+			//another thread is writing the trace and will end the process once it is done
+			while(true) pause();
+		}
+
+		//either the trace is done or writing it crashed, abort with the default handlers to get a core dump
+		signal(SIGILL,	SIG_DFL);
+		signal(SIGABRT,	SIG_DFL);
+		signal(SIGFPE,	SIG_DFL);
+		signal(SIGSEGV,	SIG_DFL);
+		sigset_t abort_set;
+		sigemptyset(&abort_set);
+		sigaddset(&abort_set, SIGABRT);
+		pthread_sigmask(SIG_UNBLOCK, &abort_set, nullptr); //in case we are handling a SIGABRT
+		raise(SIGABRT);
+		_Exit(EXIT_FAILURE);
+	}
+
+	///	\brief Sets up the alternate signal stack and hooks the crash signals to p_handler
+	static bool install_crash_handler(void (* const p_handler)(int, siginfo_t*, void*))
+	{
+		//======== IMPORTANT ========
+		//this sets up an alternative stack to run on when we are doing our stack trace
+		//see article:https://spin.atomicobject.com/2013/01/13/exceptions-stack-traces-c/
+		stack_t ss;
+		ss.ss_sp	= reinterpret_cast<void*>(Except_stack.data());
+		ss.ss_size	= Except_stack.size();
+		ss.ss_flags	= 0;
+		if (sigaltstack(&ss, nullptr)) return false;
+
+		//initializes the parameters that we are going to use to hijack the signals
+		struct sigaction sig_action;
+		sig_action.sa_sigaction = p_handler;
+		sigemptyset(&sig_action.sa_mask);
+		sig_action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+
+		if(	sigaction(SIGILL,  &sig_action, nullptr) ||
+			sigaction(SIGABRT, &sig_action, nullptr) ||
+			sigaction(SIGFPE,  &sig_action, nullptr) ||
+			sigaction(SIGSEGV, &sig_action, nullptr) )
+		{
+			return false;
+		}
+
+		return true;
+	}
 } //namespace
 
 bool register_crash_trace(std::filesystem::path const& p_output_file)
@@ -1159,30 +1370,28 @@ bool register_crash_trace(std::filesystem::path const& p_output_file)
 		g_straceOpt.m_output_file = (application_path().parent_path() / p_output_file).lexically_normal();
 	}
 
-	//======== IMPORTANT ========
-	//this sets up an alternative stack to run on when we are doing our stack trace
-	//see article:https://spin.atomicobject.com/2013/01/13/exceptions-stack-traces-c/
-	stack_t ss;
-	ss.ss_sp	= reinterpret_cast<void*>(Except_stack.data());
-	ss.ss_size	= SIGSTKSZ;
-	ss.ss_flags	= 0;
-	if (sigaltstack(&ss, nullptr)) return false;
-
-	//initializes the parameters that we are going to use to hijack the signals
-	struct sigaction sig_action;
-	sig_action.sa_sigaction = Linux_exception_handler;
-	sigemptyset(&sig_action.sa_mask);
-	sig_action.sa_flags = SA_SIGINFO | SA_ONSTACK;
-
-	if(	sigaction(SIGILL,  &sig_action, nullptr) ||
-		sigaction(SIGABRT, &sig_action, nullptr) ||
-		sigaction(SIGFPE,  &sig_action, nullptr) ||
-		sigaction(SIGSEGV, &sig_action, nullptr) )
+	return install_crash_handler(Linux_exception_handler);
+}
+
+bool register_crash_trace_raw(std::filesystem::path const& p_output_file)
+{
+	std::filesystem::path const path = p_output_file.is_absolute() ?
+		p_output_file.lexically_normal() :
+		(application_path().parent_path() / p_output_file).lexically_normal();
+
+	std::string const& native = path.native();
+	if(native.size() >= g_raw_trace.m_path.size()) return false;
+	memcpy(g_raw_trace.m_path.data(), native.c_str(), native.size() + 1);
+
 	{
-		return false;
+		std::error_code ec;
+		std::filesystem::create_directories(path.parent_path(), ec);
 	}
 
-	return true;
+	//the first call to backtrace may load libgcc, which allocates, get it out of the way before a crash
+	backtrace(g_raw_trace.m_frames.data(), 1);
+
+	return install_crash_handler(Linux_raw_exception_handler);
 }
 
 uint8_t list_modules(std::list<ModuleAddr>& p_list)
@@ -1383,6 +1592,404 @@ uint8_t stack_trace(std::list<uintptr_t>& p_trace)
 	return 2;
 }
 
+namespace
+{
+	///	\brief Function symbols of an ELF file, used to resolve raw crash traces
+	class elf_symbols
+	{
+	private:
+		struct load_segment
+		{
+			uint64_t m_offset;
+			uint64_t m_size;
+			uint64_t m_vaddr;
+		};
+
+	public:
+		struct symbol
+		{
+			uint64_t			m_addr;
+			uint64_t			m_size;
+			std::string_view	m_name;
+		};
+
+	public:
+		bool load(std::filesystem::path const& p_path)
+		{
+			{
+				file_read t_file;
+				if(t_file.open(p_path) != std::errc{}) return false;
+				int64_t const t_size = t_file.size();
+				if(t_size < static_cast<int64_t>(sizeof(Elf64_Ehdr))) return false;
+				m_data.resize(static_cast<uintptr_t>(t_size));
+				if(t_file.read_unlocked(m_data.data(), m_data.size()) != m_data.size()) return false;
+			}
+
+			Elf64_Ehdr header;
+			memcpy(&header, m_data.data(), sizeof(header));
+			if(memcmp(header.e_ident, ELFMAG, SELFMAG) || header.e_ident[EI_CLASS] != ELFCLASS64) return false;
+
+			for(uint16_t i = 0; i < header.e_phnum; ++i)
+			{
+				Elf64_Phdr segment;
+				if(!read_at(header.e_phoff + uint64_t{i} * header.e_phentsize, segment)) return false;
+				if(segment.p_type == PT_LOAD)
+				{
+					m_loads.push_back(load_segment{segment.p_offset, segment.p_filesz, segment.p_vaddr});
+				}
+			}
+
+			std::vector<Elf64_Shdr> sections(header.e_shnum);
+			for(uint16_t i = 0; i < header.e_shnum; ++i)
+			{
+				if(!read_at(header.e_shoff + uint64_t{i} * header.e_shentsize, sections[i])) return false;
+			}
+
+			//prefer the full symbol table, the dynamic one only has exported symbols
+			if(!load_symbols(sections, SHT_SYMTAB))
+			{
+				load_symbols(sections, SHT_DYNSYM);
+			}
+
+			std::sort(m_symbols.begin(), m_symbols.end(),
+				[](symbol const& p_1, symbol const& p_2) { return p_1.m_addr < p_2.m_addr; });
+			return true;
+		}
+
+		///	\brief Converts an offset in the file to its link time virtual address
+		[[nodiscard]] std::optional<uint64_t> to_vaddr(uint64_t const p_offset) const
+		{
+			for(load_segment const& segment: m_loads)
+			{
+				if(p_offset >= segment.m_offset && p_offset - segment.m_offset < segment.m_size)
+				{
+					return p_offset - segment.m_offset + segment.m_vaddr;
+				}
+			}
+			return {};
+		}
+
+		[[nodiscard]] symbol const* find(uint64_t const p_vaddr) const
+		{
+			auto const it = std::upper_bound(m_symbols.begin(), m_symbols.end(), p_vaddr,
+				[](uint64_t const p_addr, symbol const& p_symbol) { return p_addr < p_symbol.m_addr; });
+			if(it == m_symbols.begin()) return nullptr;
+			symbol const& candidate = *std::prev(it);
+			if(candidate.m_size && p_vaddr - candidate.m_addr >= candidate.m_size) return nullptr;
+			return &candidate;
+		}
+
+	private:
+		template<typename T>
+		bool read_at(uint64_t const p_offset, T& p_out) const
+		{
+			if(p_offset > m_data.size() || m_data.size() - p_offset < sizeof(T)) return false;
+			memcpy(&p_out, m_data.data() + p_offset, sizeof(T));
+			return true;
+		}
+
+		bool load_symbols(std::vector<Elf64_Shdr> const& p_sections, uint32_t const p_type)
+		{
+			bool found = false;
+			for(Elf64_Shdr const& section: p_sections)
+			{
+				if(section.sh_type != p_type || section.sh_link >= p_sections.size() || section.sh_entsize < sizeof(Elf64_Sym)) continue;
+				Elf64_Shdr const& strings = p_sections[section.sh_link];
+				if(strings.sh_offset > m_data.size() || m_data.size() - strings.sh_offset < strings.sh_size) continue;
+
+				char const* const string_table = m_data.data() + strings.sh_offset;
+				uint64_t const count = section.sh_size / section.sh_entsize;
+				for(uint64_t i = 0; i < count; ++i)
+				{
+					Elf64_Sym entry;
+					if(!read_at(section.sh_offset + i * section.sh_entsize, entry)) break;
+
+					uint8_t const type = ELF64_ST_TYPE(entry.st_info);
+					if((type != STT_FUNC && type != STT_GNU_IFUNC) || entry.st_shndx == SHN_UNDEF || entry.st_value == 0) continue;
+					if(entry.st_name >= strings.sh_size) continue;
+
+					char const* const name = string_table + entry.st_name;
+					m_symbols.push_back(symbol{entry.st_value, entry.st_size, std::string_view{name, strnlen(name, strings.sh_size - entry.st_name)}});
+				}
+				found = true;
+			}
+			return found && !m_symbols.empty();
+		}
+
+	private:
+		std::vector<char>			m_data;
+		std::vector<load_segment>	m_loads;
+		std::vector<symbol>			m_symbols;
+	};
+
+	///	\brief One line of /proc/self/maps
+	struct map_entry
+	{
+		uint64_t			m_begin;
+		uint64_t			m_end;
+		uint64_t			m_offset;
+		std::u8string_view	m_path;
+	};
+
+	///	\brief Splits off the next token delimited by p_delim
+	static std::u8string_view next_token(std::u8string_view& p_line, char8_t const p_delim)
+	{
+		uintptr_t const pos = p_line.find(p_delim);
+		std::u8string_view const token = p_line.substr(0, pos);
+		p_line = pos == std::u8string_view::npos ? std::u8string_view{} : p_line.substr(pos + 1);
+		return token;
+	}
+
+	static std::optional<uint64_t> parse_hex(std::u8string_view p_text)
+	{
+		if(p_text.starts_with(u8"0x")) p_text.remove_prefix(2);
+		from_chars_result<uint64_t> const res = from_chars_hex<uint64_t>(p_text);
+		if(!res.has_value()) return {};
+		return res.value();
+	}
+
+	static std::optional<uint64_t> parse_dec(std::u8string_view const p_text)
+	{
+		from_chars_result<uint64_t> const res = from_chars<uint64_t>(p_text);
+		if(!res.has_value()) return {};
+		return res.value();
+	}
+
+	static std::optional<map_entry> parse_map_line(std::u8string_view p_line)
+	{
+		std::u8string_view range = next_token(p_line, u8' ');
+		std::optional<uint64_t> const begin = parse_hex(next_token(range, u8'-'));
+		std::optional<uint64_t> const end = parse_hex(range);
+		next_token(p_line, u8' '); //permissions
+		std::optional<uint64_t> const offset = parse_hex(next_token(p_line, u8' '));
+		next_token(p_line, u8' '); //device
+		next_token(p_line, u8' '); //inode
+
+		if(!begin.has_value() || !end.has_value() || !offset.has_value()) return {};
+
+		uintptr_t const first = p_line.find_first_not_of(u8' ');
+		p_line = first == std::u8string_view::npos ? std::u8string_view{} : p_line.substr(first);
+		return map_entry{begin.value(), end.value(), offset.value(), p_line};
+	}
+
+	static std::u8string demangle(std::string_view const p_name)
+	{
+		std::string const name{p_name};
+		int status = 0;
+		char* const res = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+		if(status == 0 && res)
+		{
+			std::u8string out{reinterpret_cast<char8_t const*>(res)};
+			free(res);
+			return out;
+		}
+		free(res);
+		return std::u8string{reinterpret_cast<char8_t const*>(p_name.data()), p_name.size()};
+	}
+
+	///	\brief Resolves addresses to function symbols, using a module map and the ELF files it refers to
+	class module_symbolizer
+	{
+	public:
+		module_symbolizer(std::vector<map_entry>&& p_maps): m_maps{std::move(p_maps)} {}
+
+		[[nodiscard]] std::vector<map_entry> const& maps() const { return m_maps; }
+
+		[[nodiscard]] map_entry const* find_map(uint64_t const p_addr) const
+		{
+			auto const entry = std::find_if(m_maps.begin(), m_maps.end(),
+				[p_addr](map_entry const& p_entry) { return p_addr >= p_entry.m_begin && p_addr < p_entry.m_end; });
+			return entry == m_maps.end() ? nullptr : &*entry;
+		}
+
+		///	\brief Function containing p_addr, which must belong to p_map
+		///	\param[out] p_offset - offset of p_addr into the function
+		///	\return nullptr if not found
+		elf_symbols::symbol const* find_symbol(map_entry const& p_map, uint64_t const p_addr, uint64_t& p_offset)
+		{
+			auto module = m_modules.find(p_map.m_path);
+			if(module == m_modules.end())
+			{
+				module = m_modules.emplace(p_map.m_path, elf_symbols{}).first;
+				module->second.load(std::filesystem::path{p_map.m_path});
+			}
+
+			std::optional<uint64_t> const vaddr = module->second.to_vaddr(p_addr - p_map.m_begin + p_map.m_offset);
+			if(!vaddr.has_value()) return nullptr;
+			elf_symbols::symbol const* const t_symbol = module->second.find(vaddr.value());
+			if(t_symbol) p_offset = vaddr.value() - t_symbol->m_addr;
+			return t_symbol;
+		}
+
+	private:
+		std::vector<map_entry>						m_maps;
+		std::map<std::u8string_view, elf_symbols>	m_modules;
+	};
+
+	///	\brief Parses the file backed entries of a module map
+	static std::vector<map_entry> parse_maps(std::u8string_view p_maps)
+	{
+		std::vector<map_entry> maps;
+		while(!p_maps.empty())
+		{
+			std::optional<map_entry> const entry = parse_map_line(next_token(p_maps, u8'\n'));
+			if(entry.has_value() && !entry.value().m_path.empty() && entry.value().m_path.front() == u8'/')
+			{
+				maps.push_back(entry.value());
+			}
+		}
+		return maps;
+	}
+
+	template<typename... Args>
+	static void append_print(std::u8string& p_output, Args const&... p_args)
+	{
+		std::u8string temp;
+		core::print<char8_t>(temp, p_args...);
+		p_output.append(temp);
+	}
+} //namespace
+
+std::errc symbolize_crash_trace(std::u8string_view p_trace, std::u8string& p_output)
+{
+	p_output.clear();
+
+	std::u8string_view line = next_token(p_trace, u8'\n');
+	if(line != std::u8string_view{reinterpret_cast<char8_t const*>(raw_trace_magic.data()), raw_trace_magic.size()})
+	{
+		return std::errc::invalid_argument;
+	}
+
+	std::string_view section_seperator = "-------- -------- -------- --------\n";
+	append_print(p_output, section_seperator);
+
+	//---- header
+	while(!p_trace.empty())
+	{
+		line = next_token(p_trace, u8'\n');
+		if(line == u8"frames") break;
+
+		std::u8string_view const key = next_token(line, u8' ');
+		if(key == u8"time")
+		{
+			std::optional<uint64_t> const seconds = parse_dec(next_token(line, u8'.'));
+			std::optional<uint64_t> const nsecond = parse_dec(line);
+			if(seconds.has_value() && nsecond.has_value())
+			{
+				//100ns units since 1601, as used by time_point_t
+				constexpr uint64_t unix_epoch = 116444736000000000;
+				time_point_t const t_time{seconds.value() * 10000000 + nsecond.value() / 100 + unix_epoch};
+				append_print(p_output, "Time:    "sv, toPrint_iso8601{t_time, 3}, '\n');
+			}
+		}
+		else if(key == u8"sig")
+		{
+			append_print(p_output, "Sig:     0x"sv, toPrint_hex_fix{static_cast<uint32_t>(parse_dec(line).value_or(0))}, '\n');
+		}
+		else if(key == u8"code")
+		{
+			append_print(p_output, "Code:    0x"sv, toPrint_hex_fix{static_cast<uint32_t>(parse_dec(line).value_or(0))}, '\n');
+		}
+		else if(key == u8"addr")
+		{
+			append_print(p_output, "Address: "sv, line, '\n');
+		}
+		else if(key == u8"pid")
+		{
+			append_print(p_output, "Proc:    "sv, line, '\n');
+		}
+		else if(key == u8"tid")
+		{
+			append_print(p_output, "Thread:  "sv, line, '\n');
+		}
+	}
+
+	//---- frames, resolved after the module map is known
+	std::vector<uint64_t> frames;
+	while(!p_trace.empty())
+	{
+		line = next_token(p_trace, u8'\n');
+		if(line == u8"maps") break;
+		std::optional<uint64_t> const addr = parse_hex(line);
+		if(addr.has_value()) frames.push_back(addr.value());
+	}
+
+	module_symbolizer symbolizer{parse_maps(p_trace)};
+
+	//---- Module list
+	append_print(p_output, section_seperator, "Modules:\n"sv);
+	std::map<std::u8string_view, uint64_t> bases;
+	for(map_entry const& entry: symbolizer.maps())
+	{
+		if(bases.emplace(entry.m_path, entry.m_begin - entry.m_offset).second)
+		{
+			append_print(p_output, reinterpret_cast<void const*>(entry.m_begin - entry.m_offset), " \""sv, entry.m_path, "\"\n"sv);
+		}
+	}
+
+	//---- Stack
+	append_print(p_output, section_seperator, "Stack:\n"sv);
+	for(uintptr_t index = 0; index < frames.size(); ++index)
+	{
+		uint64_t const addr = frames[index];
+		//return addresses point past the call, step back into it, except for the address that crashed
+		uint64_t const lookup = index ? addr - 1 : addr;
+
+		map_entry const* const entry = symbolizer.find_map(lookup);
+		if(!entry)
+		{
+			append_print(p_output, reinterpret_cast<void const*>(addr), '\n');
+			continue;
+		}
+
+		uint64_t const base = bases[entry->m_path];
+		append_print(p_output, reinterpret_cast<void const*>(base), '+', toPrint_hex{addr - base}, ' ', entry->m_path);
+
+		uint64_t offset = 0;
+		elf_symbols::symbol const* const t_symbol = symbolizer.find_symbol(*entry, lookup, offset);
+		if(t_symbol)
+		{
+			append_print(p_output, ' ', demangle(t_symbol->m_name), "+0x"sv, toPrint_hex{offset + (addr - lookup)});
+		}
+		p_output.push_back(u8'\n');
+	}
+	append_print(p_output, section_seperator);
+
+	return std::errc{};
+}
+
+std::errc resolve_symbols(std::span<uintptr_t const> const p_addresses, std::vector<std::u8string>& p_names)
+{
+	p_names.clear();
+
+	std::u8string raw_maps;
+	{
+		file_read t_file;
+		if(t_file.open("/proc/self/maps") != std::errc{}) return std::errc::no_such_file_or_directory;
+		//files in /proc report a size of 0, read until the end instead
+		std::array<char8_t, 4096> buff;
+		for(uintptr_t res = t_file.read_unlocked(buff.data(), buff.size()); res; res = t_file.read_unlocked(buff.data(), buff.size()))
+		{
+			raw_maps.append(buff.data(), res);
+		}
+	}
+
+	module_symbolizer symbolizer{parse_maps(raw_maps)};
+	p_names.resize(p_addresses.size());
+	for(uintptr_t index = 0; index < p_addresses.size(); ++index)
+	{
+		map_entry const* const entry = symbolizer.find_map(p_addresses[index]);
+		if(!entry) continue;
+		uint64_t offset = 0;
+		elf_symbols::symbol const* const t_symbol = symbolizer.find_symbol(*entry, p_addresses[index], offset);
+		if(t_symbol)
+		{
+			p_names[index] = demangle(t_symbol->m_name);
+		}
+	}
+	return std::errc{};
+}
+
 uint8_t generate_coredump()
 {
 	pid_t t_pid = fork();
@@ -527,7 +527,7 @@ SYNC_Error event_trap::timed_wait(uint32_t const p_miliseconds)
 	int ret;
 	clock_gettime(CLOCK_MONOTONIC, &end);
 
-	counter = (end.tv_sec + 5) * 1000000000 + p_miliseconds * 1000000 + end.tv_nsec;
+	counter = static_cast<uint64_t>(end.tv_sec) * 1000000000 + static_cast<uint64_t>(p_miliseconds) * 1000000 + static_cast<uint64_t>(end.tv_nsec);
 
 	end.tv_sec	= counter / 1000000000;
 	end.tv_nsec	= counter % 1000000000;
@@ -0,0 +1,154 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <CoreLib/core_sync.hpp>
+
+namespace core::_p
+{
+	///	\brief Ids of objects that are alive, used by threads to check if they can still give back what they hold from an object.
+	///	\note Ids are never re-used, unlike addresses.
+	class owner_registry
+	{
+	private:
+		atomic_spinlock			m_lock;
+		std::vector<uint64_t>	m_alive;
+		std::atomic<uint64_t>	m_next_id{1};
+
+	public:
+		static owner_registry& instance()
+		{
+			static owner_registry t_instance;
+			return t_instance;
+		}
+
+		inline atomic_spinlock& lock() { return m_lock; }
+
+		uint64_t add()
+		{
+			uint64_t const id = m_next_id.fetch_add(1, std::memory_order::relaxed);
+			atomic_spinlock::scope_locker const lock(m_lock);
+			m_alive.push_back(id);
+			return id;
+		}
+
+		///	\remarks After this returns, no thread will give anything back to the object
+		void remove(uint64_t const p_id)
+		{
+			atomic_spinlock::scope_locker const lock(m_lock);
+			std::erase(m_alive, p_id);
+		}
+
+		///	\warning Lock must be held
+		bool is_alive(uint64_t const p_id) const
+		{
+			return std::find(m_alive.begin(), m_alive.end(), p_id) != m_alive.end();
+		}
+	};
+
+	///	\brief Slots (rings, shards) a thread has claimed from the objects it has used, so that it can write to them without locking.
+	///	\tparam slot_t - Must have a std::atomic<bool> m_owned, set while a thread holds the slot.
+	///	\remarks
+	///		A thread keeps its slot for as long as the object lives, so that everything it writes to an object stays in order in one slot.
+	///		Slots are given back when the thread exits, unless the object they belong to has been removed from the \ref owner_registry,
+	///		in which case the slot is already gone. Bindings to removed objects are dropped the next time the thread binds a slot.
+	template<typename slot_t>
+	class thread_binding_cache
+	{
+	private:
+		struct binding
+		{
+			uint64_t	m_id	= 0;
+			slot_t*		m_slot	= nullptr;
+		};
+
+		std::vector<binding> m_bindings;
+
+	public:
+		inline ~thread_binding_cache()
+		{
+			owner_registry& t_registry = owner_registry::instance();
+			atomic_spinlock::scope_locker const lock(t_registry.lock());
+			for(binding const& t_binding : m_bindings)
+			{
+				if(t_registry.is_alive(t_binding.m_id))
+				{
+					t_binding.m_slot->m_owned.store(false, std::memory_order::release);
+				}
+			}
+		}
+
+		///	\return The slot bound to the object, nullptr if none
+		inline slot_t* find(uint64_t const p_id) const
+		{
+			for(binding const& t_binding : m_bindings)
+			{
+				if(t_binding.m_id == p_id) return t_binding.m_slot;
+			}
+			return nullptr;
+		}
+
+		///	\brief Binds a slot claimed from the object
+		void bind(uint64_t const p_id, slot_t* const p_slot)
+		{
+			{
+				owner_registry& t_registry = owner_registry::instance();
+				atomic_spinlock::scope_locker const lock(t_registry.lock());
+				std::erase_if(m_bindings,
+					[&t_registry](binding const& p_binding)
+					{
+						return !t_registry.is_alive(p_binding.m_id);
+					});
+			}
+			m_bindings.push_back(binding{p_id, p_slot});
+		}
+	};
+
+	///	\brief Claims a slot that is not held by any thread
+	///	\param[in] p_lock - Protects p_slots
+	///	\return nullptr if all slots are held
+	template<typename slot_t>
+	slot_t* claim_free_slot(atomic_spinlock& p_lock, std::vector<slot_t*> const& p_slots)
+	{
+		atomic_spinlock::scope_locker const lock(p_lock);
+		for(slot_t* const t_candidate : p_slots)
+		{
+			bool t_expected = false;
+			if(t_candidate->m_owned.compare_exchange_strong(t_expected, true, std::memory_order::acquire))
+			{
+				return t_candidate;
+			}
+		}
+		return nullptr;
+	}
+} //namespace core::_p
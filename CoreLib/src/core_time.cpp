@@ -28,8 +28,15 @@
 #include <CoreLib/core_time.hpp>
 
 #include <CoreLib/core_type.hpp>
+#include <CoreLib/core_endian.hpp>
 
-#include <array>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <CoreLib/core_cpu.hpp>
+#endif
 
 #ifdef _WIN32
 #include <sys/timeb.h>
@@ -74,8 +81,179 @@ static os_clock_frequency const g_WinFreq;
 
 static constexpr uint64_t g_sec2nsec = 1000000000_ui64;
 
+#ifdef _WIN32
+static inline uint64_t monotonic_nanoseconds()
+{
+	uint64_t const freq = g_WinFreq.frequency();
+	LARGE_INTEGER Time;
+	QueryPerformanceCounter(&Time);
+	uint64_t const t_val = Time.QuadPart;
+	return (t_val / freq) * g_sec2nsec + ((t_val % freq) * g_sec2nsec) / freq;
+}
+
+static inline uint64_t stamp_nanoseconds()
+{
+	return monotonic_nanoseconds();
+}
+#else
+static inline uint64_t monotonic_nanoseconds()
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return static_cast<uint64_t>(time.tv_sec) * g_sec2nsec + static_cast<uint64_t>(time.tv_nsec);
+}
+
+static inline uint64_t stamp_nanoseconds()
+{
+	struct timespec time;
+	clock_gettime(CLOCK_BOOTTIME, &time);
+	return static_cast<uint64_t>(time.tv_sec) * g_sec2nsec + static_cast<uint64_t>(time.tv_nsec);
+}
+#endif
+
+#if defined(_M_AMD64) || defined(__amd64__)
+
+struct tsc_calibration
+{
+	bool		invariant	= false;
+	uint64_t	frequency	= 0;
+	uint64_t	mult		= 0;	//!< Nanoseconds per tick, 32.32 fixed point
+};
+
+///	\brief Pairs a monotonic clock reading with the counter, keeping the tightest of a few tries
+static uint64_t tsc_sample(uint64_t& p_time)
+{
+	uint64_t best_span = ~uint64_t{0};
+	uint64_t tick = 0;
+	for(uint8_t i = 0; i < 5; ++i)
+	{
+		uint64_t const before = __rdtsc();
+		uint64_t const time = monotonic_nanoseconds();
+		uint64_t const after = __rdtsc();
+		if(after - before < best_span)
+		{
+			best_span = after - before;
+			tick = before + (after - before) / 2;
+			p_time = time;
+		}
+	}
+	return tick;
+}
+
+static tsc_calibration calibrate_tsc()
+{
+	tsc_calibration res;
+	if(!amd64::CPU_feature_su::TSC_invariant())
+	{
+		return res;
+	}
+
+	uint64_t time_0;
+	uint64_t const tick_0 = tsc_sample(time_0);
+	std::this_thread::sleep_for(std::chrono::milliseconds{10});
+	uint64_t time_1;
+	uint64_t const tick_1 = tsc_sample(time_1);
+
+	if(tick_1 <= tick_0 || time_1 <= time_0)
+	{
+		return res;
+	}
+
+	uint64_t hi;
+	uint64_t const lo = umul(tick_1 - tick_0, g_sec2nsec, hi);
+	if(hi >= time_1 - time_0)
+	{
+		return res;
+	}
+	uint64_t rem;
+	res.frequency = udiv(hi, lo, time_1 - time_0, rem);
+	if(res.frequency < 1000)
+	{
+		res.frequency = 0;
+		return res;
+	}
+	res.mult		= (g_sec2nsec << 32) / res.frequency;
+	res.invariant	= true;
+	return res;
+}
+
+static tsc_calibration const& tsc_state()
+{
+	static tsc_calibration const instance = calibrate_tsc();
+	return instance;
+}
+
+static inline uint64_t tsc_to_nanoseconds(tsc_calibration const& p_calibration, uint64_t const p_ticks)
+{
+	uint64_t hi;
+	uint64_t const lo = umul(p_ticks, p_calibration.mult, hi);
+	return (hi << 32) | (lo >> 32);
+}
+
+#endif
+
+#ifndef _WIN32
+///	\brief Clock readout used by the chronometers, counter ticks if the tsc is invariant or nanoseconds otherwise
+///	\remarks The tsc stops while the system is suspended, unlike CLOCK_BOOTTIME
+static inline uint64_t chrono_now()
+{
+#if defined(__amd64__)
+	if(tsc_state().invariant)
+	{
+		return __rdtsc();
+	}
+#endif
+	return stamp_nanoseconds();
+}
+
+static inline uint64_t chrono_to_nanoseconds(uint64_t const p_value)
+{
+#if defined(__amd64__)
+	tsc_calibration const& calibration = tsc_state();
+	if(calibration.invariant)
+	{
+		return tsc_to_nanoseconds(calibration, p_value);
+	}
+#endif
+	return p_value;
+}
+#endif
+
 }	//namespace
 
+#if defined(_M_AMD64) || defined(__amd64__)
+
+bool tsc_clock::is_invariant()
+{
+	return tsc_state().invariant;
+}
+
+uint64_t tsc_clock::frequency()
+{
+	return tsc_state().frequency;
+}
+
+uint64_t tsc_clock::to_nanoseconds(uint64_t const p_ticks)
+{
+	tsc_calibration const& calibration = tsc_state();
+	if(calibration.invariant)
+	{
+		return tsc_to_nanoseconds(calibration, p_ticks);
+	}
+	return 0;
+}
+
+time_delta_t tsc_clock::to_time_delta(int64_t const p_ticks)
+{
+	if(p_ticks < 0)
+	{
+		return time_delta_t::from_nanoseconds(-static_cast<int64_t>(to_nanoseconds(static_cast<uint64_t>(-p_ticks))));
+	}
+	return time_delta_t::from_nanoseconds(static_cast<int64_t>(to_nanoseconds(static_cast<uint64_t>(p_ticks))));
+}
+
+#endif
+
 
 void chrono::set()
 {
@@ -84,9 +262,7 @@ void chrono::set()
 	QueryPerformanceCounter(&Time);
 	m_ref = Time.QuadPart;
 #else
-	struct timespec time;
-	clock_gettime(CLOCK_BOOTTIME, &time);
-	m_ref = (uint64_t)time.tv_sec * g_sec2nsec + time.tv_nsec;
+	m_ref = chrono_now();
 #endif
 }
 
@@ -101,9 +277,7 @@ uint64_t chrono::elapsed() const //nanosecond resolution
 
 	return ((t_val / freq) * g_sec2nsec) + ((t_val % freq) * g_sec2nsec) / freq;
 #else
-	struct timespec time;
-	clock_gettime(CLOCK_BOOTTIME, &time);
-	return static_cast<uint64_t>(time.tv_sec) * g_sec2nsec + static_cast<uint64_t>(time.tv_nsec) - m_ref;
+	return chrono_to_nanoseconds(chrono_now() - m_ref);
 #endif
 }
 
@@ -116,9 +290,7 @@ void track_chrono::pause()
 		QueryPerformanceCounter(&Time);
 		m_acumulated += Time.QuadPart - m_ref;
 #else
-		struct timespec time;
-		clock_gettime(CLOCK_BOOTTIME, &time);
-		m_acumulated += static_cast<uint64_t>(time.tv_sec) * g_sec2nsec + static_cast<uint64_t>(time.tv_nsec) - m_ref;
+		m_acumulated += chrono_to_nanoseconds(chrono_now() - m_ref);
 #endif
 		m_isPaused = true;
 	}
@@ -133,9 +305,7 @@ void track_chrono::resume()
 		QueryPerformanceCounter(&Time);
 		m_ref = Time.QuadPart;
 #else
-		struct timespec time;
-		clock_gettime(CLOCK_BOOTTIME, &time);
-		m_ref = static_cast<uint64_t>(time.tv_sec) * g_sec2nsec + static_cast<uint64_t>(time.tv_nsec);
+		m_ref = chrono_now();
 #endif
 		m_isPaused = false;
 	}
@@ -148,9 +318,7 @@ void track_chrono::restart()
 	QueryPerformanceCounter(&Time);
 	m_ref = Time.QuadPart;
 #else
-	struct timespec time;
-	clock_gettime(CLOCK_BOOTTIME, &time);
-	m_ref = static_cast<uint64_t>(time.tv_sec) * g_sec2nsec + static_cast<uint64_t>(time.tv_nsec);
+	m_ref = chrono_now();
 #endif
 
 	m_acumulated	= 0;
@@ -177,10 +345,7 @@ uint64_t track_chrono::read() const
 		return m_acumulated;
 	}
 
-	struct timespec time;
-	clock_gettime(CLOCK_BOOTTIME, &time);
-	uint64_t val = m_acumulated + static_cast<uint64_t>(time.tv_sec) * g_sec2nsec + static_cast<uint64_t>(time.tv_nsec) - m_ref;
-	return val;
+	return m_acumulated + chrono_to_nanoseconds(chrono_now() - m_ref);
 #endif
 }
 
@@ -199,9 +364,7 @@ void track_chrono::set(uint64_t p_value)
 	m_acumulated = p_value;
 	if(!m_isPaused)
 	{
-		struct timespec time;
-		clock_gettime(CLOCK_BOOTTIME, &time);
-		m_ref = static_cast<uint64_t>(time.tv_sec) * g_sec2nsec + static_cast<uint64_t>(time.tv_nsec);
+		m_ref = chrono_now();
 	}
 #endif
 }
@@ -216,9 +379,7 @@ uint64_t clock_stamp() //1 nanosecond resolution
 	uint64_t const freq = g_WinFreq.frequency();
 	return (t_val / freq) * g_sec2nsec + ((t_val % freq) * g_sec2nsec) / freq;
 #else
-	struct timespec time;
-	clock_gettime(CLOCK_BOOTTIME, &time);
-	return static_cast<uint64_t>(time.tv_sec) * g_sec2nsec + static_cast<uint64_t>(time.tv_nsec);
+	return stamp_nanoseconds();
 #endif
 }
 
@@ -241,196 +402,161 @@ namespace
 	constexpr uint64_t time_in_1year   = days_per_1year   * day_100nsec;
 	constexpr uint64_t time_in_4year   = days_per_4year   * day_100nsec;
 	constexpr uint64_t time_in_100year = days_per_100year * day_100nsec;
-	constexpr uint64_t time_in_400year = days_per_400year * day_100nsec;
 
 #ifdef _WIN32
 	constexpr uint64_t epoch_offset = 0;
 #else
 	constexpr uint64_t epoch_offset = time_in_100year * 3 + time_in_4year * 17 + time_in_1year;
 #endif // _WIN32
-	constexpr uint16_t reference_year = 1601;
+	//Dates are computed in a calendar that starts on the 1st of March of year 0,
+	//this places the leap day at the end of the year and makes the month lengths regular.
+	constexpr uint32_t civil_days_per_400year	= static_cast<uint32_t>(days_per_400year);
+	constexpr uint32_t civil_days_to_1601		= 584694;	//!< Days from 0000-03-01 to 1601-01-01, the reference of time_point_t
+	constexpr uint32_t civil_days_to_1970		= 719468;	//!< Days from 0000-03-01 to 1970-01-01
 
-	consteval uint8_t _h_days_in_month(uint8_t const p_month, bool const p_leapYear)
+	struct civil_date
 	{
-		switch (p_month)
-		{
-		case 1: //February
-			return p_leapYear ? 29 : 28;
-		case 3:  //April
-		case 5:  //June
-		case 8:  //September
-		case 10: //November
-			return 30;
-		default: //All others
-			break;
-		}
-		return 31;
-	}
+		uint16_t	year;
+		uint8_t		month;	//!< 1 = January
+		uint8_t		day;	//!< 1 = Day 1
+	};
 
-	consteval uint64_t _h_time_till_month(uint8_t const p_month, bool const p_leapYear)
+	/// \brief	Converts days since 0000-03-01 to a Gregorian date.
+	///	\remarks	Uses the Euclidean affine functions from C. Neri and L. Schneider,
+	///			"Euclidean affine functions and their application to calendar algorithms".
+	///			No tables and no branches, other than the final month adjustment which compiles to a conditional move.
+	constexpr civil_date civil_from_days(uint32_t const p_days)
 	{
-		if (p_month == 0)
-			return 0;
-		return _h_time_till_month(p_month - 1, p_leapYear) + _h_days_in_month(p_month - 1, p_leapYear) * day_100nsec;
-	}
+		//century
+		uint32_t const n_1	= 4 * p_days + 3;
+		uint32_t const cent	= n_1 / civil_days_per_400year;
+		uint32_t const n_c	= n_1 % civil_days_per_400year / 4;
 
+		//year
+		uint64_t const p_2	= uint64_t{2939745} * (4 * n_c + 3);
+		uint32_t const year	= 100 * cent + static_cast<uint32_t>(p_2 >> 32);
+		uint32_t const n_y	= static_cast<uint32_t>(p_2) / 2939745 / 4;
 
+		//month and day
+		uint32_t const n_3		= 2141 * n_y + 197913;
+		uint32_t const month	= n_3 >> 16;
+		uint32_t const day		= (n_3 & 0xFFFF) / 2141;
 
-	/// \brief Lookup for time until start of the month (regular year)
-	//
-	static std::array<uint64_t, 12> const g_100nsTillMonth =
-	{
-		_h_time_till_month( 0, false),
-		_h_time_till_month( 1, false),
-		_h_time_till_month( 2, false),
-		_h_time_till_month( 3, false),
-		_h_time_till_month( 4, false),
-		_h_time_till_month( 5, false),
-		_h_time_till_month( 6, false),
-		_h_time_till_month( 7, false),
-		_h_time_till_month( 8, false),
-		_h_time_till_month( 9, false),
-		_h_time_till_month(10, false),
-		_h_time_till_month(11, false)
-	};
-
-	/// \brief Lookup for time until start of the month (leap year)
-	//
-	static std::array<uint64_t, 12> const g_100nsTillMonthLeap =
-	{
-		_h_time_till_month( 0, true),
-		_h_time_till_month( 1, true),
-		_h_time_till_month( 2, true),
-		_h_time_till_month( 3, true),
-		_h_time_till_month( 4, true),
-		_h_time_till_month( 5, true),
-		_h_time_till_month( 6, true),
-		_h_time_till_month( 7, true),
-		_h_time_till_month( 8, true),
-		_h_time_till_month( 9, true),
-		_h_time_till_month(10, true),
-		_h_time_till_month(11, true)
-	};
-
-	/// \brief Lookup for days in a given month (regular year)
-	//
-	static std::array<uint8_t, 12> const g_daysInMonth =
-	{
-		_h_days_in_month( 0, false),
-		_h_days_in_month( 1, false),
-		_h_days_in_month( 2, false),
-		_h_days_in_month( 3, false),
-		_h_days_in_month( 4, false),
-		_h_days_in_month( 5, false),
-		_h_days_in_month( 6, false),
-		_h_days_in_month( 7, false),
-		_h_days_in_month( 8, false),
-		_h_days_in_month( 9, false),
-		_h_days_in_month(10, false),
-		_h_days_in_month(11, false)
-	};
+		//January and February belong to the next year
+		uint32_t const jan_feb = n_y >= 306 ? 1 : 0;
 
-	/// \brief Lookup for days in a given month (leap year)
-	//
-	static std::array<uint8_t, 12> const g_daysInMonthLeap =
-	{
-		_h_days_in_month( 0, true),
-		_h_days_in_month( 1, true),
-		_h_days_in_month( 2, true),
-		_h_days_in_month( 3, true),
-		_h_days_in_month( 4, true),
-		_h_days_in_month( 5, true),
-		_h_days_in_month( 6, true),
-		_h_days_in_month( 7, true),
-		_h_days_in_month( 8, true),
-		_h_days_in_month( 9, true),
-		_h_days_in_month(10, true),
-		_h_days_in_month(11, true)
-	};
+		return civil_date
+		{
+			.year	= static_cast<uint16_t>(year + jan_feb),
+			.month	= static_cast<uint8_t>(jan_feb ? month - 12 : month),
+			.day	= static_cast<uint8_t>(day + 1)
+		};
+	}
 
-	constexpr bool is_leap_year(uint16_t const p_year)
+	/// \brief	Converts a Gregorian date to days since 0000-03-01, the inverse of \ref civil_from_days
+	constexpr uint32_t days_from_civil(uint16_t const p_year, uint8_t const p_month, uint8_t const p_day)
 	{
-		return ((p_year % 4 == 0) && (p_year % 100 != 0)) || (p_year % 400 == 0);
+		//shifted by 400 years so that January and February of year 0 do not underflow
+		uint32_t const jan_feb	= p_month <= 2 ? 1 : 0;
+		uint32_t const year		= p_year + 400 - jan_feb;
+		uint32_t const month	= jan_feb ? p_month + 12 : p_month;
+		uint32_t const cent		= year / 100;
+
+		uint32_t const year_days	= 1461 * year / 4 - cent + cent / 4;
+		uint32_t const month_days	= (979 * month - 2919) / 32;
+		return year_days + month_days + p_day - 1 - civil_days_per_400year;
 	}
 
+	static_assert(days_from_civil(1601, 1, 1) == civil_days_to_1601);
+	static_assert(days_from_civil(1970, 1, 1) == civil_days_to_1970);
+	static_assert(civil_from_days(civil_days_to_1970).year == 1970);
+	static_assert(civil_from_days(days_from_civil(2000, 2, 29)).day == 29);
+	static_assert(civil_from_days(days_from_civil(2024, 12, 31)).month == 12);
 
-	uint16_t time_to_year(uint64_t p_100ns, uint64_t& p_rem)
+	inline void civil_to_date(uint32_t const p_days, date_time_t& p_out)
 	{
-		uint16_t t_year = reference_year + static_cast<uint16_t>((p_100ns / time_in_400year) * 400);
-		p_100ns %= time_in_400year;
-
-		t_year += static_cast<uint16_t>((p_100ns / time_in_100year) * 100);
-		p_100ns %= time_in_100year;
-
-		t_year += static_cast<uint16_t>((p_100ns / time_in_4year) * 4);
-		p_100ns %= time_in_4year;
-
-		p_rem = p_100ns % time_in_1year;
-		return t_year + static_cast<uint16_t>(p_100ns / time_in_1year);
+		civil_date const date = civil_from_days(p_days);
+		p_out.date.year		= date.year;
+		p_out.date.month	= date.month;
+		p_out.date.day		= date.day;
 	}
 
-	uint64_t year_to_time(uint16_t p_year)
+	inline void time_of_day_to_date(uint64_t const p_100ns, date_time_t& p_out)
 	{
-		p_year -= reference_year;
-		uint64_t t_100ns = (p_year / 400) * time_in_400year;
-		uint16_t t_rem = p_year % 400;
+		uint32_t const seconds = static_cast<uint32_t>(p_100ns / sec_100nsec);
+		p_out.time.hour		= static_cast<uint8_t>(seconds / 3600);
+		p_out.time.minute	= static_cast<uint8_t>(seconds / 60 % 60);
+		p_out.time.second	= static_cast<uint8_t>(seconds % 60);
+		p_out.time.nsecond	= static_cast<uint32_t>(p_100ns % sec_100nsec) * 100;
+	}
 
-		t_100ns += (t_rem / 100) * time_in_100year;
-		t_rem %= 100;
-		t_100ns += (t_rem / 4) * time_in_4year;
-		return t_100ns + (t_rem % 4) * time_in_1year;
+	inline void system_time_to_date(uint64_t const p_100ns, date_time_t& p_out)
+	{
+		civil_to_date(static_cast<uint32_t>(p_100ns / day_100nsec) + civil_days_to_1601, p_out);
+		time_of_day_to_date(p_100ns % day_100nsec, p_out);
 	}
 
-	static uint8_t find_month_from_ns(uint64_t const p_100ns, std::array<uint64_t, 12> const& p_100ns_till_month)
+#ifndef _WIN32
+	///	\brief	Offset to local time, reused for a 15 minute window when the offset is the same at both ends of it.
+	///	\remarks	Offset changes are usually on a 15 minute boundary, but not always (ex. historical local mean time offsets),
+	///			windows where the offset changes are not cached.
+	///			A change of the time zone setting while running is only seen once the window rolls over.
+	struct tz_offset_cache
 	{
-		//Used to estimate what is the month it currently must be in so it doesn't have to search allot
-		//I know perfectly well that February can sometimes only have 28 days
-		//but it follows January which has 31 days, by the time 1 of March comes around 59 days have passed,
-		//which leads to an average of 29.5 days, this is as low as the "average days in a month since the start of the year" can go
-		//since max days in a month is 31, and there are only 12 months in a year, the real month can not be more then 1 off
-		constexpr uint64_t lowerMonthMs = 29 * day_100nsec;
+		int64_t	window	= -1;
+		int64_t	offset	= 0;	//!< Seconds east of UTC
+		bool	dst		= false;
+	};
 
-		uint8_t pivot = static_cast<uint8_t>(p_100ns / lowerMonthMs /*+ 1*/);
+	constexpr int64_t tz_offset_window = 15 * 60;
 
-		if(pivot > 11) pivot = 11;
-		if(p_100ns < p_100ns_till_month[pivot])
-		{
-			--pivot;
-		}
-		return pivot;
-	}
+	thread_local tz_offset_cache t_tz_offset_cache;
 
-	uint8_t time_2_Month(uint64_t const p_100ns, uint64_t& p_rem, bool const p_leapYear)
+	tz_offset_cache const& tz_offset_for(int64_t const p_seconds)
 	{
-		if(p_leapYear)
-		{
-			uint8_t const criticalIndex = find_month_from_ns(p_100ns, g_100nsTillMonthLeap);
-			p_rem = (p_100ns - g_100nsTillMonthLeap[criticalIndex]);
-			return criticalIndex;
-		}
-		else
+		tz_offset_cache& cache = t_tz_offset_cache;
+		int64_t const window = p_seconds / tz_offset_window;
+		if(cache.window != window)
 		{
-			uint8_t const criticalIndex = find_month_from_ns(p_100ns, g_100nsTillMonth);
-			p_rem = (p_100ns - g_100nsTillMonth[criticalIndex]);
-			return criticalIndex;
+			struct tm first;
+			struct tm last;
+			time_t const t_first = static_cast<time_t>(window * tz_offset_window);
+			time_t const t_last = t_first + static_cast<time_t>(tz_offset_window - 1);
+			localtime_r(&t_first, &first);
+			localtime_r(&t_last, &last);
+			if(first.tm_gmtoff == last.tm_gmtoff && first.tm_isdst == last.tm_isdst)
+			{
+				cache.offset	= first.tm_gmtoff;
+				cache.dst		= first.tm_isdst > 0 ? true : false;
+				cache.window	= window;
+			}
+			else
+			{
+				struct tm timeinfo;
+				time_t const t_time = static_cast<time_t>(p_seconds);
+				localtime_r(&t_time, &timeinfo);
+				cache.offset	= timeinfo.tm_gmtoff;
+				cache.dst		= timeinfo.tm_isdst > 0 ? true : false;
+				cache.window	= -1;
+			}
 		}
+		return cache;
 	}
 
-	uint64_t time_till_month(uint8_t const p_month, bool const p_leapYear)
-	{
-		if (p_leapYear)
-			return g_100nsTillMonthLeap[p_month];
-		return g_100nsTillMonth[p_month];
-	}
-
-#if 0
-	uint8_t days_in_month(uint8_t const p_month, bool const p_leapYear)
+	/// \brief Converts seconds since 1970 (UTC) to the local date
+	void local_date_from_seconds(int64_t const p_seconds, date_time_t& p_out, date_time_extra& p_extra)
 	{
-		if(p_leapYear)
-		{
-			return g_daysInMonthLeap[p_month];
-		}
-		return g_daysInMonth[p_month];
+		tz_offset_cache const& tz = tz_offset_for(p_seconds);
+		uint64_t const local = static_cast<uint64_t>(p_seconds + tz.offset);
+		uint32_t const days = static_cast<uint32_t>(local / 86400) + civil_days_to_1970;
+		uint32_t const seconds = static_cast<uint32_t>(local % 86400);
+
+		civil_to_date(days, p_out);
+		p_out.time.hour		= static_cast<uint8_t>(seconds / 3600);
+		p_out.time.minute	= static_cast<uint8_t>(seconds / 60 % 60);
+		p_out.time.second	= static_cast<uint8_t>(seconds % 60);
+		p_extra.week_day	= static_cast<uint8_t>((days + 3) % 7);	//0000-03-01 was a Wednesday
+		p_extra.dst			= tz.dst;
 	}
 #endif
 } //namespace
@@ -449,26 +575,18 @@ void date_time_local(date_time_t& p_out)
 	p_out.time.second	= static_cast<uint8_t> (timeinfo.wSecond);
 	p_out.time.nsecond	= static_cast<uint32_t>(timeinfo.wMilliseconds) * 1000000;
 #else
-	struct tm timeinfo;
-
-	timeval curTime;
-	gettimeofday(&curTime, nullptr);
-	localtime_r(&curTime.tv_sec, &timeinfo);
-	p_out.time.nsecond	= static_cast<uint16_t>(curTime.tv_usec * 1000);
-	p_out.date.year		= static_cast<uint16_t>(static_cast<uint16_t>(timeinfo.tm_year)	+ uint16_t{1900});
-	p_out.date.month	= static_cast<uint8_t> (static_cast<uint8_t> (timeinfo.tm_mon)	+ uint8_t{1});
-	p_out.date.day		= static_cast<uint8_t> (timeinfo.tm_mday);
-	p_out.time.hour		= static_cast<uint8_t> (timeinfo.tm_hour);
-	p_out.time.minute	= static_cast<uint8_t> (timeinfo.tm_min);
-	p_out.time.second	= static_cast<uint8_t> (timeinfo.tm_sec);
+	struct timespec time;
+	clock_gettime(CLOCK_REALTIME, &time);
+	date_time_extra extra;
+	local_date_from_seconds(static_cast<int64_t>(time.tv_sec), p_out, extra);
+	p_out.time.nsecond	= static_cast<uint32_t>(time.tv_nsec);
 #endif
 }
 
 void date_time_local(date_time_t& p_out, date_time_extra& p_extra)
 {
-	struct tm timeinfo;
-
 #ifdef _WIN32
+	struct tm timeinfo;
 	struct __timeb64 timeptr;
 	_ftime64_s(&timeptr);
 	_localtime64_s(&timeinfo, &timeptr.time);
@@ -476,21 +594,89 @@ void date_time_local(date_time_t& p_out, date_time_extra& p_extra)
 	p_out.date.year		= static_cast<uint16_t>(timeinfo.tm_year) + 1900_ui16;
 	p_out.date.month	= static_cast<uint8_t> (timeinfo.tm_mon ) + 1_ui8;
 	p_extra.dst			= timeptr.dstflag > 0 ? true : false;
-#else
-	timeval curTime;
-	gettimeofday(&curTime, nullptr);
-	localtime_r(&curTime.tv_sec, &timeinfo);
-	p_out.time.nsecond	= static_cast<uint16_t>(curTime.tv_usec * 1000);
-	p_out.date.year		= static_cast<uint16_t>(static_cast<uint16_t>(timeinfo.tm_year)	+ 1900_ui16);
-	p_out.date.month	= static_cast<uint8_t> (static_cast<uint8_t> (timeinfo.tm_mon)	+ 1_ui8);
-	p_extra.dst			= timeinfo.tm_isdst > 0 ? true : false;
-#endif
 
 	p_out.date.day		= static_cast<uint8_t> (timeinfo.tm_mday);
 	p_out.time.hour		= static_cast<uint8_t> (timeinfo.tm_hour);
 	p_out.time.minute	= static_cast<uint8_t> (timeinfo.tm_min);
 	p_out.time.second	= static_cast<uint8_t> (timeinfo.tm_sec);
 	p_extra.week_day	= static_cast<uint8_t> (timeinfo.tm_wday);
+#else
+	struct timespec time;
+	clock_gettime(CLOCK_REALTIME, &time);
+	local_date_from_seconds(static_cast<int64_t>(time.tv_sec), p_out, p_extra);
+	p_out.time.nsecond	= static_cast<uint32_t>(time.tv_nsec);
+#endif
+}
+
+namespace
+{
+	struct local_date_cache
+	{
+		int64_t			second = -1;
+		date_time_t		date{};
+		date_time_extra	extra{};
+	};
+
+	thread_local local_date_cache t_local_date_cache;
+
+	/// \brief Current real time in seconds since 1970
+	int64_t real_time_seconds(uint32_t& p_nsecond)
+	{
+#ifdef _WIN32
+		struct __timeb64 timeptr;
+		_ftime64_s(&timeptr);
+		p_nsecond = static_cast<uint32_t>(timeptr.millitm) * 1000000;
+		return static_cast<int64_t>(timeptr.time);
+#else
+		struct timespec time;
+		clock_gettime(CLOCK_REALTIME, &time);
+		p_nsecond = static_cast<uint32_t>(time.tv_nsec);
+		return static_cast<int64_t>(time.tv_sec);
+#endif
+	}
+
+	local_date_cache const& local_date_for(int64_t const p_second)
+	{
+		local_date_cache& cache = t_local_date_cache;
+		if(cache.second != p_second)
+		{
+#ifdef _WIN32
+			struct tm timeinfo;
+			__time64_t const t_time = p_second;
+			_localtime64_s(&timeinfo, &t_time);
+			cache.date.date.year	= static_cast<uint16_t>(static_cast<uint16_t>(timeinfo.tm_year)	+ 1900_ui16);
+			cache.date.date.month	= static_cast<uint8_t> (static_cast<uint8_t> (timeinfo.tm_mon)	+ 1_ui8);
+			cache.date.date.day		= static_cast<uint8_t> (timeinfo.tm_mday);
+			cache.date.time.hour	= static_cast<uint8_t> (timeinfo.tm_hour);
+			cache.date.time.minute	= static_cast<uint8_t> (timeinfo.tm_min);
+			cache.date.time.second	= static_cast<uint8_t> (timeinfo.tm_sec);
+			cache.extra.week_day	= static_cast<uint8_t> (timeinfo.tm_wday);
+			cache.extra.dst			= timeinfo.tm_isdst > 0 ? true : false;
+#else
+			local_date_from_seconds(p_second, cache.date, cache.extra);
+#endif
+			cache.date.time.nsecond	= 0;
+			cache.second = p_second;
+		}
+		return cache;
+	}
+} //namespace
+
+void date_time_local_cached(date_time_t& p_out)
+{
+	uint32_t nsecond;
+	local_date_cache const& cache = local_date_for(real_time_seconds(nsecond));
+	p_out = cache.date;
+	p_out.time.nsecond = nsecond;
+}
+
+void date_time_local_cached(date_time_t& p_out, date_time_extra& p_extra)
+{
+	uint32_t nsecond;
+	local_date_cache const& cache = local_date_for(real_time_seconds(nsecond));
+	p_out = cache.date;
+	p_out.time.nsecond = nsecond;
+	p_extra = cache.extra;
 }
 
 
@@ -511,6 +697,14 @@ void date_time_local(date_time_t& p_out, date_time_extra& p_extra)
 	GetSystemTimePreciseAsFileTime(&temp);
 	return time_point_t{(static_cast<uint64_t>(temp.dwHighDateTime) << 32) | static_cast<uint64_t>(temp.dwLowDateTime)};
 }
+
+[[nodiscard]] time_point_t system_time_coarse()
+{
+	//1601, already updated at the scheduler tick
+	FILETIME temp;
+	GetSystemTimeAsFileTime(&temp);
+	return time_point_t{(static_cast<uint64_t>(temp.dwHighDateTime) << 32) | static_cast<uint64_t>(temp.dwLowDateTime)};
+}
 #else
 [[nodiscard]] time_point_t system_time_fast()
 {
@@ -529,15 +723,22 @@ void date_time_local(date_time_t& p_out, date_time_extra& p_extra)
 	//clock_gettime(CLOCK_REALTIME, &temp);
 	return time_point_t{static_cast<uint64_t>(temp.tv_sec) * sec_100nsec + temp.tv_nsec / 100 + epoch_offset};
 }
+
+[[nodiscard]] time_point_t system_time_coarse()
+{
+	//1970
+	struct timespec temp;
+	clock_gettime(CLOCK_REALTIME_COARSE, &temp);
+	return time_point_t{static_cast<uint64_t>(temp.tv_sec) * sec_100nsec + static_cast<uint64_t>(temp.tv_nsec) / 100 + epoch_offset};
+}
 #endif
 
 time_point_t date_to_system_time(date_time_t const& value)
 {
-	uint8_t month = value.date.month -1;
-	if(month > 11) month = 11;
+	uint8_t month = value.date.month;
+	if(static_cast<uint8_t>(month - 1_ui8) > 11) month = 12;
 
-	return time_point_t{year_to_time(value.date.year)
-		+ time_till_month(month, is_leap_year(value.date.year))
+	return time_point_t{(days_from_civil(value.date.year, month, 1) - uint64_t{civil_days_to_1601}) * day_100nsec
 		+ (value.date.day -1) * day_100nsec
 		+ value.time.hour * hour_100nsec
 		+ value.time.minute * minute_100nsec
@@ -548,53 +749,268 @@ time_point_t date_to_system_time(date_time_t const& value)
 date_time_t system_time_to_date(time_point_t value)
 {
 	date_time_t out;
-	uint64_t t_rem;
+	system_time_to_date(value.raw(), out);
+	return out;
+}
+
+uintptr_t system_time_to_date(std::span<time_point_t const> const p_in, std::span<date_time_t> const p_out)
+{
+	uintptr_t const count = std::min(p_in.size(), p_out.size());
+	time_point_t const* const in = p_in.data();
+	date_time_t* const out = p_out.data();
+	for(uintptr_t i = 0; i < count; ++i)
+	{
+		system_time_to_date(in[i].raw(), out[i]);
+	}
+	return count;
+}
+
+core::date_time_t to_date(std::chrono::system_clock::time_point const p_time)
+{
+	std::chrono::system_clock::duration const since_epoch = p_time.time_since_epoch();
+	std::chrono::days const days = std::chrono::floor<std::chrono::days>(since_epoch);
+	uint64_t const time_of_day = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - days).count());
+
+	core::date_time_t out;
+	civil_to_date(static_cast<uint32_t>(days.count() + civil_days_to_1970), out);
+	time_of_day_to_date(time_of_day / 100, out);
+	out.time.nsecond = static_cast<uint32_t>(time_of_day % 1000000000);
+	return out;
+}
+
+namespace
+{
+	inline uint64_t load_le64(char8_t const* const p_in)
 	{
-		uint16_t const t_year = time_to_year(value.raw(), t_rem);
-		out.date.year = t_year;
-		out.date.month = time_2_Month(t_rem, t_rem, is_leap_year(t_year)) + 1_ui8;
+		uint64_t res;
+		memcpy(&res, p_in, sizeof(uint64_t));
+		return endian_little2host(res);
 	}
 
-	out.date.day = static_cast<uint8_t>(t_rem / day_100nsec + 1_ui8);
-	t_rem       %= day_100nsec;
+	inline void store_le64(char8_t* const p_out, uint64_t const p_val)
+	{
+		uint64_t const val = endian_host2little(p_val);
+		memcpy(p_out, &val, sizeof(uint64_t));
+	}
 
-	out.time.hour = static_cast<uint8_t>(t_rem / hour_100nsec);
-	t_rem        %= hour_100nsec;
+	/// \brief Two ASCII digits of a value below 100, most significant in the lower byte
+	constexpr uint64_t ascii_pair(uint32_t const p_val)
+	{
+		uint32_t const tens = (p_val * 103) >> 10;
+		return static_cast<uint64_t>(tens | ((p_val - tens * 10) << 8) | 0x3030);
+	}
 
-	out.time.minute = static_cast<uint8_t>(t_rem / minute_100nsec);
-	t_rem         %= minute_100nsec;
+	/// \brief Eight ASCII digits of a value below 100000000, most significant in the lower byte
+	constexpr uint64_t ascii_eight(uint32_t const p_val)
+	{
+		uint64_t res = (p_val / 10000) | (static_cast<uint64_t>(p_val % 10000) << 32);
+		uint64_t const hundreds = ((res * 10486) >> 20) & 0x0000007F'0000007F;
+		res = hundreds | ((res - hundreds * 100) << 16);
+		uint64_t const tens = ((res * 103) >> 10) & 0x000F000F'000F000F;
+		res = tens | ((res - tens * 10) << 8);
+		return res | 0x30303030'30303030;
+	}
 
-	out.time.second  = static_cast<uint8_t>(t_rem / sec_100nsec);
-	out.time.nsecond = static_cast<uint32_t>((t_rem % sec_100nsec) * 100);
+	static_assert(ascii_eight(12345678) == 0x38373635'34333231);
 
-	return out;
-}
+	/// \brief Value of eight ASCII digits, most significant in the lower byte
+	constexpr uint32_t parse_eight(uint64_t p_val)
+	{
+		p_val -= 0x30303030'30303030;
+		p_val = (p_val * 10) + (p_val >> 8);
+		p_val = (((p_val & 0x000000FF'000000FF) * (100 + (1000000_ui64 << 32))) +
+			(((p_val >> 16) & 0x000000FF'000000FF) * (1 + (10000_ui64 << 32)))) >> 32;
+		return static_cast<uint32_t>(p_val);
+	}
 
-core::date_time_t to_date(std::chrono::system_clock::time_point const p_time)
-{
-	std::chrono::time_point const floor{std::chrono::floor<std::chrono::days>(p_time)};
-	std::chrono::year_month_day const ymd{floor};
-	std::chrono::hh_mm_ss const ttime{p_time - floor};
+	static_assert(parse_eight(0x38373635'34333231) == 12345678);
 
-	using tdate_t = decltype(core::date_time_t::date);
-	using ttime_t = decltype(core::date_time_t::time);
+	/// \brief Checks that the bytes in p_digits are ASCII digits and that everything else matches p_separators
+	constexpr bool swar_match(uint64_t const p_val, uint64_t const p_digits, uint64_t const p_separators)
+	{
+		uint64_t const high = p_digits & 0xF0F0F0F0'F0F0F0F0;
+		uint64_t const expected = p_digits & 0x30303030'30303030;
+		return ((p_val & high) == expected)
+			&& (((p_val + (p_digits & 0x06060606'06060606)) & high) == expected)
+			&& ((p_val & ~p_digits) == p_separators);
+	}
 
-	return core::date_time_t
+	/// \brief Each byte becomes its digit times 10 plus the digit in the next byte
+	constexpr uint64_t swar_pairs(uint64_t p_val, uint64_t const p_digits)
 	{
-		.date=tdate_t
+		p_val = (p_val - (p_digits & 0x30303030'30303030)) & p_digits;
+		return p_val * 10 + (p_val >> 8);
+	}
+
+	//"YYYY-MM-"
+	constexpr uint64_t iso8601_date_digits		= 0x00FFFF00'FFFFFFFF;
+	constexpr uint64_t iso8601_date_separators	= 0x2D00002D'00000000;
+	//"DDTHH:MM", 'T' is matched in lower case
+	constexpr uint64_t iso8601_time_digits		= 0xFFFF00FF'FF00FFFF;
+	constexpr uint64_t iso8601_time_separators	= 0x00003A00'00740000;
+
+	char8_t* iso8601_encode(date_time_t const& p_date, uint8_t const p_fraction_digits, char8_t* p_out)
+	{
+		uint32_t const year = p_date.date.year % 10000;
+		store_le64(p_out,
+			ascii_pair(year / 100) |
+			ascii_pair(year % 100) << 16 |
+			uint64_t{'-'} << 32 |
+			ascii_pair(p_date.date.month) << 40 |
+			uint64_t{'-'} << 56);
+		store_le64(p_out + 8,
+			ascii_pair(p_date.date.day) |
+			uint64_t{'T'} << 16 |
+			ascii_pair(p_date.time.hour) << 24 |
+			uint64_t{':'} << 40 |
+			ascii_pair(p_date.time.minute) << 48);
+
+		uint64_t const second = ascii_pair(p_date.time.second);
+		p_out[16] = u8':';
+		p_out[17] = static_cast<char8_t>(second);
+		p_out[18] = static_cast<char8_t>(second >> 8);
+		p_out += 19;
+
+		if(p_fraction_digits)
 		{
-			.year  = static_cast<uint16_t>(static_cast<int16_t>(static_cast<int>(ymd.year()))),
-			.month = static_cast<uint8_t>(static_cast<unsigned>(ymd.month())),
-			.day   = static_cast<uint8_t>(static_cast<unsigned>(ymd.day()))
-		},
-		.time=ttime_t
+			uint8_t const digits = p_fraction_digits < 9 ? p_fraction_digits : 9;
+			uint32_t const nsecond = p_date.time.nsecond % 1000000000;
+			char8_t fraction[10];
+			fraction[0] = u8'.';
+			fraction[1] = static_cast<char8_t>(u8'0' + nsecond / 100000000);
+			store_le64(fraction + 2, ascii_eight(nsecond % 100000000));
+			memcpy(p_out, fraction, digits + 1);
+			p_out += digits + 1;
+		}
+		*(p_out++) = u8'Z';
+		return p_out;
+	}
+
+	bool iso8601_decode(char8_t const* const p_str, uintptr_t const p_size, date_time_t& p_out)
+	{
+		if(p_size < 20 || p_size > iso8601_max_size)
 		{
-			.hour    = static_cast<uint8_t>(ttime.hours().count()),
-			.minute  = static_cast<uint8_t>(ttime.minutes().count()),
-			.second  = static_cast<uint8_t>(ttime.seconds().count()),
-			.nsecond = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(ttime.subseconds()).count())
+			return false;
 		}
-	};
+
+		uint64_t const date = load_le64(p_str);
+		uint64_t const time = load_le64(p_str + 8) | (uint64_t{0x20} << 16);
+		if(!swar_match(date, iso8601_date_digits, iso8601_date_separators) ||
+			!swar_match(time, iso8601_time_digits, iso8601_time_separators) ||
+			p_str[16] != u8':' ||
+			static_cast<uint8_t>(p_str[17] - u8'0') > 9 ||
+			static_cast<uint8_t>(p_str[18] - u8'0') > 9)
+		{
+			return false;
+		}
+
+		uint32_t nsecond = 0;
+		uintptr_t pos = 19;
+		if(p_str[pos] == u8'.')
+		{
+			++pos;
+			char8_t fraction[9] = {u8'0', u8'0', u8'0', u8'0', u8'0', u8'0', u8'0', u8'0', u8'0'};
+			uintptr_t const start = pos;
+			while(pos < p_size && static_cast<uint8_t>(p_str[pos] - u8'0') < 10)
+			{
+				++pos;
+			}
+			uintptr_t const count = pos - start;
+			if(count == 0 || count > 9)
+			{
+				return false;
+			}
+			memcpy(fraction, p_str + start, count);
+			nsecond = static_cast<uint32_t>(fraction[0] - u8'0') * 100000000 + parse_eight(load_le64(fraction + 1));
+		}
+
+		if(pos + 1 != p_size || (p_str[pos] | 0x20) != u8'z')
+		{
+			return false;
+		}
+
+		uint64_t const date_pairs = swar_pairs(date, iso8601_date_digits);
+		uint64_t const time_pairs = swar_pairs(time, iso8601_time_digits);
+
+		uint16_t const year		= static_cast<uint16_t>((date_pairs & 0xFF) * 100 + ((date_pairs >> 16) & 0xFF));
+		uint8_t const month		= static_cast<uint8_t>(date_pairs >> 40);
+		uint8_t const day		= static_cast<uint8_t>(time_pairs);
+		uint8_t const hour		= static_cast<uint8_t>(time_pairs >> 24);
+		uint8_t const minute	= static_cast<uint8_t>(time_pairs >> 48);
+		uint8_t const second	= static_cast<uint8_t>((p_str[17] - u8'0') * 10 + (p_str[18] - u8'0'));
+
+		bool const leap_year = ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
+		uint8_t const days_in_month = month == 2
+			? static_cast<uint8_t>(leap_year ? 29 : 28)
+			: static_cast<uint8_t>(30 + ((month ^ (month >> 3)) & 1));
+
+		if(static_cast<uint8_t>(month - 1_ui8) > 11 || static_cast<uint8_t>(day - 1_ui8) >= days_in_month || hour > 23 || minute > 59 || second > 60)
+		{
+			return false;
+		}
+
+		p_out.date.year		= year;
+		p_out.date.month	= month;
+		p_out.date.day		= day;
+		p_out.time.hour		= hour;
+		p_out.time.minute	= minute;
+		p_out.time.second	= second;
+		p_out.time.nsecond	= nsecond;
+		return true;
+	}
+} //namespace
+
+template<_p::c_time_conv_char CharT>
+CharT* to_chars_iso8601_unsafe(date_time_t const& p_date, uint8_t const p_fraction_digits, CharT* p_out)
+{
+	if constexpr(std::is_same_v<CharT, char8_t>)
+	{
+		return iso8601_encode(p_date, p_fraction_digits, p_out);
+	}
+	else
+	{
+		char8_t buff[iso8601_max_size];
+		char8_t const* const end = iso8601_encode(p_date, p_fraction_digits, buff);
+		for(char8_t const* pivot = buff; pivot != end; ++pivot)
+		{
+			*(p_out++) = static_cast<CharT>(*pivot);
+		}
+		return p_out;
+	}
+}
+
+template<_p::c_time_conv_char CharT>
+bool from_chars_iso8601(std::basic_string_view<CharT> const p_str, date_time_t& p_out)
+{
+	if constexpr(std::is_same_v<CharT, char8_t>)
+	{
+		return iso8601_decode(p_str.data(), p_str.size(), p_out);
+	}
+	else
+	{
+		if(p_str.size() > iso8601_max_size)
+		{
+			return false;
+		}
+		char8_t buff[iso8601_max_size];
+		for(uintptr_t i = 0; i < p_str.size(); ++i)
+		{
+			if(p_str[i] > 0x7F)
+			{
+				return false;
+			}
+			buff[i] = static_cast<char8_t>(p_str[i]);
+		}
+		return iso8601_decode(buff, p_str.size(), p_out);
+	}
 }
 
+template char8_t * to_chars_iso8601_unsafe<char8_t >(date_time_t const&, uint8_t, char8_t *);
+template char16_t* to_chars_iso8601_unsafe<char16_t>(date_time_t const&, uint8_t, char16_t*);
+template char32_t* to_chars_iso8601_unsafe<char32_t>(date_time_t const&, uint8_t, char32_t*);
+
+template bool from_chars_iso8601<char8_t >(std::u8string_view , date_time_t&);
+template bool from_chars_iso8601<char16_t>(std::u16string_view, date_time_t&);
+template bool from_chars_iso8601<char32_t>(std::u32string_view, date_time_t&);
+
 } //namespace core
@@ -35,6 +35,7 @@
 #include <CoreLib/core_endian.hpp>
 
 #include <limits>
+#include <vector>
 
 #ifdef _WIN32
 #	include <Winsock2.h>
@@ -50,6 +51,7 @@
 //#	include <netinet/in.h>
 #	include <netinet/tcp.h>
 #	include <arpa/inet.h>
+#	include <linux/filter.h>
 #	include <unistd.h>
 #	include <errno.h>
 #endif
@@ -839,6 +841,230 @@ static inline NET_Error Core_GetPeerAddressIPv6(_p::SocketHandle_t const p_sock,
 	return NET_Error::NoErr;
 }
 
+//========	========	========	========	========
+//========	========	Tuning		========	========
+//========	========	========	========	========
+
+static inline NET_Error Core_setSockOptInt(_p::SocketHandle_t const p_sock, int const p_level, int const p_option, int const p_value)
+{
+	return setsockopt(p_sock, p_level, p_option, reinterpret_cast<char const*>(&p_value), sizeof(p_value)) ? NET_Error::Sock_Option : NET_Error::NoErr;
+}
+
+static inline NET_Error Core_getSockOptInt(_p::SocketHandle_t const p_sock, int const p_level, int const p_option, int& p_value)
+{
+	int				value	= 0;
+	CoreSockLen_t	len		= sizeof(value);
+	if(getsockopt(p_sock, p_level, p_option, reinterpret_cast<char*>(&value), &len))
+	{
+		return NET_Error::Sock_Option;
+	}
+	p_value = value;
+	return NET_Error::NoErr;
+}
+
+static inline NET_Error Core_setSockOptUint(_p::SocketHandle_t const p_sock, int const p_level, int const p_option, uint32_t const p_value)
+{
+	if(p_value > static_cast<uint32_t>(std::numeric_limits<int>::max())) return NET_Error::Invalid_Option;
+	return Core_setSockOptInt(p_sock, p_level, p_option, static_cast<int>(p_value));
+}
+
+static inline NET_Error Core_getSockOptUint(_p::SocketHandle_t const p_sock, int const p_level, int const p_option, uint32_t& p_value)
+{
+	int value;
+	NET_Error const err = Core_getSockOptInt(p_sock, p_level, p_option, value);
+	if(err != NET_Error::NoErr) return err;
+	p_value = static_cast<uint32_t>(value);
+	return NET_Error::NoErr;
+}
+
+static inline NET_Error Core_getSockOptBool(_p::SocketHandle_t const p_sock, int const p_level, int const p_option, bool& p_value)
+{
+	int value;
+	NET_Error const err = Core_getSockOptInt(p_sock, p_level, p_option, value);
+	if(err != NET_Error::NoErr) return err;
+	p_value = (value != 0);
+	return NET_Error::NoErr;
+}
+
+static inline NET_Error Core_setReusePort([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] bool const p_reuse)
+{
+#ifdef SO_REUSEPORT
+	return Core_setSockOptInt(p_sock, SOL_SOCKET, SO_REUSEPORT, p_reuse ? 1 : 0);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_getReusePort([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] bool& p_reuse)
+{
+#ifdef SO_REUSEPORT
+	return Core_getSockOptBool(p_sock, SOL_SOCKET, SO_REUSEPORT, p_reuse);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_setBusyPoll([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] uint32_t const p_microseconds)
+{
+#ifdef SO_BUSY_POLL
+	return Core_setSockOptUint(p_sock, SOL_SOCKET, SO_BUSY_POLL, p_microseconds);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_getBusyPoll([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] uint32_t& p_microseconds)
+{
+#ifdef SO_BUSY_POLL
+	return Core_getSockOptUint(p_sock, SOL_SOCKET, SO_BUSY_POLL, p_microseconds);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_setIncomingCPU([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] uint32_t const p_cpu)
+{
+#ifdef SO_INCOMING_CPU
+	return Core_setSockOptUint(p_sock, SOL_SOCKET, SO_INCOMING_CPU, p_cpu);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_getIncomingCPU([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] uint32_t& p_cpu)
+{
+#ifdef SO_INCOMING_CPU
+	return Core_getSockOptUint(p_sock, SOL_SOCKET, SO_INCOMING_CPU, p_cpu);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_setReusePortCPUSteering([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] std::span<uint32_t const> const p_cpu_map)
+{
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+	//one compare and return pair per mapped CPU, plus load, modulo fallback and return
+	constexpr uintptr_t max_map_size = (BPF_MAXINSNS - 3) / 2;
+	if(p_cpu_map.empty() || p_cpu_map.size() > max_map_size) return NET_Error::Invalid_Option;
+
+	uint16_t const map_size = static_cast<uint16_t>(p_cpu_map.size());
+	std::vector<sock_filter> code;
+	code.resize(map_size * 2 + 3);
+	uint16_t pos = 0;
+
+	code[pos++] = BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU));
+	for(uint16_t i = 0; i < map_size; ++i)
+	{
+		code[pos++] = BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, p_cpu_map[i], 0, 1);
+		code[pos++] = BPF_STMT(BPF_RET | BPF_K, i);
+	}
+	code[pos++] = BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, map_size);
+	code[pos++] = BPF_STMT(BPF_RET | BPF_A, 0);
+
+	sock_fprog const prog
+	{
+		.len	= pos,
+		.filter	= code.data(),
+	};
+
+	return setsockopt(p_sock, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) ? NET_Error::Sock_Option : NET_Error::NoErr;
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_setQuickAck([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] bool const p_quickAck)
+{
+#ifdef TCP_QUICKACK
+	return Core_setSockOptInt(p_sock, IPPROTO_TCP, TCP_QUICKACK, p_quickAck ? 1 : 0);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_getQuickAck([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] bool& p_quickAck)
+{
+#ifdef TCP_QUICKACK
+	return Core_getSockOptBool(p_sock, IPPROTO_TCP, TCP_QUICKACK, p_quickAck);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_setCork([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] bool const p_cork)
+{
+#ifdef TCP_CORK
+	return Core_setSockOptInt(p_sock, IPPROTO_TCP, TCP_CORK, p_cork ? 1 : 0);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_getCork([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] bool& p_cork)
+{
+#ifdef TCP_CORK
+	return Core_getSockOptBool(p_sock, IPPROTO_TCP, TCP_CORK, p_cork);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_setNotSentLowat([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] uint32_t const p_size)
+{
+#ifdef TCP_NOTSENT_LOWAT
+	return Core_setSockOptUint(p_sock, IPPROTO_TCP, TCP_NOTSENT_LOWAT, p_size);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_getNotSentLowat([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] uint32_t& p_size)
+{
+#ifdef TCP_NOTSENT_LOWAT
+	return Core_getSockOptUint(p_sock, IPPROTO_TCP, TCP_NOTSENT_LOWAT, p_size);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_setFastOpen([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] uint32_t const p_queue_length)
+{
+#if defined(_WIN32) && defined(TCP_FASTOPEN)
+	return Core_setSockOptInt(p_sock, IPPROTO_TCP, TCP_FASTOPEN, p_queue_length ? 1 : 0);
+#elif defined(TCP_FASTOPEN)
+	return Core_setSockOptUint(p_sock, IPPROTO_TCP, TCP_FASTOPEN, p_queue_length);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_getFastOpen([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] uint32_t& p_queue_length)
+{
+#ifdef TCP_FASTOPEN
+	return Core_getSockOptUint(p_sock, IPPROTO_TCP, TCP_FASTOPEN, p_queue_length);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_setFastOpenConnect([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] bool const p_fastOpen)
+{
+#ifdef TCP_FASTOPEN_CONNECT
+	return Core_setSockOptInt(p_sock, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, p_fastOpen ? 1 : 0);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
+static inline NET_Error Core_getFastOpenConnect([[maybe_unused]] _p::SocketHandle_t const p_sock, [[maybe_unused]] bool& p_fastOpen)
+{
+#ifdef TCP_FASTOPEN_CONNECT
+	return Core_getSockOptBool(p_sock, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, p_fastOpen);
+#else
+	return NET_Error::Not_Supported;
+#endif
+}
+
 //========	========	========	========	========
 //========			Connect and Accept			========
 //========	========	========	========	========
@@ -1355,6 +1581,72 @@ NET_Error Net_Socket::set_linger(bool const p_linger, uint16_t const p_timeout)
 	return Core_setSockLinger(m_sock, p_linger, p_timeout);
 }
 
+NET_Error Net_Socket::set_receive_buffer_size(uint32_t const p_size)
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_setSockOptUint(m_sock, SOL_SOCKET, SO_RCVBUF, p_size);
+}
+
+NET_Error Net_Socket::get_receive_buffer_size(uint32_t& p_size) const
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_getSockOptUint(m_sock, SOL_SOCKET, SO_RCVBUF, p_size);
+}
+
+NET_Error Net_Socket::set_send_buffer_size(uint32_t const p_size)
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_setSockOptUint(m_sock, SOL_SOCKET, SO_SNDBUF, p_size);
+}
+
+NET_Error Net_Socket::get_send_buffer_size(uint32_t& p_size) const
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_getSockOptUint(m_sock, SOL_SOCKET, SO_SNDBUF, p_size);
+}
+
+NET_Error Net_Socket::set_reuse_port(bool const p_reuse)
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_setReusePort(m_sock, p_reuse);
+}
+
+NET_Error Net_Socket::get_reuse_port(bool& p_reuse) const
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_getReusePort(m_sock, p_reuse);
+}
+
+NET_Error Net_Socket::set_busy_poll(uint32_t const p_microseconds)
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_setBusyPoll(m_sock, p_microseconds);
+}
+
+NET_Error Net_Socket::get_busy_poll(uint32_t& p_microseconds) const
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_getBusyPoll(m_sock, p_microseconds);
+}
+
+NET_Error Net_Socket::set_incoming_cpu(uint32_t const p_cpu)
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_setIncomingCPU(m_sock, p_cpu);
+}
+
+NET_Error Net_Socket::get_incoming_cpu(uint32_t& p_cpu) const
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_getIncomingCPU(m_sock, p_cpu);
+}
+
+NET_Error Net_Socket::set_reuse_port_cpu_steering(std::span<uint32_t const> const p_cpu_map)
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_setReusePortCPUSteering(m_sock, p_cpu_map);
+}
+
 
 //========= ======== ======== NetUDP_p ========= ======== ========
 
@@ -1390,6 +1682,18 @@ NET_Error NetTCP_S_p::listen(int const p_max_connections)
 	return NET_Error::NoErr;
 }
 
+NET_Error NetTCP_S_p::set_fast_open(uint32_t const p_queue_length)
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_setFastOpen(m_sock, p_queue_length);
+}
+
+NET_Error NetTCP_S_p::get_fast_open(uint32_t& p_queue_length) const
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_getFastOpen(m_sock, p_queue_length);
+}
+
 
 //========= ======== ======== NetTCP_C_p ========= ======== ========
 
@@ -1431,6 +1735,54 @@ NET_Error NetTCP_C_p::set_keep_alive(bool const p_keepAlive, uint32_t const p_pr
 	return Core_SetKeepAlive(m_sock, p_keepAlive, p_probePeriod, p_maxProbes);
 }
 
+NET_Error NetTCP_C_p::set_quick_ack(bool const p_quickAck)
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_setQuickAck(m_sock, p_quickAck);
+}
+
+NET_Error NetTCP_C_p::get_quick_ack(bool& p_quickAck) const
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_getQuickAck(m_sock, p_quickAck);
+}
+
+NET_Error NetTCP_C_p::set_cork(bool const p_cork)
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_setCork(m_sock, p_cork);
+}
+
+NET_Error NetTCP_C_p::get_cork(bool& p_cork) const
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_getCork(m_sock, p_cork);
+}
+
+NET_Error NetTCP_C_p::set_notsent_lowat(uint32_t const p_size)
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_setNotSentLowat(m_sock, p_size);
+}
+
+NET_Error NetTCP_C_p::get_notsent_lowat(uint32_t& p_size) const
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_getNotSentLowat(m_sock, p_size);
+}
+
+NET_Error NetTCP_C_p::set_fast_open_connect(bool const p_fastOpen)
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_setFastOpenConnect(m_sock, p_fastOpen);
+}
+
+NET_Error NetTCP_C_p::get_fast_open_connect(bool& p_fastOpen) const
+{
+	if(m_sock == INVALID_SOCKET) return NET_Error::Invalid_Socket;
+	return Core_getFastOpenConnect(m_sock, p_fastOpen);
+}
+
 } //namesapce _p
 
 
@@ -0,0 +1,179 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <CoreLib/net/core_net_TCP_group.hpp>
+
+/// \n
+namespace core
+{
+
+NetTCP_S_group::~NetTCP_S_group()
+{
+	close();
+}
+
+NET_Error NetTCP_S_group::open_bind_listen(IP_address const& p_IP, uint16_t p_Port, uint32_t const p_count, int const p_max_connections, bool const p_blocking)
+{
+	if(!m_listeners.empty()) return NET_Error::Already_Used;
+	if(p_count == 0) return NET_Error::Invalid_Option;
+
+	m_listeners.reserve(p_count);
+	for(uint32_t i = 0; i < p_count; ++i)
+	{
+		NetTCP_S& t_listener = m_listeners.emplace_back();
+
+		NET_Error err = t_listener.open(p_IP.version(), p_blocking);
+		if(err == NET_Error::NoErr) err = t_listener.set_reuse_port(true);
+		if(err == NET_Error::NoErr) err = t_listener.bind(p_IP, p_Port);
+		if(err == NET_Error::NoErr && p_Port == 0)
+		{
+			//all other listeners must share the port the system picked for the first one
+			IP_address t_ip;
+			err = t_listener.get_address(t_ip, p_Port);
+		}
+		if(err == NET_Error::NoErr) err = t_listener.listen(p_max_connections);
+
+		if(err != NET_Error::NoErr)
+		{
+			m_listeners.clear();
+			return err;
+		}
+	}
+
+	return NET_Error::NoErr;
+}
+
+NET_Error NetTCP_S_group::set_cpu_steering(std::span<uint32_t const> const p_cpu_map)
+{
+	if(m_listeners.empty()) return NET_Error::Invalid_Socket;
+	if(p_cpu_map.size() != m_listeners.size()) return NET_Error::Invalid_Option;
+	return m_listeners.front().set_reuse_port_cpu_steering(p_cpu_map);
+}
+
+void NetTCP_S_group::worker_entry(void* const p_slot)
+{
+	worker_slot const& t_slot = *reinterpret_cast<worker_slot const*>(p_slot);
+	NetTCP_S_group& t_group = *t_slot.m_group;
+
+	t_group.m_start.wait(start_state::pending, std::memory_order::acquire);
+	if(t_group.m_start.load(std::memory_order::acquire) != start_state::go) return;
+
+	t_group.m_worker(t_group.m_listeners[t_slot.m_index], t_slot.m_index, t_group.m_context);
+}
+
+void NetTCP_S_group::release_workers(start_state const p_state)
+{
+	m_start.store(p_state, std::memory_order::release);
+	m_start.notify_all();
+}
+
+NET_Error NetTCP_S_group::run(worker_t const p_worker, void* const p_context, std::span<uint32_t const> const p_cpu_map)
+{
+	if(m_listeners.empty()) return NET_Error::Invalid_Socket;
+	if(!m_threads.empty()) return NET_Error::Already_Used;
+	if(p_worker == nullptr) return NET_Error::Invalid_Option;
+
+	uint32_t const t_count = size();
+	if(!p_cpu_map.empty())
+	{
+		if(p_cpu_map.size() != t_count) return NET_Error::Invalid_Option;
+		for(uint32_t const t_cpu : p_cpu_map)
+		{
+			if(t_cpu > 63) return NET_Error::Invalid_Option;
+		}
+	}
+
+	m_worker	= p_worker;
+	m_context	= p_context;
+	m_slots.resize(t_count);
+	m_threads.reserve(t_count);
+
+	for(uint32_t i = 0; i < t_count; ++i)
+	{
+		m_slots[i] = worker_slot{.m_group = this, .m_index = i};
+
+		thread& t_thread = m_threads.emplace_back();
+		if(t_thread.create(worker_entry, &m_slots[i]) != thread::Error::None)
+		{
+			m_threads.pop_back();
+			release_workers(start_state::abort);
+			stop();
+			return NET_Error::Fail;
+		}
+
+		if(!p_cpu_map.empty() && t_thread.set_affinity_mask(uint64_t{1} << p_cpu_map[i]) != thread::Error::None)
+		{
+			release_workers(start_state::abort);
+			stop();
+			return NET_Error::Fail;
+		}
+	}
+
+	release_workers(start_state::go);
+	return NET_Error::NoErr;
+}
+
+void NetTCP_S_group::stop()
+{
+	for(NetTCP_S& t_listener : m_listeners)
+	{
+		t_listener.shutdown(NetTCP_S::Endpoint::Both);
+	}
+
+	for(thread& t_thread : m_threads)
+	{
+		t_thread.join();
+	}
+
+	m_threads.clear();
+	m_slots.clear();
+	m_worker	= nullptr;
+	m_context	= nullptr;
+	m_start.store(start_state::pending, std::memory_order::relaxed);
+}
+
+NET_Error NetTCP_S_group::close()
+{
+	stop();
+
+	NET_Error ret = NET_Error::NoErr;
+	for(NetTCP_S& t_listener : m_listeners)
+	{
+		NET_Error const err = t_listener.close();
+		if(err != NET_Error::NoErr) ret = err;
+	}
+	m_listeners.clear();
+	return ret;
+}
+
+NET_Error NetTCP_S_group::get_address(IP_address& p_IP, uint16_t& p_Port)
+{
+	if(m_listeners.empty()) return NET_Error::Invalid_Socket;
+	return m_listeners.front().get_address(p_IP, p_Port);
+}
+
+} //namespace core
@@ -25,58 +25,348 @@
 ///		SOFTWARE.
 //======== ======== ======== ======== ======== ======== ======== ========
 
+#include <array>
+#include <bit>
+#include <algorithm>
+#include <type_traits>
+
 #include <CoreLib/net/core_net_address.hpp>
 #include <CoreLib/string/core_string_numeric.hpp>
 #include <CoreLib/core_endian.hpp>
 
+#if defined(_M_AMD64) or defined(__amd64__)
+#	include <emmintrin.h>
+#	define CORE_NET_ADDRESS_SSE2
+#endif
 
 namespace core
 {
 
 	namespace _p
 	{
+		//========	========	Formatting helpers		========	========
+
+		///	\brief Dot-decimal text of an octet
+		struct octet_text
+		{
+			std::array<char8_t, 3>	digits;
+			uint8_t					size;
+		};
+
+		static consteval std::array<octet_text, 256> make_octet_table()
+		{
+			std::array<octet_text, 256> table{};
+			for(uint16_t i = 0; i < 256; ++i)
+			{
+				octet_text& entry = table[i];
+				if(i >= 100)
+				{
+					entry.digits = {static_cast<char8_t>(u8'0' + i / 100), static_cast<char8_t>(u8'0' + (i / 10) % 10), static_cast<char8_t>(u8'0' + i % 10)};
+					entry.size = 3;
+				}
+				else if(i >= 10)
+				{
+					entry.digits = {static_cast<char8_t>(u8'0' + i / 10), static_cast<char8_t>(u8'0' + i % 10), u8'0'};
+					entry.size = 2;
+				}
+				else
+				{
+					entry.digits = {static_cast<char8_t>(u8'0' + i), u8'0', u8'0'};
+					entry.size = 1;
+				}
+			}
+			return table;
+		}
+
+		static constexpr std::array<octet_text, 256> octet_table = make_octet_table();
+
+		///	\brief Writes an octet in decimal, always stores 3 characters regardless of the octet's length.
+		///	\warning Only use if at least 3 characters are available at p_out
+		template<c_ipconv_char CharT>
+		static inline CharT* write_octet(uint8_t const p_val, CharT* const p_out)
+		{
+			octet_text const& entry = octet_table[p_val];
+			p_out[0] = entry.digits[0];
+			p_out[1] = entry.digits[1];
+			p_out[2] = entry.digits[2];
+			return p_out + entry.size;
+		}
+
+		///	\brief Writes an octet in decimal, stores exactly as many characters as needed.
+		template<c_ipconv_char CharT>
+		static inline CharT* write_octet_exact(uint8_t const p_val, CharT* const p_out)
+		{
+			octet_text const& entry = octet_table[p_val];
+			for(uint8_t i = 0; i < entry.size; ++i)
+			{
+				p_out[i] = entry.digits[i];
+			}
+			return p_out + entry.size;
+		}
+
+		///	\brief Finds the longest run of zero groups (the first one in case of a tie)
+		///	\param[out] p_pos - Index of the first group of the run
+		///	\param[out] p_size - Number of groups in the run, 0 if there are none
+		static inline void find_elide(std::span<uint16_t const, 8> const p_raw, uint8_t& p_pos, uint8_t& p_size)
+		{
+			uint32_t zero_mask = 0;
+			for(uint8_t it = 0; it < 8; ++it)
+			{
+				zero_mask |= static_cast<uint32_t>(p_raw[it] == 0) << it;
+			}
+
+			//each iteration keeps only the bits that start a run at least 1 group longer
+			uint32_t last_mask = 0;
+			uint8_t size = 0;
+			while(zero_mask)
+			{
+				last_mask = zero_mask;
+				zero_mask &= zero_mask >> 1;
+				++size;
+			}
+			p_size = size;
+			p_pos  = size ? static_cast<uint8_t>(std::countr_zero(last_mask)) : uint8_t{0};
+		}
+
+		//========	========	Parsing helpers		========	========
+
+		///	\brief Value of a character already known to be an hexadecimal digit
+		template<c_ipconv_char CharT>
+		static inline uint16_t hex_nibble(CharT const p_char)
+		{
+			return static_cast<uint16_t>((p_char & 0x0F) + 9 * (p_char >> 6));
+		}
+
+		///	\brief Checks that all characters are either decimal digits or '.'
+		///	\param[out] p_dot_mask - bit i is set if character i is a '.'
+		template<c_ipconv_char CharT>
+		static inline bool classify_IPv4(CharT const* const p_str, uint32_t const p_size, uint32_t& p_dot_mask)
+		{
+			uint32_t dot_mask = 0;
+			for(uint32_t i = 0; i < p_size; ++i)
+			{
+				CharT const tchar = p_str[i];
+				if(tchar == CharT{'.'})
+				{
+					dot_mask |= uint32_t{1} << i;
+				}
+				else if(static_cast<uint32_t>(tchar - CharT{'0'}) > 9)
+				{
+					return false;
+				}
+			}
+			p_dot_mask = dot_mask;
+			return true;
+		}
+
+		///	\brief Checks that all characters are either hexadecimal digits or ':'
+		///	\param[out] p_colon_mask - bit i is set if character i is a ':'
+		template<c_ipconv_char CharT>
+		static inline bool classify_IPv6(CharT const* const p_str, uint32_t const p_size, uint64_t& p_colon_mask)
+		{
+			uint64_t colon_mask = 0;
+			for(uint32_t i = 0; i < p_size; ++i)
+			{
+				CharT const tchar = p_str[i];
+				if(tchar == CharT{':'})
+				{
+					colon_mask |= uint64_t{1} << i;
+				}
+				else if(static_cast<uint32_t>(tchar - CharT{'0'}) > 9 && static_cast<uint32_t>((tchar | 0x20) - CharT{'a'}) > 5)
+				{
+					return false;
+				}
+			}
+			p_colon_mask = colon_mask;
+			return true;
+		}
+
+#ifdef CORE_NET_ADDRESS_SSE2
+		///	\brief Classifies 16 characters at a time
+		///	\param[out] p_valid_mask - bit i is set if character i is a digit or a separator
+		///	\param[out] p_sep_mask - bit i is set if character i is the separator
+		template<bool t_hex>
+		static inline void classify_block_sse2(char8_t const* const p_block, char const p_sep, uint32_t& p_valid_mask, uint32_t& p_sep_mask)
+		{
+			__m128i const text		= _mm_load_si128(reinterpret_cast<__m128i const*>(p_block));
+			__m128i const decimal	= _mm_sub_epi8(text, _mm_set1_epi8('0'));
+			__m128i const separator	= _mm_cmpeq_epi8(text, _mm_set1_epi8(p_sep));
+			__m128i valid			= _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(decimal, _mm_set1_epi8(9)), decimal), separator);
+			if constexpr(t_hex)
+			{
+				__m128i const alpha = _mm_sub_epi8(_mm_or_si128(text, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+				valid = _mm_or_si128(valid, _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha));
+			}
+			p_valid_mask	= static_cast<uint32_t>(_mm_movemask_epi8(valid));
+			p_sep_mask		= static_cast<uint32_t>(_mm_movemask_epi8(separator));
+		}
+
+		static inline bool classify_IPv4_sse2(char8_t const* const p_str, uint32_t const p_size, uint32_t& p_dot_mask)
+		{
+			alignas(16) char8_t buff[16] = {};
+			memcpy(buff, p_str, p_size);
+
+			uint32_t valid_mask;
+			uint32_t dot_mask;
+			classify_block_sse2<false>(buff, '.', valid_mask, dot_mask);
+
+			uint32_t const used = (uint32_t{1} << p_size) - 1;
+			if((valid_mask & used) != used) return false;
+			p_dot_mask = dot_mask & used;
+			return true;
+		}
+
+		static inline bool classify_IPv6_sse2(char8_t const* const p_str, uint32_t const p_size, uint64_t& p_colon_mask)
+		{
+			alignas(16) char8_t buff[48] = {};
+			memcpy(buff, p_str, p_size);
+
+			uint64_t valid_mask = 0;
+			uint64_t colon_mask = 0;
+			for(uint8_t block = 0; block < 3; ++block)
+			{
+				uint32_t block_valid;
+				uint32_t block_colon;
+				classify_block_sse2<true>(buff + block * 16, ':', block_valid, block_colon);
+				valid_mask |= uint64_t{block_valid} << (block * 16);
+				colon_mask |= uint64_t{block_colon} << (block * 16);
+			}
+
+			uint64_t const used = (uint64_t{1} << p_size) - 1;
+			if((valid_mask & used) != used) return false;
+			p_colon_mask = colon_mask & used;
+			return true;
+		}
+#endif // CORE_NET_ADDRESS_SSE2
+
+		///	\brief Builds the address from a string that only contains decimal digits and '.'
+		///	\param[in] p_dot_mask - bit i is set if character i is a '.'
+		template<c_ipconv_char CharT>
+		static inline bool assemble_IPv4(CharT const* const p_str, uint32_t const p_size, uint32_t p_dot_mask, std::span<uint8_t, 4> const p_out)
+		{
+			if(std::popcount(p_dot_mask) != 3) return false;
+
+			uint32_t start = 0;
+			for(uint8_t i = 0; i < 4; ++i)
+			{
+				uint32_t const end = (i < 3) ? static_cast<uint32_t>(std::countr_zero(p_dot_mask)) : p_size;
+				p_dot_mask &= p_dot_mask - 1;
+
+				uint32_t const len = end - start;
+				if(len - 1 > 2) return false;
+
+				CharT const* const group = p_str + start;
+				uint32_t val = static_cast<uint32_t>(group[0] - CharT{'0'});
+				for(uint32_t j = 1; j < len; ++j)
+				{
+					val = val * 10 + static_cast<uint32_t>(group[j] - CharT{'0'});
+				}
+				if(val > 255) return false;
+
+				p_out[i] = static_cast<uint8_t>(val);
+				start = end + 1;
+			}
+			return true;
+		}
+
+		///	\brief Builds the address from a string that only contains hexadecimal digits and ':'
+		///	\param[in] p_colon_mask - bit i is set if character i is a ':'
+		template<c_ipconv_char CharT>
+		static inline bool assemble_IPv6(CharT const* const p_str, uint32_t const p_size, uint64_t const p_colon_mask, std::span<uint16_t, 8> const p_out)
+		{
+			std::array<uint16_t, 8> groups;
+			uint8_t count = 0;
+			uint8_t elide_at = 0;
+			bool b_has_elide = false;
+
+			uint32_t pos = 0;
+			if(p_colon_mask & 1)
+			{
+				if(!(p_colon_mask & 2)) return false;
+				b_has_elide = true;
+				pos = 2;
+			}
+
+			while(pos < p_size)
+			{
+				uint64_t const rest = p_colon_mask >> pos;
+				uint32_t const len = rest ? static_cast<uint32_t>(std::countr_zero(rest)) : p_size - pos;
+
+				if(len == 0)
+				{
+					if(b_has_elide) return false;
+					b_has_elide = true;
+					elide_at = count;
+					++pos;
+					continue;
+				}
+
+				if(len > 4 || count == 8) return false;
+
+				CharT const* const group = p_str + pos;
+				uint16_t val = hex_nibble(group[0]);
+				for(uint32_t j = 1; j < len; ++j)
+				{
+					val = static_cast<uint16_t>((val << 4) | hex_nibble(group[j]));
+				}
+				groups[count++] = val;
+
+				pos += len;
+				if(pos == p_size) break;
+				if(++pos == p_size) return false;
+			}
+
+			uint8_t gap = 0;
+			if(b_has_elide)
+			{
+				if(count > 7) return false;
+				gap = 8 - count;
+			}
+			else
+			{
+				if(count != 8) return false;
+				elide_at = count;
+			}
+
+			uint8_t i = 0;
+			for(; i < elide_at; ++i)
+			{
+				p_out[i] = core::endian_host2big(groups[i]);
+			}
+			for(uint8_t j = 0; j < gap; ++j)
+			{
+				p_out[i + j] = 0;
+			}
+			for(; i < count; ++i)
+			{
+				p_out[i + gap] = core::endian_host2big(groups[i]);
+			}
+			return true;
+		}
+
+		//========	========	Conversion		========	========
+
 		template<c_ipconv_char CharT>
 		uintptr_t to_chars_IPv4(std::span<uint8_t const, 4> const p_raw, std::span<CharT, 15> const p_output)
 		{
+			//every octet starts at most on position 12, so it is always safe to write 3 characters
 			CharT* pivot = p_output.data();
-			pivot += core::to_chars(p_raw[0], std::span<CharT, 3>{pivot, 3});
+			pivot = write_octet(p_raw[0], pivot);
 			*(pivot++) = '.';
-			pivot += core::to_chars(p_raw[1], std::span<CharT, 3>{pivot, 3});
+			pivot = write_octet(p_raw[1], pivot);
 			*(pivot++) = '.';
-			pivot += core::to_chars(p_raw[2], std::span<CharT, 3>{pivot, 3});
+			pivot = write_octet(p_raw[2], pivot);
 			*(pivot++) = '.';
-			pivot += core::to_chars(p_raw[3], std::span<CharT, 3>{pivot, 3});
+			pivot = write_octet(p_raw[3], pivot);
 			return static_cast<uintptr_t>(pivot - p_output.data());
 		}
 
 		template<c_ipconv_char CharT>
 		uintptr_t to_chars_IPv6(std::span<uint16_t const, 8> const p_raw, std::span<CharT, 39> const p_out)
 		{
-			uint8_t size_elide = 0;
-			uint8_t pos_elide = 0;
-			{
-				for(uint8_t it = 0; it < 8;)
-				{
-					if(p_raw[it] == 0)
-					{
-						uint8_t const curret_pos = it;
-						uint8_t curret_size = 1;
-						while(++it < 8 && p_raw[it] == 0)
-						{
-							++curret_size;
-						}
-						if(curret_size > size_elide)
-						{
-							size_elide = curret_size;
-							pos_elide  = curret_pos;
-						}
-					}
-					else
-					{
-						++it;
-					}
-				}
-			}
+			uint8_t size_elide;
+			uint8_t pos_elide;
+			find_elide(p_raw, pos_elide, size_elide);
 
 			CharT* pivot = p_out.data();
 			if(size_elide > 1)
@@ -129,25 +419,19 @@ namespace core
 				return false;
 			}
 
-			uintptr_t pos2 = 0;
-			for(uintptr_t i = 0; i < 3; ++i)
+			uint32_t dot_mask;
+#ifdef CORE_NET_ADDRESS_SSE2
+			if constexpr(std::is_same_v<CharT, char8_t>)
 			{
-				uintptr_t const pos1 = p_address.find(CharT{'.'}, pos2);
-				if(pos1 - pos2 > 3 || pos1 == pos2) return false;
-
-				from_chars_result<uint8_t> const auxRet = from_chars<uint8_t>(p_address.substr(pos2, pos1 - pos2));
-				if(!auxRet.has_value()) return false;
-
-				p_out[i] = auxRet.value();
-				pos2 = pos1 + 1;
+				if(!classify_IPv4_sse2(p_address.data(), static_cast<uint32_t>(size), dot_mask)) return false;
+			}
+			else
+#endif
+			{
+				if(!classify_IPv4(p_address.data(), static_cast<uint32_t>(size), dot_mask)) return false;
 			}
 
-			if(size - pos2 > 3 || size == pos2) return false;
-
-			from_chars_result<uint8_t> const auxRet = from_chars<uint8_t>(p_address.substr(pos2, size - pos2));
-			if(!auxRet.has_value()) return false;
-			p_out[3] = auxRet.value();
-			return true;
+			return assemble_IPv4(p_address.data(), static_cast<uint32_t>(size), dot_mask, p_out);
 		}
 
 		template<c_ipconv_char CharT>
@@ -156,107 +440,19 @@ namespace core
 			uintptr_t const size = p_address.size();
 			if(size < 2 || size > 39) return false;
 
-			bool b_has_elide = false;
-			uintptr_t pos2;
-			uint8_t   count;
-
-			if(p_address[0] == ':')
+			uint64_t colon_mask;
+#ifdef CORE_NET_ADDRESS_SSE2
+			if constexpr(std::is_same_v<CharT, char8_t>)
 			{
-				if(p_address[1] != ':') return false;
-				count	= 2;
-				pos2	= 2;
-				b_has_elide = true;
+				if(!classify_IPv6_sse2(p_address.data(), static_cast<uint32_t>(size), colon_mask)) return false;
 			}
 			else
+#endif
 			{
-				count	= 0;
-				pos2	= 0;
+				if(!classify_IPv6(p_address.data(), static_cast<uint32_t>(size), colon_mask)) return false;
 			}
 
-			std::array<uint16_t, 8> pre_elide;
-			std::array<uint16_t, 8> post_elide;
-			uint8_t pre_elide_size = 0;
-			uint8_t post_elide_size = 0;
-
-			CharT const* tdata = p_address.data();
-			uintptr_t pos1 = 0;
-			for(; count < 8; ++count)
-			{
-				pos1 = p_address.find(':', pos2);
-				if(pos1 == std::basic_string_view<CharT>::npos)
-				{
-					if(size == pos2) break;
-					if(size - pos2 > 4) return false;
-
-					from_chars_result<uint16_t> auxRet =
-						from_chars_hex<uint16_t, CharT>(std::basic_string_view<CharT>{tdata + pos2, size - pos2});
-					if(!auxRet.has_value())
-					{
-						return false;
-					}
-					uint16_t const auxI = core::endian_host2big(auxRet.value());
-
-					if(b_has_elide)	post_elide[post_elide_size++] = auxI;
-					else			pre_elide [pre_elide_size++ ] = auxI;
-					break;
-				}
-
-				if(pos1 - pos2 > 4) return false;
-				if(pos1 == pos2)
-				{
-					if(b_has_elide) return false;
-					b_has_elide = true;
-					pos2 = pos1 + 1;
-					continue;
-				}
-
-				from_chars_result<uint16_t> auxRet =
-					from_chars_hex<uint16_t, CharT>(std::basic_string_view<CharT>{tdata + pos2, pos1 - pos2});
-				if(!auxRet.has_value())
-				{
-					return false;
-				}
-
-				uint16_t const auxI = core::endian_host2big(auxRet.value());
-
-				if(b_has_elide)	post_elide[post_elide_size++] = auxI;
-				else			pre_elide [pre_elide_size++ ] = auxI;
-
-				pos2 = pos1 + 1;
-				if(pos2 >= size) return false;
-			}
-
-			if(pos1 != std::basic_string_view<CharT>::npos) return false;
-
-			if(b_has_elide)
-			{
-				uintptr_t const post_elid_start = 8 - post_elide_size;
-
-				uint16_t* pivot = p_out.data();
-				{
-					uint8_t i = 0;
-					for(; i < pre_elide_size; ++i)
-					{
-						*(pivot++) = pre_elide[i];
-					}
-
-					for(; i < post_elid_start; ++i)
-					{
-						*(pivot++) = 0;
-					}
-				}
-				for(uint8_t i = 0; i < post_elide_size; ++i)
-				{
-					*(pivot++) = post_elide[i];
-				}
-				return true;
-			}
-			else
-			{
-				if(count < 8) return false;
-				memcpy(p_out.data(), pre_elide.data(), 16);
-				return true;
-			}
+			return assemble_IPv6(p_address.data(), static_cast<uint32_t>(size), colon_mask, p_out);
 		}
 
 
@@ -274,52 +470,31 @@ namespace core
 [[nodiscard]] uintptr_t to_chars_IPv4_size(std::span<uint8_t const, 4> const p_raw)
 {
 	return
-		to_chars_size(p_raw[0]) +
-		to_chars_size(p_raw[1]) +
-		to_chars_size(p_raw[2]) +
-		to_chars_size(p_raw[3]) + 3;
+		_p::octet_table[p_raw[0]].size +
+		_p::octet_table[p_raw[1]].size +
+		_p::octet_table[p_raw[2]].size +
+		_p::octet_table[p_raw[3]].size + 3;
 }
 
 template<_p::c_ipconv_char CharT>
 CharT* to_chars_IPv4_unsafe(std::span<uint8_t const, 4> const p_raw, CharT* p_out)
 {
-	p_out += core::to_chars(p_raw[0], std::span<CharT, 3>{p_out, 3});
+	//the first 3 octets are always followed by at least 2 characters
+	p_out = _p::write_octet(p_raw[0], p_out);
 	*(p_out++) = '.';
-	p_out += core::to_chars(p_raw[1], std::span<CharT, 3>{p_out, 3});
+	p_out = _p::write_octet(p_raw[1], p_out);
 	*(p_out++) = '.';
-	p_out += core::to_chars(p_raw[2], std::span<CharT, 3>{p_out, 3});
+	p_out = _p::write_octet(p_raw[2], p_out);
 	*(p_out++) = '.';
-	return core::to_chars_unsafe(p_raw[3], p_out);
+	return _p::write_octet_exact(p_raw[3], p_out);
 }
 
 
 uintptr_t to_chars_IPv6_size(std::span<uint16_t const, 8> const p_raw)
 {
-	uint8_t size_elide = 0;
-	uint8_t pos_elide = 0;
-	{
-		for(uint8_t it = 0; it < 8;)
-		{
-			if(p_raw[it] == 0)
-			{
-				uint8_t const curret_pos = it;
-				uint8_t curret_size = 1;
-				while(++it < 8 && p_raw[it] == 0)
-				{
-					++curret_size;
-				}
-				if(curret_size > size_elide)
-				{
-					size_elide = curret_size;
-					pos_elide  = curret_pos;
-				}
-			}
-			else
-			{
-				++it;
-			}
-		}
-	}
+	uint8_t size_elide;
+	uint8_t pos_elide;
+	_p::find_elide(p_raw, pos_elide, size_elide);
 
 	if(size_elide > 1)
 	{
@@ -366,31 +541,9 @@ uintptr_t to_chars_IPv6_size(std::span<uint16_t const, 8> const p_raw)
 template<_p::c_ipconv_char CharT>
 CharT* to_chars_IPv6_unsafe(std::span<uint16_t const, 8> const p_raw, CharT* p_out)
 {
-	uint8_t size_elide = 0;
-	uint8_t pos_elide = 0;
-	{
-		for(uint8_t it = 0; it < 8;)
-		{
-			if(p_raw[it] == 0)
-			{
-				uint8_t const curret_pos = it;
-				uint8_t curret_size = 1;
-				while(++it < 8 && p_raw[it] == 0)
-				{
-					++curret_size;
-				}
-				if(curret_size > size_elide)
-				{
-					size_elide = curret_size;
-					pos_elide  = curret_pos;
-				}
-			}
-			else
-			{
-				++it;
-			}
-		}
-	}
+	uint8_t size_elide;
+	uint8_t pos_elide;
+	_p::find_elide(p_raw, pos_elide, size_elide);
 
 	if(size_elide > 1)
 	{
@@ -958,5 +1111,124 @@ bool IPv6_address::operator < (IPv6_address const& p_other) const
 
 
 
+//========= ======== ======== Bulk conversion ========= ======== ========
+
+uintptr_t from_string_bulk(std::span<std::u8string_view const> const p_addresses, std::span<IPv4_address> const p_out)
+{
+	uintptr_t const count = std::min(p_addresses.size(), p_out.size());
+	uintptr_t parsed = 0;
+	for(uintptr_t i = 0; i < count; ++i)
+	{
+		if(_p::from_chars_IPv4(p_addresses[i], p_out[i].byteField))
+		{
+			++parsed;
+		}
+		else
+		{
+			p_out[i].ui32Type = 0;
+		}
+	}
+	return parsed;
+}
+
+uintptr_t from_string_bulk(std::span<std::u8string_view const> const p_addresses, std::span<IPv6_address> const p_out)
+{
+	uintptr_t const count = std::min(p_addresses.size(), p_out.size());
+	uintptr_t parsed = 0;
+	for(uintptr_t i = 0; i < count; ++i)
+	{
+		if(_p::from_chars_IPv6(p_addresses[i], p_out[i].doubletField))
+		{
+			++parsed;
+		}
+		else
+		{
+			p_out[i].ui64Type[0] = 0;
+			p_out[i].ui64Type[1] = 0;
+		}
+	}
+	return parsed;
+}
+
+uintptr_t from_string_bulk(std::span<std::u8string_view const> const p_addresses, std::span<IP_address> const p_out)
+{
+	uintptr_t const count = std::min(p_addresses.size(), p_out.size());
+	uintptr_t parsed = 0;
+	for(uintptr_t i = 0; i < count; ++i)
+	{
+		if(p_out[i].from_string(p_addresses[i]))
+		{
+			++parsed;
+		}
+	}
+	return parsed;
+}
+
+uintptr_t to_string_bulk(std::span<IPv4_address const> const p_addresses, std::span<char8_t> const p_output, std::span<uintptr_t> const p_sizes)
+{
+	uintptr_t const count = std::min(p_addresses.size(), p_sizes.size());
+	char8_t* pivot = p_output.data();
+	char8_t* const end = pivot + p_output.size();
+	for(uintptr_t i = 0; i < count; ++i)
+	{
+		std::span<uint8_t const, 4> const raw = p_addresses[i].byteField;
+		if(static_cast<uintptr_t>(end - pivot) < 15 && to_chars_IPv4_size(raw) > static_cast<uintptr_t>(end - pivot))
+		{
+			return i;
+		}
+		char8_t* const next = to_chars_IPv4_unsafe(raw, pivot);
+		p_sizes[i] = static_cast<uintptr_t>(next - pivot);
+		pivot = next;
+	}
+	return count;
+}
+
+uintptr_t to_string_bulk(std::span<IPv6_address const> const p_addresses, std::span<char8_t> const p_output, std::span<uintptr_t> const p_sizes)
+{
+	uintptr_t const count = std::min(p_addresses.size(), p_sizes.size());
+	char8_t* pivot = p_output.data();
+	char8_t* const end = pivot + p_output.size();
+	for(uintptr_t i = 0; i < count; ++i)
+	{
+		std::span<uint16_t const, 8> const raw = p_addresses[i].doubletField;
+		if(static_cast<uintptr_t>(end - pivot) < 39 && to_chars_IPv6_size(raw) > static_cast<uintptr_t>(end - pivot))
+		{
+			return i;
+		}
+		char8_t* const next = to_chars_IPv6_unsafe(raw, pivot);
+		p_sizes[i] = static_cast<uintptr_t>(next - pivot);
+		pivot = next;
+	}
+	return count;
+}
+
+uintptr_t to_string_bulk(std::span<IP_address const> const p_addresses, std::span<char8_t> const p_output, std::span<uintptr_t> const p_sizes)
+{
+	uintptr_t const count = std::min(p_addresses.size(), p_sizes.size());
+	char8_t* pivot = p_output.data();
+	char8_t* const end = pivot + p_output.size();
+	for(uintptr_t i = 0; i < count; ++i)
+	{
+		IP_address const& address = p_addresses[i];
+		uintptr_t const available = static_cast<uintptr_t>(end - pivot);
+		char8_t* next = pivot;
+		switch(address.version())
+		{
+		case IP_address::IPv::IPv_4:
+			if(available < 15 && to_chars_IPv4_size(address.v4.byteField) > available) return i;
+			next = to_chars_IPv4_unsafe(std::span<uint8_t const, 4>{address.v4.byteField}, pivot);
+			break;
+		case IP_address::IPv::IPv_6:
+			if(available < 39 && to_chars_IPv6_size(address.v6.doubletField) > available) return i;
+			next = to_chars_IPv6_unsafe(std::span<uint16_t const, 8>{address.v6.doubletField}, pivot);
+			break;
+		default:
+			break;
+		}
+		p_sizes[i] = static_cast<uintptr_t>(next - pivot);
+		pivot = next;
+	}
+	return count;
+}
 
-} //namespace core
\ No newline at end of file
+} //namespace core
@@ -0,0 +1,286 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <CoreLib/net/core_net_buffer_pool.hpp>
+#include <CoreLib/net/core_net_TCP.hpp>
+#include <CoreLib/net/core_net_UDP.hpp>
+
+#include <atomic>
+#include <algorithm>
+#include <new>
+
+#include "../core_thread_binding.hpp"
+
+/// \n
+namespace core
+{
+
+namespace
+{
+	static constexpr uintptr_t block_alignment = 64;
+
+	inline void*& next_of(void* const p_block)
+	{
+		return *reinterpret_cast<void**>(p_block);
+	}
+} //namespace
+
+namespace _p
+{
+	///	\brief Blocks cached by a thread for the last pool it used.
+	struct Net_buffer_thread_cache
+	{
+		Net_buffer_pool*	m_pool	= nullptr;
+		uint64_t			m_id	= 0;
+		uint32_t			m_count	= 0;
+		void*				m_blocks[Net_buffer_pool::thread_cache_size];
+
+		///	\brief Gives all blocks back to the pool they came from, and unbinds the cache
+		void unbind();
+		inline ~Net_buffer_thread_cache() { unbind(); }
+	};
+
+	static thread_local Net_buffer_thread_cache t_cache;
+} //namespace _p
+
+
+//======== ======== ======== Net_buffer_pool ======== ======== ========
+
+Net_buffer_pool::Net_buffer_pool(uintptr_t const p_block_size, uint32_t const p_blocks_per_slab, uint32_t const p_max_slabs)
+	: m_id				(_p::owner_registry::instance().add())
+	, m_block_size		(std::max((p_block_size + block_alignment - 1) & ~(block_alignment - 1), block_alignment))
+	, m_blocks_per_slab	(std::max(p_blocks_per_slab, uint32_t{1}))
+	, m_max_slabs		(p_max_slabs)
+{
+}
+
+Net_buffer_pool::~Net_buffer_pool()
+{
+	//after this no thread cache will try to give blocks back
+	_p::owner_registry::instance().remove(m_id);
+
+	if(_p::t_cache.m_id == m_id)
+	{
+		_p::t_cache.m_pool	= nullptr;
+		_p::t_cache.m_id	= 0;
+		_p::t_cache.m_count	= 0;
+	}
+
+	for(void* const t_slab : m_slabs)
+	{
+		::operator delete(t_slab, std::align_val_t{block_alignment});
+	}
+}
+
+void* Net_buffer_pool::pop_shared()
+{
+	void* t_block;
+	{
+		atomic_spinlock::scope_locker const lock(m_lock);
+		t_block = m_free;
+		if(t_block)
+		{
+			m_free = next_of(t_block);
+			return t_block;
+		}
+	}
+	return allocate_slab();
+}
+
+uint32_t Net_buffer_pool::pop_shared(void** const p_out, uint32_t const p_count)
+{
+	uint32_t t_count = 0;
+	atomic_spinlock::scope_locker const lock(m_lock);
+	while(t_count < p_count && m_free)
+	{
+		p_out[t_count++] = m_free;
+		m_free = next_of(m_free);
+	}
+	return t_count;
+}
+
+void Net_buffer_pool::push_shared(void* const* const p_blocks, uint32_t const p_count)
+{
+	if(p_count == 0) return;
+
+	//chain them before taking the lock
+	for(uint32_t i = 1; i < p_count; ++i)
+	{
+		next_of(p_blocks[i - 1]) = p_blocks[i];
+	}
+
+	atomic_spinlock::scope_locker const lock(m_lock);
+	next_of(p_blocks[p_count - 1]) = m_free;
+	m_free = p_blocks[0];
+}
+
+void* Net_buffer_pool::allocate_slab()
+{
+	{
+		atomic_spinlock::scope_locker const lock(m_lock);
+		if(m_max_slabs && m_slabs.size() >= m_max_slabs) return nullptr;
+	}
+
+	uint8_t* const t_slab = reinterpret_cast<uint8_t*>(::operator new(m_block_size * m_blocks_per_slab, std::align_val_t{block_alignment}, std::nothrow));
+	if(t_slab == nullptr) return nullptr;
+
+	atomic_spinlock::scope_locker const lock(m_lock);
+	if(m_max_slabs && m_slabs.size() >= m_max_slabs)
+	{
+		//another thread reached the limit first
+		::operator delete(t_slab, std::align_val_t{block_alignment});
+		void* const t_block = m_free;
+		if(t_block)
+		{
+			m_free = next_of(t_block);
+		}
+		return t_block;
+	}
+	m_slabs.push_back(t_slab);
+
+	//first block is handed to the caller, the rest goes to the free list
+	for(uint32_t i = m_blocks_per_slab - 1; i > 0; --i)
+	{
+		void* const t_block = t_slab + i * m_block_size;
+		next_of(t_block) = m_free;
+		m_free = t_block;
+	}
+	return t_slab;
+}
+
+Net_buffer Net_buffer_pool::acquire()
+{
+	_p::Net_buffer_thread_cache& t_local = _p::t_cache;
+	if(t_local.m_id != m_id)
+	{
+		t_local.unbind();
+		t_local.m_pool	= this;
+		t_local.m_id	= m_id;
+	}
+
+	if(t_local.m_count == 0)
+	{
+		//refill half of the cache in one go
+		t_local.m_count = pop_shared(t_local.m_blocks, thread_cache_size / 2);
+		if(t_local.m_count == 0)
+		{
+			return Net_buffer{this, reinterpret_cast<uint8_t*>(pop_shared())};
+		}
+	}
+
+	return Net_buffer{this, reinterpret_cast<uint8_t*>(t_local.m_blocks[--t_local.m_count])};
+}
+
+void Net_buffer_pool::give_back(uint8_t* const p_block)
+{
+	_p::Net_buffer_thread_cache& t_local = _p::t_cache;
+	if(t_local.m_id != m_id)
+	{
+		t_local.unbind();
+		t_local.m_pool	= this;
+		t_local.m_id	= m_id;
+	}
+
+	if(t_local.m_count == thread_cache_size)
+	{
+		//keep the most recently used half, as it is more likely to still be in cache
+		push_shared(t_local.m_blocks, thread_cache_size / 2);
+		std::copy(t_local.m_blocks + thread_cache_size / 2, t_local.m_blocks + thread_cache_size, t_local.m_blocks);
+		t_local.m_count = thread_cache_size / 2;
+	}
+
+	t_local.m_blocks[t_local.m_count++] = p_block;
+}
+
+void Net_buffer_pool::flush_thread_cache()
+{
+	_p::Net_buffer_thread_cache& t_local = _p::t_cache;
+	if(t_local.m_id == m_id)
+	{
+		push_shared(t_local.m_blocks, t_local.m_count);
+		t_local.m_count = 0;
+	}
+}
+
+uintptr_t Net_buffer_pool::capacity() const
+{
+	atomic_spinlock::scope_locker const lock(m_lock);
+	return m_slabs.size() * m_blocks_per_slab;
+}
+
+namespace _p
+{
+	void Net_buffer_thread_cache::unbind()
+	{
+		if(m_count)
+		{
+			_p::owner_registry& t_registry = _p::owner_registry::instance();
+			atomic_spinlock::scope_locker const lock(t_registry.lock());
+			//the pool may have been destroyed, in which case the blocks are already gone
+			if(t_registry.is_alive(m_id))
+			{
+				m_pool->push_shared(m_blocks, m_count);
+			}
+		}
+		m_pool	= nullptr;
+		m_id	= 0;
+		m_count	= 0;
+	}
+} //namespace _p
+
+
+//======== ======== ======== receive_pooled ======== ======== ========
+
+NET_Error receive_pooled(_p::NetTCP_C_p& p_socket, Net_buffer_pool& p_pool, Net_buffer& p_buffer)
+{
+	Net_buffer t_buffer = p_pool.acquire();
+	if(!t_buffer.is_valid()) return NET_Error::Buffer_Full;
+
+	uintptr_t t_received = 0;
+	NET_Error const err = p_socket.receive_size(t_buffer.data(), t_buffer.capacity(), t_received);
+	if(err != NET_Error::NoErr) return err;
+
+	t_buffer.set_size(t_received);
+	p_buffer = std::move(t_buffer);
+	return NET_Error::NoErr;
+}
+
+NET_Error receive_pooled(_p::NetUDP_p& p_socket, Net_buffer_pool& p_pool, Net_buffer& p_buffer)
+{
+	Net_buffer t_buffer = p_pool.acquire();
+	if(!t_buffer.is_valid()) return NET_Error::Buffer_Full;
+
+	uintptr_t t_received = t_buffer.capacity();
+	NET_Error const err = p_socket.receive(t_buffer.data(), t_received);
+	if(err != NET_Error::NoErr) return err;
+
+	t_buffer.set_size(t_received);
+	p_buffer = std::move(t_buffer);
+	return NET_Error::NoErr;
+}
+
+} //namespace core
@@ -0,0 +1,330 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+
+#include <CoreLib/net/core_net_prefix_table.hpp>
+
+#include <algorithm>
+
+#include <CoreLib/string/core_string_numeric.hpp>
+
+namespace core
+{
+	namespace _p
+	{
+		//======== ======== ======== prefix_trie ======== ======== ========
+
+		template<uint8_t t_key_size>
+		uint32_t prefix_trie<t_key_size>::make_child(uint32_t const p_pos)
+		{
+			uint32_t const entry = m_entries[p_pos];
+			if(entry & child_flag)
+			{
+				return entry & ~child_flag;
+			}
+
+			//the new chunk inherits the entry it replaces
+			uint8_t const depth = m_depth[p_pos];
+			uint32_t const chunk = static_cast<uint32_t>((m_entries.size() - root_size) / chunk_size);
+			m_entries.resize(m_entries.size() + chunk_size, entry);
+			m_depth  .resize(m_depth  .size() + chunk_size, depth);
+			m_entries[p_pos] = chunk | child_flag;
+			return chunk;
+		}
+
+		template<uint8_t t_key_size>
+		void prefix_trie<t_key_size>::set_entry(uint32_t const p_pos, uint8_t const p_len, uint32_t const p_rule)
+		{
+			uint32_t const entry = m_entries[p_pos];
+			if(entry & child_flag)
+			{
+				uint32_t const base = root_size + (entry & ~child_flag) * chunk_size;
+				for(uint32_t i = 0; i < chunk_size; ++i)
+				{
+					set_entry(base + i, p_len, p_rule);
+				}
+			}
+			else if(m_depth[p_pos] <= p_len)
+			{
+				m_entries[p_pos]	= p_rule + 1;
+				m_depth[p_pos]		= p_len;
+			}
+		}
+
+		template<uint8_t t_key_size>
+		uint32_t prefix_trie<t_key_size>::insert(std::span<uint8_t const, t_key_size> const p_key, uint8_t const p_len, uint32_t const p_rule)
+		{
+			std::array<uint8_t, t_key_size> network;
+			for(uint8_t i = 0; i < t_key_size; ++i)
+			{
+				uint8_t const bits = static_cast<uint8_t>(std::clamp<int16_t>(static_cast<int16_t>(p_len - i * 8), 0, 8));
+				network[i] = p_key[i] & static_cast<uint8_t>(0xFF00 >> bits);
+			}
+
+			auto const [rule, inserted] = m_rules.try_emplace(std::pair{network, p_len}, p_rule);
+			if(!inserted)
+			{
+				//the entries already point to the rule
+				return rule->second;
+			}
+
+			if(m_entries.empty())
+			{
+				m_entries.assign(root_size, 0);
+				m_depth  .assign(root_size, 0);
+			}
+
+			uint32_t const root_index = (static_cast<uint32_t>(p_key[0]) << 8) | p_key[1];
+			if(p_len <= 16)
+			{
+				uint32_t const count = uint32_t{1} << (16 - p_len);
+				uint32_t const first = root_index & ~(count - 1);
+				for(uint32_t i = 0; i < count; ++i)
+				{
+					set_entry(first + i, p_len, p_rule);
+				}
+				return p_rule;
+			}
+
+			uint32_t pos = root_index;
+			uint8_t remaining = p_len - 16;
+			for(uint8_t level = 2; ; ++level)
+			{
+				uint32_t const base = root_size + make_child(pos) * chunk_size;
+				if(remaining <= 8)
+				{
+					uint32_t const count = uint32_t{1} << (8 - remaining);
+					uint32_t const first = p_key[level] & ~(count - 1);
+					for(uint32_t i = 0; i < count; ++i)
+					{
+						set_entry(base + first + i, p_len, p_rule);
+					}
+					return p_rule;
+				}
+				pos = base + p_key[level];
+				remaining -= 8;
+			}
+		}
+
+		template<uint8_t t_key_size>
+		void prefix_trie<t_key_size>::clear()
+		{
+			m_entries.clear();
+			m_entries.shrink_to_fit();
+			m_depth.clear();
+			m_depth.shrink_to_fit();
+			m_rules.clear();
+		}
+
+		template class prefix_trie<4>;
+		template class prefix_trie<16>;
+	} //namespace _p
+
+	//======== ======== ======== IP_prefix_table ======== ======== ========
+
+	bool IP_prefix_table::insert(std::u8string_view const p_cidr, uint32_t const p_value)
+	{
+		uintptr_t const slash = p_cidr.find(u8'/');
+
+		IP_address network;
+		if(!network.from_string(p_cidr.substr(0, slash)))
+		{
+			return false;
+		}
+
+		uint8_t prefix_length = (network.version() == IP_address::IPv::IPv_4) ? 32 : 128;
+		if(slash != std::u8string_view::npos)
+		{
+			from_chars_result<uint8_t> const res = from_chars<uint8_t>(p_cidr.substr(slash + 1));
+			if(!res.has_value())
+			{
+				return false;
+			}
+			prefix_length = res.value();
+		}
+
+		return insert(network, prefix_length, p_value);
+	}
+
+	bool IP_prefix_table::insert(IPv4_address const& p_network, uint8_t const p_prefix_length, uint32_t const p_value)
+	{
+		if(p_prefix_length > 32 || m_values.size() >= _p::prefix_trie<4>::child_flag - 1)
+		{
+			return false;
+		}
+		uint32_t const rule = m_v4.insert(std::span<uint8_t const, 4>{p_network.byteField}, p_prefix_length, static_cast<uint32_t>(m_values.size()));
+		if(rule == m_values.size())
+		{
+			m_values.push_back(p_value);
+		}
+		else
+		{
+			m_values[rule] = p_value;
+		}
+		return true;
+	}
+
+	bool IP_prefix_table::insert(IPv6_address const& p_network, uint8_t const p_prefix_length, uint32_t const p_value)
+	{
+		if(p_prefix_length > 128 || m_values.size() >= _p::prefix_trie<16>::child_flag - 1)
+		{
+			return false;
+		}
+		uint32_t const rule = m_v6.insert(std::span<uint8_t const, 16>{p_network.byteField}, p_prefix_length, static_cast<uint32_t>(m_values.size()));
+		if(rule == m_values.size())
+		{
+			m_values.push_back(p_value);
+		}
+		else
+		{
+			m_values[rule] = p_value;
+		}
+		return true;
+	}
+
+	bool IP_prefix_table::insert(IP_address const& p_network, uint8_t const p_prefix_length, uint32_t const p_value)
+	{
+		switch(p_network.version())
+		{
+		case IP_address::IPv::IPv_4:
+			return insert(IPv4_address{std::span<uint8_t const, 4>{p_network.v4.byteField}}, p_prefix_length, p_value);
+		case IP_address::IPv::IPv_6:
+			return insert(IPv6_address{std::span<uint16_t const, 8>{p_network.v6.doubletField}}, p_prefix_length, p_value);
+		default:
+			break;
+		}
+		return false;
+	}
+
+	void IP_prefix_table::clear()
+	{
+		m_v4.clear();
+		m_v6.clear();
+		m_values.clear();
+	}
+
+	uint32_t IP_prefix_table::lookup(IP_address const& p_address) const
+	{
+		switch(p_address.version())
+		{
+		case IP_address::IPv::IPv_4:
+			{
+				std::span<uint8_t const, 4> const key = p_address.v4.byteField;
+				uint32_t const entry = m_v4.resolve(key, m_v4.root(key));
+				return entry ? m_values[entry - 1] : no_match;
+			}
+		case IP_address::IPv::IPv_6:
+			{
+				std::span<uint8_t const, 16> const key = p_address.v6.byteField;
+				uint32_t const entry = m_v6.resolve(key, m_v6.root(key));
+				return entry ? m_values[entry - 1] : no_match;
+			}
+		default:
+			break;
+		}
+		return no_match;
+	}
+
+	void IP_prefix_table::lookup(std::span<IPv4_address const> const p_addresses, std::span<uint32_t> const p_out) const
+	{
+		uintptr_t const count = std::min(p_addresses.size(), p_out.size());
+		for(uintptr_t base = 0; base < count; base += batch_size)
+		{
+			uintptr_t const end = std::min(count, base + batch_size);
+			for(uintptr_t i = base; i < end; ++i)
+			{
+				p_out[i] = m_v4.root(p_addresses[i].byteField);
+			}
+			for(uintptr_t i = base; i < end; ++i)
+			{
+				uint32_t const entry = m_v4.resolve(p_addresses[i].byteField, p_out[i]);
+				p_out[i] = entry ? m_values[entry - 1] : no_match;
+			}
+		}
+	}
+
+	void IP_prefix_table::lookup(std::span<IPv6_address const> const p_addresses, std::span<uint32_t> const p_out) const
+	{
+		uintptr_t const count = std::min(p_addresses.size(), p_out.size());
+		for(uintptr_t base = 0; base < count; base += batch_size)
+		{
+			uintptr_t const end = std::min(count, base + batch_size);
+			for(uintptr_t i = base; i < end; ++i)
+			{
+				p_out[i] = m_v6.root(p_addresses[i].byteField);
+			}
+			for(uintptr_t i = base; i < end; ++i)
+			{
+				uint32_t const entry = m_v6.resolve(p_addresses[i].byteField, p_out[i]);
+				p_out[i] = entry ? m_values[entry - 1] : no_match;
+			}
+		}
+	}
+
+	void IP_prefix_table::lookup(std::span<IP_address const> const p_addresses, std::span<uint32_t> const p_out) const
+	{
+		uintptr_t const count = std::min(p_addresses.size(), p_out.size());
+		for(uintptr_t base = 0; base < count; base += batch_size)
+		{
+			uintptr_t const end = std::min(count, base + batch_size);
+			for(uintptr_t i = base; i < end; ++i)
+			{
+				IP_address const& address = p_addresses[i];
+				switch(address.version())
+				{
+				case IP_address::IPv::IPv_4:
+					p_out[i] = m_v4.root(address.v4.byteField);
+					break;
+				case IP_address::IPv::IPv_6:
+					p_out[i] = m_v6.root(address.v6.byteField);
+					break;
+				default:
+					p_out[i] = 0;
+					break;
+				}
+			}
+			for(uintptr_t i = base; i < end; ++i)
+			{
+				IP_address const& address = p_addresses[i];
+				uint32_t entry = p_out[i];
+				switch(address.version())
+				{
+				case IP_address::IPv::IPv_4:
+					entry = m_v4.resolve(address.v4.byteField, entry);
+					break;
+				case IP_address::IPv::IPv_6:
+					entry = m_v6.resolve(address.v6.byteField, entry);
+					break;
+				default:
+					break;
+				}
+				p_out[i] = entry ? m_values[entry - 1] : no_match;
+			}
+		}
+	}
+
+} //namespace core
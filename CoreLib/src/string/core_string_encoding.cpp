@@ -31,8 +31,16 @@
 #include <bit>
 #include <cstring>
 
+#include <CoreLib/core_extra_compiler.hpp>
+#include <CoreLib/core_type.hpp>
+
+#if defined(_M_AMD64) || defined(__amd64__)
+#	include <immintrin.h>
+#endif
+
 namespace core
 {
+using literals::operator ""_ui64;
 
 namespace
 {
@@ -1354,8 +1362,73 @@ uintptr_t __estimate_UCS4_UTF16(char32_t const p_char)
 	return 0;
 }
 
+static bool ASCII_Compliant_scalar(char8_t const* p_input, uintptr_t const p_size)
+{
+	char8_t const* const end = p_input + p_size;
+	for(; p_input < end; ++p_input)
+	{
+		if(*p_input > 0x7F) return false;
+	}
+	return true;
+}
+
+#if defined(_M_AMD64) || defined(__amd64__)
+TARGET_AVX2 static bool ASCII_Compliant_avx2(char8_t const* p_input, uintptr_t const p_size)
+{
+	char8_t const* const end = p_input + p_size;
+	for(; end - p_input >= 128; p_input += 128)
+	{
+		__m256i const* const block = reinterpret_cast<__m256i const*>(p_input);
+		__m256i const merged =
+			_mm256_or_si256(
+				_mm256_or_si256(_mm256_loadu_si256(block    ), _mm256_loadu_si256(block + 1)),
+				_mm256_or_si256(_mm256_loadu_si256(block + 2), _mm256_loadu_si256(block + 3)));
+		if(_mm256_movemask_epi8(merged)) return false;
+	}
+	for(; end - p_input >= 32; p_input += 32)
+	{
+		if(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p_input)))) return false;
+	}
+	return ASCII_Compliant_scalar(p_input, static_cast<uintptr_t>(end - p_input));
+}
+
+TARGET_AVX512 static bool ASCII_Compliant_avx512(char8_t const* p_input, uintptr_t const p_size)
+{
+	__m512i const high = _mm512_set1_epi8(static_cast<char>(0x80));
+
+	char8_t const* const end = p_input + p_size;
+	for(; end - p_input >= 256; p_input += 256)
+	{
+		__m512i const merged =
+			_mm512_or_si512(
+				_mm512_or_si512(_mm512_loadu_si512(p_input      ), _mm512_loadu_si512(p_input +  64)),
+				_mm512_or_si512(_mm512_loadu_si512(p_input + 128), _mm512_loadu_si512(p_input + 192)));
+		if(_mm512_test_epi8_mask(merged, high)) return false;
+	}
+	for(; end - p_input >= 64; p_input += 64)
+	{
+		if(_mm512_test_epi8_mask(_mm512_loadu_si512(p_input), high)) return false;
+	}
+	if(p_input < end)
+	{
+		__mmask64 const tail = ~0_ui64 >> (64 - (end - p_input));
+		return !_mm512_mask_test_epi8_mask(tail, _mm512_maskz_loadu_epi8(tail, p_input), high);
+	}
+	return true;
+}
+#endif
+
 } //namespace
 
+namespace _p
+{
+#if defined(_M_AMD64) || defined(__amd64__)
+	constinit cpu_dispatch<bool(char8_t const*, uintptr_t)> const ASCII_Compliant_dispatch{ASCII_Compliant_scalar, nullptr, ASCII_Compliant_avx2, ASCII_Compliant_avx512};
+#else
+	constinit cpu_dispatch<bool(char8_t const*, uintptr_t)> const ASCII_Compliant_dispatch{ASCII_Compliant_scalar, nullptr, nullptr, nullptr};
+#endif
+} //namespace _p
+
 [[nodiscard]] std::optional<uintptr_t> UTF8_to_ANSI_size(std::u8string_view const p_input)
 {
 	uintptr_t count = 0;
@@ -2362,11 +2435,7 @@ bool UCS4_UNICODE_Compliant(std::u32string_view const p_input)
 
 bool ASCII_Compliant(std::u8string_view const p_input)
 {
-	for(char8_t const tchar: p_input)
-	{
-		if(tchar > 0x7F) return false;
-	}
-	return true;
+	return _p::ASCII_Compliant_dispatch(p_input.data(), p_input.size());
 }
 
 bool ASCII_Compliant(std::u32string_view const p_input)
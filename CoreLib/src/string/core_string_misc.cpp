@@ -27,8 +27,16 @@
 
 #include <CoreLib/string/core_string_misc.hpp>
 
+#include <CoreLib/core_extra_compiler.hpp>
+#include <CoreLib/core_type.hpp>
+
+#if defined(_M_AMD64) || defined(__amd64__)
+#	include <immintrin.h>
+#endif
+
 namespace core
 {
+using literals::operator ""_ui64;
 
 //======== ======== Private ======== ========
 
@@ -38,24 +46,83 @@ static inline bool isUpper		(T const p_char) { return (p_char >= 'A' && p_char <
 template <typename T = char32_t>
 static inline bool isLower		(T const p_char) { return (p_char >= 'a' && p_char <= 'z'); }
 
-void toLowerCase(std::span<char8_t> const p_str)
+namespace
 {
-	char8_t* pos = p_str.data();
-	char8_t const* const end = pos + p_str.size();
-	for(; pos < end; ++pos)
+	//flips the case of letters in the range [t_first, t_first + 25], 'A' lowers 'a' raises
+	template<char8_t t_first>
+	static void flip_case_scalar(char8_t* p_str, uintptr_t const p_size)
+	{
+		char8_t const* const end = p_str + p_size;
+		for(; p_str < end; ++p_str)
+		{
+			if(static_cast<uint8_t>(*p_str - t_first) < 26) *p_str ^= 0x20;
+		}
+	}
+
+#if defined(_M_AMD64) || defined(__amd64__)
+	template<char8_t t_first>
+	TARGET_AVX2 static void flip_case_avx2(char8_t* p_str, uintptr_t const p_size)
 	{
-		if(isUpper(*pos)) *pos += ('a' - 'A');
+		//shifts the range to start at -128, so that a single signed compare selects it
+		__m256i const bias	= _mm256_set1_epi8(static_cast<char>(0x80 - t_first));
+		__m256i const limit	= _mm256_set1_epi8(static_cast<char>(0x80 + 26));
+		__m256i const flip	= _mm256_set1_epi8(0x20);
+
+		char8_t const* const end = p_str + p_size;
+		for(; end - p_str >= 32; p_str += 32)
+		{
+			__m256i const data = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p_str));
+			__m256i const letters = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(data, bias));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(p_str), _mm256_xor_si256(data, _mm256_and_si256(letters, flip)));
+		}
+		flip_case_scalar<t_first>(p_str, static_cast<uintptr_t>(end - p_str));
 	}
+
+	template<char8_t t_first>
+	TARGET_AVX512 static void flip_case_avx512(char8_t* p_str, uintptr_t const p_size)
+	{
+		__m512i const first	= _mm512_set1_epi8(static_cast<char>(t_first));
+		__m512i const range	= _mm512_set1_epi8(26);
+		__m512i const flip	= _mm512_set1_epi8(0x20);
+
+		char8_t const* const end = p_str + p_size;
+		for(; end - p_str >= 64; p_str += 64)
+		{
+			__m512i const data = _mm512_loadu_si512(p_str);
+			__mmask64 const letters = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(data, first), range);
+			_mm512_storeu_si512(p_str, _mm512_xor_si512(data, _mm512_maskz_mov_epi8(letters, flip)));
+		}
+
+		if(p_str < end)
+		{
+			__mmask64 const tail = ~0_ui64 >> (64 - (end - p_str));
+			__m512i const data = _mm512_maskz_loadu_epi8(tail, p_str);
+			__mmask64 const letters = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(data, first), range);
+			_mm512_mask_storeu_epi8(p_str, tail & letters, _mm512_xor_si512(data, flip));
+		}
+	}
+#endif
+} //namespace
+
+namespace _p
+{
+#if defined(_M_AMD64) || defined(__amd64__)
+	constinit cpu_dispatch<void(char8_t*, uintptr_t)> const toLowerCase_dispatch{flip_case_scalar<u8'A'>, nullptr, flip_case_avx2<u8'A'>, flip_case_avx512<u8'A'>};
+	constinit cpu_dispatch<void(char8_t*, uintptr_t)> const toUpperCase_dispatch{flip_case_scalar<u8'a'>, nullptr, flip_case_avx2<u8'a'>, flip_case_avx512<u8'a'>};
+#else
+	constinit cpu_dispatch<void(char8_t*, uintptr_t)> const toLowerCase_dispatch{flip_case_scalar<u8'A'>, nullptr, nullptr, nullptr};
+	constinit cpu_dispatch<void(char8_t*, uintptr_t)> const toUpperCase_dispatch{flip_case_scalar<u8'a'>, nullptr, nullptr, nullptr};
+#endif
+} //namespace _p
+
+void toLowerCase(std::span<char8_t> const p_str)
+{
+	_p::toLowerCase_dispatch(p_str.data(), p_str.size());
 }
 
 void toUpperCase(std::span<char8_t> const p_str)
 {
-	char8_t* pos = p_str.data();
-	char8_t const* const end = pos + p_str.size();
-	for(; pos < end; ++pos)
-	{
-		if(isLower(*pos)) *pos -= ('a' - 'A');
-	}
+	_p::toUpperCase_dispatch(p_str.data(), p_str.size());
 }
 
 std::u8string toLowerCaseX(std::u8string_view const p_str)
@@ -0,0 +1,282 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <CoreLib/toPrint/toPrint_deferred.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <memory>
+
+#include "../core_thread_binding.hpp"
+
+namespace core
+{
+	namespace _p
+	{
+		///	\brief Single producer single consumer ring of records
+		struct deferred_ring
+		{
+			alignas(64) std::atomic<uint64_t>	m_head	{0};	//!< Written by the producer
+			alignas(64) std::atomic<uint64_t>	m_tail	{0};	//!< Written by the consumer
+			alignas(64) std::atomic<bool>		m_owned	{false};
+			uintptr_t const						m_mask;
+			std::unique_ptr<std::byte[]> const	m_data;
+
+			deferred_ring(uintptr_t const p_size)
+				: m_mask(p_size - 1)
+				, m_data(new (std::nothrow) std::byte[p_size])
+			{
+			}
+		};
+
+		///	\brief Rings bound by a thread to the printers it has used.
+		static thread_local thread_binding_cache<deferred_ring> t_deferred_cache;
+	} //namespace _p
+
+	namespace
+	{
+		static inline uintptr_t ring_used(_p::deferred_ring const& p_ring)
+		{
+			return static_cast<uintptr_t>(p_ring.m_head.load(std::memory_order::relaxed) - p_ring.m_tail.load(std::memory_order::acquire));
+		}
+
+		///	\brief Text rendered is handed over to the output once it grows past this
+		static constexpr uintptr_t render_batch = 0x10000;
+	} //namespace
+
+	deferred_printer::~deferred_printer()
+	{
+		stop();
+	}
+
+	std::errc deferred_printer::start(output_t const p_output, void* const p_context, uintptr_t const p_ring_size, uint32_t const p_flush_interval, overflow const p_policy)
+	{
+		stop();
+		if(!p_output) return std::errc::invalid_argument;
+		if(p_ring_size < sizeof(_p::deferred_record_header) || p_ring_size > (uintptr_t{1} << 31)) return std::errc::invalid_argument;
+
+		m_ring_size			= std::bit_ceil(p_ring_size);
+		m_flush_interval	= p_flush_interval;
+		m_policy			= p_policy;
+		m_stop.store(false, std::memory_order::relaxed);
+		m_wake.store(false, std::memory_order::relaxed);
+		m_dropped.store(0, std::memory_order::relaxed);
+		m_trap.reset();
+
+		m_output	= p_output;
+		m_context	= p_context;
+		if(m_thread.create(this, &deferred_printer::renderer, nullptr) != thread::Error::None)
+		{
+			m_output	= nullptr;
+			m_context	= nullptr;
+			return std::errc::resource_unavailable_try_again;
+		}
+		m_id = _p::owner_registry::instance().add();
+		return std::errc{};
+	}
+
+	void deferred_printer::stop()
+	{
+		if(!m_output) return;
+
+		m_stop.store(true, std::memory_order::release);
+		m_trap.signal();
+		m_thread.join();
+
+		//after this no thread will try to give back its ring
+		_p::owner_registry::instance().remove(m_id);
+		m_id = 0;
+
+		drain();
+		for(_p::deferred_ring* const t_ring : m_rings)
+		{
+			delete t_ring;
+		}
+		m_rings.clear();
+		m_render.clear();
+		m_output	= nullptr;
+		m_context	= nullptr;
+	}
+
+	_p::deferred_ring* deferred_printer::bind()
+	{
+		_p::thread_binding_cache<_p::deferred_ring>& t_cache = _p::t_deferred_cache;
+
+		_p::deferred_ring* t_ring = t_cache.find(m_id);
+		if(t_ring) return t_ring;
+
+		t_ring = _p::claim_free_slot(m_lock, m_rings);
+		if(!t_ring)
+		{
+			t_ring = new (std::nothrow) _p::deferred_ring(m_ring_size);
+			if(!t_ring) return nullptr;
+			if(!t_ring->m_data)
+			{
+				delete t_ring;
+				return nullptr;
+			}
+			t_ring->m_owned.store(true, std::memory_order::relaxed);
+			atomic_spinlock::scope_locker const lock(m_lock);
+			m_rings.push_back(t_ring);
+		}
+
+		t_cache.bind(m_id, t_ring);
+		return t_ring;
+	}
+
+	void deferred_printer::wake()
+	{
+		if(!m_wake.exchange(true, std::memory_order::seq_cst))
+		{
+			m_trap.signal();
+		}
+	}
+
+	std::byte* deferred_printer::reserve(uintptr_t const p_size)
+	{
+		if(!m_output) return nullptr;
+
+		_p::deferred_ring* const t_ring = bind();
+		if(!t_ring || p_size > m_ring_size)
+		{
+			m_dropped.fetch_add(1, std::memory_order::relaxed);
+			return nullptr;
+		}
+
+		while(true)
+		{
+			uint64_t const head = t_ring->m_head.load(std::memory_order::relaxed);
+			uintptr_t const t_free = m_ring_size - ring_used(*t_ring);
+			uintptr_t const t_start = static_cast<uintptr_t>(head) & t_ring->m_mask;
+			uintptr_t const t_contiguous = m_ring_size - t_start;
+
+			if(p_size <= t_contiguous)
+			{
+				if(p_size <= t_free)
+				{
+					return t_ring->m_data.get() + t_start;
+				}
+			}
+			else if(t_contiguous <= t_free)
+			{
+				//records are never split, skip to the start of the ring
+				_p::deferred_record_header const t_padding{.size = static_cast<uint32_t>(t_contiguous), .reserved = 0, .decode = nullptr};
+				memcpy(t_ring->m_data.get() + t_start, &t_padding, sizeof(t_padding));
+				t_ring->m_head.store(head + t_contiguous, std::memory_order::seq_cst);
+				continue;
+			}
+
+			wake();
+			if(m_policy == overflow::drop)
+			{
+				m_dropped.fetch_add(1, std::memory_order::relaxed);
+				return nullptr;
+			}
+			thread_yield();
+		}
+	}
+
+	void deferred_printer::commit(uintptr_t const p_size)
+	{
+		//the binding was made by reserve
+		_p::deferred_ring* const t_ring = bind();
+		t_ring->m_head.fetch_add(p_size, std::memory_order::seq_cst);
+
+		if(ring_used(*t_ring) >= m_ring_size / 2)
+		{
+			wake();
+		}
+	}
+
+	void deferred_printer::flush()
+	{
+		if(m_output) drain();
+	}
+
+	void deferred_printer::drain()
+	{
+		mutex::scope_locker const drain_lock(m_drain_lock);
+
+		std::vector<_p::deferred_ring*> t_rings;
+		{
+			atomic_spinlock::scope_locker const lock(m_lock);
+			t_rings = m_rings;
+		}
+
+		for(_p::deferred_ring* const t_ring : t_rings)
+		{
+			uint64_t tail = t_ring->m_tail.load(std::memory_order::relaxed);
+			uint64_t const head = t_ring->m_head.load(std::memory_order::acquire);
+
+			while(tail != head)
+			{
+				std::byte const* const t_record = t_ring->m_data.get() + (static_cast<uintptr_t>(tail) & t_ring->m_mask);
+				_p::deferred_record_header t_header;
+				memcpy(&t_header, t_record, sizeof(t_header));
+
+				if(t_header.decode)
+				{
+					t_header.decode(t_record + sizeof(t_header), m_render);
+				}
+				tail += t_header.size;
+
+				if(m_render.size() >= render_batch)
+				{
+					t_ring->m_tail.store(tail, std::memory_order::release);
+					m_output(m_context, m_render);
+					m_render.clear();
+				}
+			}
+			t_ring->m_tail.store(tail, std::memory_order::release);
+		}
+
+		if(!m_render.empty())
+		{
+			m_output(m_context, m_render);
+			m_render.clear();
+		}
+	}
+
+	void deferred_printer::renderer(void*)
+	{
+		while(!m_stop.load(std::memory_order::acquire))
+		{
+			if(m_flush_interval)
+			{
+				m_trap.timed_wait(m_flush_interval);
+			}
+			else
+			{
+				m_trap.wait();
+			}
+			m_trap.reset();
+			m_wake.store(false, std::memory_order::seq_cst);
+			drain();
+		}
+	}
+} //namespace core
@@ -0,0 +1,159 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <gtest/gtest.h>
+
+#include <CoreLib/core_console.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+
+#ifdef __unix__
+
+#include <string>
+#include <string_view>
+
+#include <poll.h>
+#include <unistd.h>
+
+using namespace std::literals::string_view_literals;
+
+namespace
+{
+	class console_pipe
+	{
+	public:
+		console_pipe()
+		{
+			int fds[2];
+			if(pipe(fds) == 0)
+			{
+				m_read = fds[0];
+				m_write = fds[1];
+			}
+		}
+
+		~console_pipe()
+		{
+			if(m_read != -1) close(m_read);
+			if(m_write != -1) close(m_write);
+		}
+
+		///	\brief Reads whatever is available, waiting at most p_timeout milliseconds for the first byte
+		std::string read_available(int const p_timeout = 0)
+		{
+			std::string res;
+			pollfd poll_fd{.fd = m_read, .events = POLLIN, .revents = 0};
+			int timeout = p_timeout;
+			while(poll(&poll_fd, 1, timeout) == 1)
+			{
+				char buff[256];
+				ssize_t const count = ::read(m_read, buff, sizeof(buff));
+				if(count < 1) break;
+				res.append(buff, static_cast<size_t>(count));
+				timeout = 0;
+			}
+			return res;
+		}
+
+		int m_read = -1;
+		int m_write = -1;
+	};
+} //namespace
+
+TEST(console, buffered)
+{
+	console_pipe tpipe;
+	ASSERT_NE(tpipe.m_write, -1);
+	core::console_out const out{tpipe.m_write};
+
+	{
+		core::console_out_buffered tsink{out, 32};
+		core::print<char8_t>(tsink, "value "sv, 42, '\n');
+		core::print<char16_t>(tsink, u"wide "sv, 7);
+		ASSERT_EQ(tpipe.read_available(), ""sv);
+
+		core::print<char8_t>(tsink, " does not fit in the rest"sv);
+		ASSERT_EQ(tpipe.read_available(), "value 42\nwide 7"sv);
+
+		tsink.put(u8'a');
+		tsink.put(U'\u00E9');
+		ASSERT_EQ(tpipe.read_available(), ""sv);
+		tsink.flush();
+		ASSERT_EQ(tpipe.read_available(), " does not fit in the resta\xC3\xA9"sv);
+
+		tsink.write(std::string(100, 'x'));
+		ASSERT_EQ(tpipe.read_available(), std::string(100, 'x'));
+
+		tsink.write("at destruction"sv);
+	}
+	ASSERT_EQ(tpipe.read_available(), "at destruction"sv);
+
+	{
+		core::console_out_buffered tsink{out, 0x1000, true};
+		core::print<char8_t>(tsink, "no new line "sv);
+		ASSERT_EQ(tpipe.read_available(), ""sv);
+		core::print<char8_t>(tsink, "line\n"sv);
+		ASSERT_EQ(tpipe.read_available(), "no new line line\n"sv);
+	}
+
+	{
+		core::console_out_buffered tsink{out, 0x1000, false, 1};
+		core::print<char8_t>(tsink, "held"sv);
+		usleep(5000);
+		core::print<char8_t>(tsink, " released"sv);
+		ASSERT_EQ(tpipe.read_available(), "held released"sv);
+	}
+}
+
+TEST(console, buffered_writer)
+{
+	console_pipe tpipe;
+	ASSERT_NE(tpipe.m_write, -1);
+	core::console_out const out{tpipe.m_write};
+
+	{
+		core::console_out_buffered tsink{out, 64};
+		ASSERT_EQ(tsink.start_writer(), std::errc{});
+
+		std::string expected;
+		for(uint32_t i = 0; i < 200; ++i)
+		{
+			core::print<char8_t>(tsink, "line "sv, i, '\n');
+			expected += "line " + std::to_string(i) + "\n";
+		}
+		tsink.stop_writer();
+		ASSERT_EQ(tpipe.read_available(), expected);
+	}
+
+	{
+		core::console_out_buffered tsink{out, 0x1000, false, 10};
+		ASSERT_EQ(tsink.start_writer(), std::errc{});
+		core::print<char8_t>(tsink, "by the writer"sv);
+		ASSERT_EQ(tpipe.read_available(2000), "by the writer"sv);
+	}
+}
+
+#endif //__unix__
@@ -0,0 +1,178 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <CoreLib/core_cpu_dispatch.hpp>
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/string/core_string_encoding.hpp>
+#include <CoreLib/string/core_string_misc.hpp>
+
+#include <gtest/gtest.h>
+
+using core::literals::operator ""_ui32;
+using core::literals::operator ""_uip;
+
+namespace
+{
+	static uint32_t g_last_kernel = 0;
+
+	static void kernel_0() { g_last_kernel = 0; }
+	static void kernel_2() { g_last_kernel = 2; }
+
+	//random text with a configurable proportion of letters, digits and non-ASCII bytes
+	static std::vector<char8_t> make_text(std::mt19937& p_rand, uintptr_t const p_size, bool const p_high)
+	{
+		std::vector<char8_t> out(p_size);
+		std::uniform_int_distribution<uint32_t> dist(0, p_high ? 0xFF : 0x7F);
+		for(char8_t& tchar: out)
+		{
+			tchar = static_cast<char8_t>(dist(p_rand));
+		}
+		return out;
+	}
+
+	//sizes and misalignments that cover the vector bodies, their unrolled loops and the tails
+	static constexpr uintptr_t max_size = 300;
+	static constexpr uintptr_t max_offset = 3;
+} //namespace
+
+TEST(core_cpu_dispatch, level_names)
+{
+	for(uint8_t level = 0; level < core::isa_level_count; ++level)
+	{
+		std::u8string_view const name = core::isa_level_name(static_cast<core::isa_level>(level));
+		ASSERT_FALSE(name.empty());
+		std::optional<core::isa_level> const parsed = core::isa_level_from_name(name);
+		ASSERT_TRUE(parsed.has_value());
+		ASSERT_EQ(parsed.value(), static_cast<core::isa_level>(level));
+	}
+
+	ASSERT_EQ(core::isa_level_from_name(u8"AVX2"), core::isa_level::avx2);
+	ASSERT_EQ(core::isa_level_from_name(u8"SSE4.2"), core::isa_level::sse4_2);
+	ASSERT_FALSE(core::isa_level_from_name(u8"avx").has_value());
+	ASSERT_FALSE(core::isa_level_from_name(u8"").has_value());
+	ASSERT_TRUE(core::isa_level_name(static_cast<core::isa_level>(core::isa_level_count)).empty());
+}
+
+TEST(core_cpu_dispatch, active_level)
+{
+	ASSERT_LE(core::isa_level_active(), core::isa_level_supported());
+}
+
+TEST(core_cpu_dispatch, fallback)
+{
+	constexpr core::cpu_dispatch<void()> dispatch{kernel_0, nullptr, kernel_2, nullptr};
+
+	ASSERT_EQ(dispatch.kernel(core::isa_level::scalar), kernel_0);
+	ASSERT_EQ(dispatch.kernel(core::isa_level::sse4_2), kernel_0);
+	ASSERT_EQ(dispatch.kernel(core::isa_level::avx2), kernel_2);
+	ASSERT_EQ(dispatch.kernel(core::isa_level::avx512), kernel_2);
+
+	ASSERT_EQ(dispatch.resolved(), dispatch.kernel(core::isa_level_active()));
+	ASSERT_EQ(dispatch.resolved(), dispatch.resolved());
+
+	g_last_kernel = 1;
+	dispatch();
+	ASSERT_EQ(g_last_kernel, dispatch.resolved() == kernel_2 ? 2_ui32 : 0_ui32);
+
+	std::vector<core::isa_level> visited;
+	dispatch.for_each_kernel([&visited](core::isa_level const p_level, void(* const)()) { visited.push_back(p_level); });
+	ASSERT_FALSE(visited.empty());
+	ASSERT_EQ(visited.front(), core::isa_level::scalar);
+	ASSERT_EQ(visited.size(), core::isa_level_supported() >= core::isa_level::avx2 ? 2_uip : 1_uip);
+}
+
+TEST(core_cpu_dispatch, ASCII_Compliant_kernels)
+{
+	using kernel_t = core::cpu_dispatch<bool(char8_t const*, uintptr_t)>::kernel_t;
+	core::cpu_dispatch<bool(char8_t const*, uintptr_t)> const& dispatch = core::_p::ASCII_Compliant_dispatch;
+	kernel_t const reference = dispatch.kernel(core::isa_level::scalar);
+
+	std::mt19937 rand{47};
+	std::vector<char8_t> const ascii = make_text(rand, max_size + max_offset, false);
+
+	dispatch.for_each_kernel([&](core::isa_level const p_level, kernel_t const p_kernel)
+		{
+			for(uintptr_t offset = 0; offset <= max_offset; ++offset)
+			{
+				for(uintptr_t size = 0; size <= max_size; ++size)
+				{
+					char8_t const* const data = ascii.data() + offset;
+					ASSERT_TRUE(p_kernel(data, size)) << "level " << static_cast<uint32_t>(p_level) << " size " << size;
+
+					//a single non-ASCII byte at every position, and just outside the range
+					std::vector<char8_t> mutated{ascii};
+					for(uintptr_t pos = 0; pos < size + offset + 1 && pos < mutated.size(); ++pos)
+					{
+						mutated[pos] = 0x80;
+						char8_t const* const mdata = mutated.data() + offset;
+						ASSERT_EQ(p_kernel(mdata, size), reference(mdata, size))
+							<< "level " << static_cast<uint32_t>(p_level) << " size " << size << " pos " << pos;
+						mutated[pos] = ascii[pos];
+					}
+				}
+			}
+		});
+}
+
+TEST(core_cpu_dispatch, case_kernels)
+{
+	using kernel_t = core::cpu_dispatch<void(char8_t*, uintptr_t)>::kernel_t;
+
+	std::mt19937 rand{47};
+	std::vector<char8_t> const text = make_text(rand, max_size + max_offset, true);
+
+	for(core::cpu_dispatch<void(char8_t*, uintptr_t)> const* const dispatch: {&core::_p::toLowerCase_dispatch, &core::_p::toUpperCase_dispatch})
+	{
+		kernel_t const reference = dispatch->kernel(core::isa_level::scalar);
+
+		dispatch->for_each_kernel([&](core::isa_level const p_level, kernel_t const p_kernel)
+			{
+				for(uintptr_t offset = 0; offset <= max_offset; ++offset)
+				{
+					for(uintptr_t size = 0; size <= max_size; ++size)
+					{
+						std::vector<char8_t> expected{text};
+						std::vector<char8_t> result{text};
+						reference(expected.data() + offset, size);
+						p_kernel(result.data() + offset, size);
+						ASSERT_EQ(result, expected) << "level " << static_cast<uint32_t>(p_level) << " size " << size;
+					}
+				}
+			});
+	}
+
+	std::u8string sample{u8"Some RandOM text! wiTh miSC ChaRaCTErs aNd !34#$%@[`{"};
+	core::toLowerCase(sample);
+	ASSERT_EQ(sample, u8"some random text! with misc characters and !34#$%@[`{");
+	core::toUpperCase(sample);
+	ASSERT_EQ(sample, u8"SOME RANDOM TEXT! WITH MISC CHARACTERS AND !34#$%@[`{");
+}
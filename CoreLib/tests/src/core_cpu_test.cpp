@@ -0,0 +1,118 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <string>
+#include <string_view>
+
+#include <CoreLib/core_cpu.hpp>
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_cpu.hpp>
+#include <CoreLib/toPrint/toPrint_string_sink.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::literals::string_view_literals;
+using core::literals::operator ""_ui32;
+
+#if defined(_M_AMD64) or defined(__amd64__)
+
+TEST(core_cpu, topology)
+{
+	core::amd64::cpu_topology const topology = core::amd64::query_cpu_topology();
+
+	uint8_t last_level = 0;
+	for(core::amd64::cache_info const& info: topology.caches)
+	{
+		ASSERT_GE(info.level, last_level);
+		last_level = info.level;
+		ASSERT_GE(info.level, 1);
+		ASSERT_GT(info.line_size, 0);
+		ASSERT_EQ(info.line_size & (info.line_size - 1), 0) << "line size is not a power of 2";
+		ASSERT_GT(info.shared_by, 0);
+		ASSERT_EQ(info.size, uint64_t{info.ways} * info.partitions * info.line_size * info.sets);
+	}
+
+	for(core::amd64::tlb_info const& info: topology.tlbs)
+	{
+		ASSERT_GT(info.entries, 0_ui32);
+		ASSERT_NE(info.page_sizes, 0);
+		ASSERT_GT(info.ways, 0);
+	}
+
+	ASSERT_GT(topology.line_size(), 0);
+	if(!topology.caches.empty())
+	{
+		ASSERT_NE(topology.data_cache(1), nullptr);
+		ASSERT_EQ(topology.line_size(), topology.data_cache(1)->line_size);
+		ASSERT_EQ(topology.last_level_size(), topology.caches.back().size);
+	}
+
+	if(!topology.hybrid)
+	{
+		ASSERT_EQ(core::amd64::current_core_type(), core::amd64::core_type::unknown);
+	}
+
+	core::amd64::cpu_topology const& cached = core::amd64::cpu_topology_g();
+	ASSERT_EQ(&cached, &core::amd64::cpu_topology_g());
+	ASSERT_EQ(cached.caches.size(), topology.caches.size());
+}
+
+TEST(core_cpu, toPrint_cpu_topology)
+{
+	core::amd64::cpu_topology topology;
+	topology.caches.push_back({49152, 64, 64, 12, 1, 2, 1, core::amd64::cache_type::data, false, false});
+	topology.caches.push_back({2 * 1024 * 1024, 2048, 64, 16, 1, 2, 2, core::amd64::cache_type::unified, false, true});
+	topology.caches.push_back({1000, 1, 8, 125, 1, 1, 3, core::amd64::cache_type::unified, true, false});
+	topology.tlbs.push_back({64, 4, 2, 1, core::amd64::tlb_type::load, core::amd64::tlb_page::size_4K, false});
+	topology.tlbs.push_back({32, 32, 0, 1, core::amd64::tlb_type::instruction, core::amd64::tlb_page::size_2M | core::amd64::tlb_page::size_4M, true});
+	topology.hybrid = true;
+	topology.core = core::amd64::core_type::efficiency;
+
+	std::u8string tsink;
+	core::print<char8_t>(tsink, core::toPrint_cpu_topology{topology});
+	ASSERT_EQ(tsink,
+		u8"L1d: 48KiB, 12-way, 64B line, shared by 2\n"
+		u8"L2: 2MiB, 16-way, 64B line, shared by 2, inclusive\n"
+		u8"L3: 1000B, fully associative, 8B line, shared by 1\n"
+		u8"L1ld TLB 4K: 64 entries, 4-way, shared by 2\n"
+		u8"L1i TLB 2M/4M: 32 entries, fully associative\n"
+		u8"hybrid, core: efficiency"sv);
+
+	core::amd64::cpu_topology hybrid_only;
+	hybrid_only.hybrid = true;
+	hybrid_only.core = core::amd64::core_type::performance;
+	std::u32string wide;
+	core::print<char32_t>(wide, core::toPrint_cpu_topology{hybrid_only});
+	ASSERT_EQ(wide, U"hybrid, core: performance"sv);
+
+	tsink.clear();
+	core::print<char8_t>(tsink, core::toPrint_cpu_topology{core::amd64::cpu_topology{}});
+	ASSERT_TRUE(tsink.empty());
+}
+
+#endif
@@ -28,11 +28,20 @@
 #include <gtest/gtest.h>
 
 #include <CoreLib/core_file.hpp>
+#include <CoreLib/core_file_async.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_file.hpp>
 
 #include <filesystem>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <string_view>
 #include <string>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -334,5 +343,805 @@ namespace text_formating
 		ASSERT_EQ(file_open_or_create_n	.pos(), int64_t{0});
 		ASSERT_EQ(file_open_existing_e	.pos(), int64_t{0});
 	}
-}
 
+	TEST(core_file, mmap)
+	{
+		std::filesystem::path const fileName	= "mmap_test.txt";
+		std::filesystem::path const fileName_n	= "mmap_n_test.txt";
+
+		constexpr std::string_view test_content = "The quick brown fox jumps over the lazy dog";
+
+		AssistFileCleanup auto_cleanup  {fileName};
+		AssistFileCleanup auto_cleanup_n{fileName_n};
+		assist_make_file(fileName, test_content);
+		assist_delete_file(fileName_n);
+
+		{
+			core::file_mmap file;
+			ASSERT_FALSE(file.is_open());
+			ASSERT_FALSE(file.is_mapped());
+			ASSERT_TRUE(file.view().empty());
+			ASSERT_NE(file.map(), std::errc{});
+			ASSERT_NE(file.open(fileName_n, core::file_mmap::access::read_only), std::errc{});
+			ASSERT_NE(file.open(fileName_n, core::file_mmap::access::read_only, core::file_mmap::open_mode::create), std::errc{});
+		}
+
+		//---- read only ----
+		{
+			core::file_mmap file;
+			ASSERT_EQ(file.open(fileName, core::file_mmap::access::read_only), std::errc{});
+			ASSERT_TRUE(file.is_open());
+			ASSERT_EQ(file.file_size(), static_cast<int64_t>(test_content.size()));
+			ASSERT_NE(file.resize(4), std::errc{});
+
+			ASSERT_EQ(file.map(), std::errc{});
+			ASSERT_TRUE(file.is_mapped());
+			ASSERT_EQ(file.advise(core::file_mmap::advice::random), std::errc{});
+			std::span<uint8_t const> view = file.view();
+			ASSERT_EQ((std::string_view{reinterpret_cast<char const*>(view.data()), view.size()}), test_content);
+			ASSERT_TRUE(file.writable_view().empty());
+
+			//unaligned window
+			ASSERT_EQ(file.map(10, 9), std::errc{});
+			ASSERT_EQ(file.offset(), int64_t{10});
+			view = file.view();
+			ASSERT_EQ((std::string_view{reinterpret_cast<char const*>(view.data()), view.size()}), test_content.substr(10, 9));
+			ASSERT_EQ(file.advise(core::file_mmap::advice::will_need, 2, 5), std::errc{});
+			ASSERT_NE(file.advise(core::file_mmap::advice::will_need, 5, 5), std::errc{});
+
+			ASSERT_NE(file.map(static_cast<int64_t>(test_content.size())), std::errc{});
+			ASSERT_FALSE(file.is_mapped());
+			file.close();
+			ASSERT_FALSE(file.is_open());
+		}
+
+		//---- read write ----
+		{
+			core::file_mmap file;
+			ASSERT_EQ(file.open(fileName_n, core::file_mmap::access::read_write, core::file_mmap::open_mode::crete_if_new), std::errc{});
+			ASSERT_EQ(file.file_size(), int64_t{0});
+			ASSERT_EQ(file.resize(static_cast<int64_t>(test_content.size())), std::errc{});
+			ASSERT_EQ(file.map(4), std::errc{});
+
+			std::span<uint8_t> const view = file.writable_view();
+			ASSERT_EQ(view.size(), test_content.size() - 4);
+			memcpy(view.data(), test_content.data() + 4, view.size());
+			ASSERT_EQ(file.flush(), std::errc{});
+			ASSERT_EQ(file.flush(1, 3, false), std::errc{});
+		}
+
+		{
+			core::file_read file;
+			ASSERT_EQ(file.open(fileName_n), std::errc{});
+			std::string aux;
+			aux.resize(test_content.size());
+			ASSERT_EQ(file.read(aux.data(), aux.size()), aux.size());
+			ASSERT_EQ(std::string_view{aux}.substr(0, 4), (std::string_view{"\0\0\0\0", 4}));
+			ASSERT_EQ(std::string_view{aux}.substr(4), test_content.substr(4));
+		}
+	}
+
+	TEST(core_file, stream_buffer_size)
+	{
+		std::filesystem::path const fileName = "buffer_size_test.txt";
+		constexpr std::string_view test_content = "The quick brown fox jumps over the lazy dog";
+
+		AssistFileCleanup auto_cleanup{fileName};
+		assist_delete_file(fileName);
+
+		core::file_write file;
+		ASSERT_NE(file.set_buffer_size(16), std::errc{});
+		ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+		ASSERT_EQ(file.set_buffer_size(1 << 20), std::errc{});
+		ASSERT_EQ(file.write(test_content.data(), test_content.size()), test_content.size());
+		ASSERT_EQ(file.size(), int64_t{0});
+		file.flush();
+		ASSERT_EQ(file.size(), static_cast<int64_t>(test_content.size()));
+		file.close();
+	}
+
+#ifndef _WIN32
+	TEST(core_file, raw)
+	{
+		std::filesystem::path const fileName = "raw_test.txt";
+		constexpr std::string_view test_content = "The quick brown fox jumps over the lazy dog";
+
+		AssistFileCleanup auto_cleanup{fileName};
+		assist_delete_file(fileName);
+
+		//---- buffered writes ----
+		{
+			core::file_write_raw file;
+			ASSERT_FALSE(file.is_open());
+			ASSERT_EQ(file.write(test_content.data(), test_content.size()), uintptr_t{0});
+			ASSERT_EQ(file.open(fileName, core::file_write_raw::open_mode::create), std::errc{});
+			ASSERT_TRUE(file.is_open());
+			ASSERT_EQ(file.set_buffer_size(16), std::errc{});
+
+			//size includes pending data
+			ASSERT_EQ(file.write(test_content.data(), 10), uintptr_t{10});
+			ASSERT_EQ(file.size(), int64_t{10});
+			ASSERT_EQ(file.pos(), int64_t{10});
+			ASSERT_EQ(file.write(test_content.data() + 10, 10), uintptr_t{10});
+			ASSERT_EQ(file.size(), int64_t{20});
+			ASSERT_EQ(file.write(test_content.data() + 20, test_content.size() - 20), test_content.size() - 20);
+			ASSERT_EQ(file.flush(), std::errc{});
+			ASSERT_EQ(file.size(), static_cast<int64_t>(test_content.size()));
+
+			ASSERT_EQ(file.write(test_content.data(), 1), uintptr_t{1});
+			ASSERT_EQ(file.size(), static_cast<int64_t>(test_content.size()) + 1);
+			ASSERT_EQ(file.write_offset("t", 1, 0), uintptr_t{1});
+			ASSERT_EQ(file.size(), static_cast<int64_t>(test_content.size()) + 1);
+
+			//pending data that overwrites the middle of the file does not extend it
+			ASSERT_EQ(file.seek(2), std::errc{});
+			ASSERT_EQ(file.write(test_content.data() + 2, 4), uintptr_t{4});
+			ASSERT_EQ(file.size(), static_cast<int64_t>(test_content.size()) + 1);
+			ASSERT_EQ(file.resize(static_cast<int64_t>(test_content.size())), std::errc{});
+		}
+
+		//---- read ----
+		{
+			core::file_read_raw file;
+			ASSERT_EQ(file.open(fileName), std::errc{});
+			ASSERT_EQ(file.size(), static_cast<int64_t>(test_content.size()));
+
+			std::string aux;
+			aux.resize(test_content.size());
+			ASSERT_EQ(file.read(aux.data(), aux.size()), aux.size());
+			ASSERT_EQ(aux.substr(1), test_content.substr(1));
+			ASSERT_EQ(aux[0], 't');
+			ASSERT_EQ(file.pos(), static_cast<int64_t>(test_content.size()));
+			ASSERT_EQ(file.read(aux.data(), 1), uintptr_t{0});
+
+			ASSERT_EQ(file.read_offset(aux.data(), 5, 4), uintptr_t{5});
+			ASSERT_EQ(aux.substr(0, 5), test_content.substr(4, 5));
+			ASSERT_EQ(file.pos(), static_cast<int64_t>(test_content.size()));
+
+			uintptr_t read_count = 0;
+			std::errc const res = file.read_offset_nowait(aux.data(), 5, 10, read_count);
+			if(res == std::errc{})
+			{
+				ASSERT_LE(read_count, uintptr_t{5});
+				ASSERT_EQ(aux.substr(0, read_count), test_content.substr(10, read_count));
+			}
+			else
+			{
+				ASSERT_TRUE(res == std::errc::resource_unavailable_try_again || res == std::errc::not_supported);
+			}
+		}
+
+		//---- duplex ----
+		{
+			core::file_duplex_raw file;
+			ASSERT_EQ(file.open(fileName, core::file_duplex_raw::open_mode::open_existing), std::errc{});
+			ASSERT_EQ(file.write("T", 1), uintptr_t{1});
+
+			std::string aux;
+			aux.resize(test_content.size());
+			ASSERT_EQ(file.read(aux.data(), 3), uintptr_t{3});
+			ASSERT_EQ(aux.substr(0, 3), test_content.substr(1, 3));
+			ASSERT_EQ(file.read_offset(aux.data(), aux.size(), 0), aux.size());
+			ASSERT_EQ(aux, test_content);
+		}
+	}
+#endif
+
+	TEST(core_file, aligned_buffer)
+	{
+		core::aligned_buffer const buffer = core::make_aligned_buffer(100, 4096);
+		ASSERT_NE(buffer, nullptr);
+		ASSERT_EQ(reinterpret_cast<uintptr_t>(buffer.get()) % 4096, uintptr_t{0});
+		ASSERT_EQ(core::make_aligned_buffer(100, 3), nullptr);
+	}
+
+#ifndef _WIN32
+	TEST(core_file, direct)
+	{
+		std::filesystem::path const fileName = "direct_test.bin";
+
+		AssistFileCleanup auto_cleanup{fileName};
+		assist_delete_file(fileName);
+
+		core::file_direct file;
+		std::errc const open_res = file.open(fileName, core::file_direct::access::read_write, core::file_direct::open_mode::create);
+		if(open_res == std::errc::invalid_argument)
+		{
+			GTEST_SKIP() << "file system does not support direct I/O";
+		}
+		ASSERT_EQ(open_res, std::errc{});
+
+		uintptr_t const block = file.offset_alignment();
+		ASSERT_NE(block, uintptr_t{0});
+		ASSERT_EQ(block & (block - 1), uintptr_t{0});
+
+		uintptr_t const alignment = std::max(block, file.memory_alignment());
+		core::aligned_buffer const buffer = core::make_aligned_buffer(block * 2, alignment);
+		ASSERT_NE(buffer, nullptr);
+		for(uintptr_t i = 0; i < block * 2; ++i)
+		{
+			buffer[i] = static_cast<uint8_t>(i * 7);
+		}
+
+		uintptr_t done = 0;
+		ASSERT_EQ(file.write_offset(buffer.get(), block * 2, 0, done), std::errc{});
+		ASSERT_EQ(done, block * 2);
+		ASSERT_EQ(file.write_offset(buffer.get() + 1, block, 0, done), std::errc::invalid_argument);
+		ASSERT_EQ(file.write_offset(buffer.get(), block - 1, 0, done), std::errc::invalid_argument);
+		ASSERT_EQ(file.write_offset(buffer.get(), block, 1, done), std::errc::invalid_argument);
+
+		//end the file on an unaligned size
+		ASSERT_EQ(file.resize(static_cast<int64_t>(block + 10)), std::errc{});
+
+		core::aligned_buffer const in_buffer = core::make_aligned_buffer(block * 2, alignment);
+		ASSERT_EQ(file.read_offset(in_buffer.get(), block * 2, 0, done), std::errc{});
+		ASSERT_EQ(done, block + 10);
+		ASSERT_EQ(memcmp(in_buffer.get(), buffer.get(), block + 10), 0);
+		ASSERT_EQ(file.read_offset(in_buffer.get(), block, 3, done), std::errc::invalid_argument);
+	}
+#endif
+
+	TEST(core_file, vectored)
+	{
+		std::filesystem::path const fileName = "vectored_test.bin";
+		AssistFileCleanup auto_cleanup{fileName};
+		assist_delete_file(fileName);
+
+		constexpr std::string_view header = "HEAD";
+		constexpr std::string_view payload = "The quick brown fox jumps over the lazy dog";
+		std::string expected;
+
+		//more buffers than a single batch, including empty ones
+		std::vector<std::string> records;
+		for(uint32_t i = 0; i < 150; ++i)
+		{
+			records.push_back(i % 7 == 0 ? std::string{} : std::to_string(i * 31));
+		}
+
+		{
+			core::file_write file;
+			std::span<uint8_t const> const record[] =
+			{
+				{reinterpret_cast<uint8_t const*>(header.data()), header.size()},
+				{reinterpret_cast<uint8_t const*>(payload.data()), payload.size()},
+			};
+			ASSERT_EQ(file.write(record), uintptr_t{0});
+			ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+
+			//buffered data must land before the vectored write, and the position must follow it
+			ASSERT_EQ(file.write("<", 1), uintptr_t{1});
+			ASSERT_EQ(file.write(record), header.size() + payload.size());
+			ASSERT_EQ(file.write(">", 1), uintptr_t{1});
+			expected = "<" + std::string{header} + std::string{payload} + ">";
+
+			std::vector<std::span<uint8_t const>> many;
+			for(std::string const& item : records)
+			{
+				many.emplace_back(reinterpret_cast<uint8_t const*>(item.data()), item.size());
+				expected += item;
+			}
+			ASSERT_EQ(file.write(many), expected.size() - header.size() - payload.size() - 2);
+			ASSERT_EQ(file.pos(), static_cast<int64_t>(expected.size()));
+
+#ifndef _WIN32
+			std::span<uint8_t const> const patch[] =
+			{
+				{reinterpret_cast<uint8_t const*>("["), 1},
+				{reinterpret_cast<uint8_t const*>("head"), 4},
+			};
+			ASSERT_EQ(file.write_offset(patch, 0), uintptr_t{5});
+			expected.replace(0, 5, "[head");
+#endif
+		}
+
+		{
+			core::file_read file;
+			ASSERT_EQ(file.open(fileName), std::errc{});
+			ASSERT_EQ(file.size(), static_cast<int64_t>(expected.size()));
+
+			char first;
+			ASSERT_EQ(file.read(&first, 1), uintptr_t{1});
+			ASSERT_EQ(first, expected[0]);
+
+			std::string in_header(header.size(), '\0');
+			std::string in_payload(payload.size(), '\0');
+			std::span<uint8_t> const slots[] =
+			{
+				{reinterpret_cast<uint8_t*>(in_header.data()), in_header.size()},
+				{reinterpret_cast<uint8_t*>(in_payload.data()), in_payload.size()},
+			};
+			ASSERT_EQ(file.read(slots), header.size() + payload.size());
+			ASSERT_EQ(in_header, expected.substr(1, header.size()));
+			ASSERT_EQ(in_payload, payload);
+			ASSERT_EQ(file.pos(), static_cast<int64_t>(1 + header.size() + payload.size()));
+
+			char last;
+			ASSERT_EQ(file.read(&last, 1), uintptr_t{1});
+			ASSERT_EQ(last, '>');
+
+			//short read at the end of the file
+			std::string tail(expected.size(), '\0');
+			std::span<uint8_t> const tail_slot[] = {{reinterpret_cast<uint8_t*>(tail.data()), tail.size()}};
+			uintptr_t const remaining = expected.size() - header.size() - payload.size() - 2;
+			ASSERT_EQ(file.read(tail_slot), remaining);
+			ASSERT_EQ(tail.substr(0, remaining), expected.substr(expected.size() - remaining));
+
+#ifndef _WIN32
+			std::string a(3, '\0');
+			std::string b(4, '\0');
+			std::span<uint8_t> const split[] =
+			{
+				{reinterpret_cast<uint8_t*>(a.data()), a.size()},
+				{reinterpret_cast<uint8_t*>(b.data()), b.size()},
+			};
+			ASSERT_EQ(file.read_offset(split, 0), uintptr_t{7});
+			ASSERT_EQ(a + b, expected.substr(0, 7));
+#endif
+		}
+
+		{
+			core::file_duplex file;
+			ASSERT_EQ(file.open(fileName, core::file_duplex::open_mode::open_existing), std::errc{});
+			std::span<uint8_t const> const record[] = {{reinterpret_cast<uint8_t const*>("xy"), 2}};
+			ASSERT_EQ(file.write(record), uintptr_t{2});
+
+			std::string in(3, '\0');
+			std::span<uint8_t> const slot[] = {{reinterpret_cast<uint8_t*>(in.data()), in.size()}};
+			ASSERT_EQ(file.read(slot), uintptr_t{3});
+			ASSERT_EQ(in, expected.substr(2, 3));
+
+#ifndef _WIN32
+			ASSERT_EQ(file.write_offset(record, 5), uintptr_t{2});
+			ASSERT_EQ(file.read_offset(slot, 4), uintptr_t{3});
+			ASSERT_EQ(in, expected.substr(4, 1) + "xy");
+#endif
+		}
+	}
+
+	TEST(core_file, write_async)
+	{
+		std::filesystem::path const fileName = "write_async_test.txt";
+		AssistFileCleanup auto_cleanup{fileName};
+		assist_delete_file(fileName);
+
+		constexpr uint32_t thread_count = 4;
+		constexpr uint32_t line_count = 2000;
+
+		{
+			core::file_write file;
+			ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+
+			core::file_write_async writer;
+			ASSERT_FALSE(writer.is_running());
+			//small staging and long interval, forces flushes by size and the writers to wait for room
+			ASSERT_EQ(writer.start(file, 256, 64, 1000), std::errc{});
+			ASSERT_TRUE(writer.is_running());
+
+			std::vector<std::thread> threads;
+			for(uint32_t t = 0; t < thread_count; ++t)
+			{
+				threads.emplace_back([&writer, t]()
+					{
+						for(uint32_t i = 0; i < line_count; ++i)
+						{
+							core::print<char8_t>(core::sink_file_UTF8(writer), t, ' ', i, '\n');
+						}
+					});
+			}
+			for(std::thread& thread : threads)
+			{
+				thread.join();
+			}
+
+			//larger than the staging ring, split but still in order
+			writer.flush();
+			std::string const big(1000, 'x');
+			writer.write(big.data(), big.size());
+			writer.write("\n", 1);
+
+			writer.stop();
+			ASSERT_FALSE(writer.is_running());
+			ASSERT_EQ(writer.dropped(), uint64_t{0});
+		}
+
+		{
+			std::ifstream in{fileName, std::ios::binary};
+			std::string line;
+			std::vector<uint32_t> next(thread_count, 0);
+			uint32_t total = 0;
+			while(std::getline(in, line))
+			{
+				if(line[0] == 'x')
+				{
+					ASSERT_EQ(line, std::string(1000, 'x'));
+					continue;
+				}
+				std::istringstream fields{line};
+				uint32_t t, i;
+				fields >> t >> i;
+				ASSERT_LT(t, thread_count);
+				ASSERT_EQ(i, next[t]) << line;
+				++next[t];
+				++total;
+			}
+			ASSERT_EQ(total, thread_count * line_count);
+		}
+
+		//---- drop policy ----
+		{
+			core::file_write file;
+			ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+			core::file_write_async writer;
+			ASSERT_EQ(writer.start(file, 16, 16, 0, core::file_write_async::overflow::drop), std::errc{});
+
+			std::string const big(17, 'y');
+			writer.write(big.data(), big.size());
+			ASSERT_EQ(writer.dropped(), uint64_t{17});
+
+			writer.write("abc", 3);
+			writer.flush();
+			ASSERT_EQ(file.size(), int64_t{3});
+			writer.stop();
+			ASSERT_EQ(writer.write_errors(), uint64_t{0});
+		}
+
+#ifndef _WIN32
+		//---- write failures ----
+		if(std::filesystem::exists("/dev/full"))
+		{
+			//every write fails with no space left on device
+			core::file_write file;
+			ASSERT_EQ(file.open("/dev/full", core::file_write::open_mode::open_existing), std::errc{});
+			core::file_write_async writer;
+			ASSERT_EQ(writer.start(file, 16, 16, 0, core::file_write_async::overflow::drop), std::errc{});
+
+			writer.write("abcd", 4);
+			writer.flush();
+			ASSERT_GE(writer.write_errors(), uint64_t{1});
+			ASSERT_EQ(writer.dropped(), uint64_t{0});
+
+			//the data is still queued, and takes up room in the ring
+			writer.write("0123456789abcdef", 16);
+			ASSERT_EQ(writer.dropped(), uint64_t{16});
+
+			writer.stop();
+			ASSERT_EQ(writer.dropped(), uint64_t{20});
+		}
+
+		{
+			//a blocking writer must not wait forever for room the file will never make
+			core::file_write file;
+			ASSERT_EQ(file.open("/dev/full", core::file_write::open_mode::open_existing), std::errc{});
+			core::file_write_async writer;
+			ASSERT_EQ(writer.start(file, 16, 16, 1, core::file_write_async::overflow::block), std::errc{});
+
+			ASSERT_EQ(writer.write("0123456789abcdef", 16), std::errc{});
+			ASSERT_EQ(writer.write("ghij", 4), std::errc::io_error);
+			ASSERT_GE(writer.write_errors(), uint64_t{1});
+			ASSERT_EQ(writer.dropped(), uint64_t{4});
+
+			writer.stop();
+			ASSERT_EQ(writer.dropped(), uint64_t{20});
+			ASSERT_EQ(writer.write("abcd", 4), std::errc::bad_file_descriptor);
+		}
+#endif
+	}
+
+	TEST(core_file, toPrint_sinks)
+	{
+		using namespace std::string_view_literals;
+
+		//only the asynchronous writer has a buffer the text can be formatted into
+		static_assert(!core::_p::toPrint_has_own_buffer<char8_t , core::sink_file_UTF8<core::file_write>>::value);
+		static_assert(!core::_p::toPrint_has_own_buffer<char16_t, core::sink_file_UTF16BE_unlocked<core::file_duplex>>::value);
+		static_assert(core::_p::toPrint_has_own_buffer<char8_t  , core::sink_file_UTF8<core::file_write_async>>::value);
+		static_assert(core::_p::toPrint_has_own_buffer<char32_t, core::sink_file_UCS4LE<core::file_write_async>>::value);
+		static_assert(!core::_p::toPrint_has_own_buffer<char8_t, core::sink_file_UCS4LE<core::file_write_async>>::value);
+
+		std::filesystem::path const fileName = "toPrint_sink_test.bin";
+		AssistFileCleanup auto_cleanup{fileName};
+
+		//larger than the staging ring of the asynchronous writer below
+		std::u8string const big(0x3000, u8'z');
+
+		auto const read_all = [&]()
+			{
+				std::ifstream in{fileName, std::ios::binary};
+				return std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+			};
+
+		auto const widen = [](std::string_view p_text, uintptr_t p_width, bool p_big_endian)
+			{
+				std::string out;
+				for(char const c : p_text)
+				{
+					std::string unit(p_width, '\0');
+					unit[p_big_endian ? p_width - 1 : 0] = c;
+					out += unit;
+				}
+				return out;
+			};
+
+		std::string const expected_text = "x=42 \n" + std::string(0x3000, 'z') + "x=42 \n";
+
+		{
+			core::file_write file;
+			ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+			core::print<char8_t>(core::sink_file_UTF8(file), u8"x="sv, 42, ' ', '\n');
+			core::print<char8_t>(core::sink_file_UTF8_unlocked(file), big);
+			//transcoding path
+			core::print<char16_t>(core::sink_file_UTF8(file), u"x="sv, 42, ' ', '\n');
+		}
+		ASSERT_EQ(read_all(), expected_text);
+
+		{
+			core::file_write file;
+			ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+			core::print<char16_t>(core::sink_file_UTF16BE(file), u"x="sv, 42, ' ', '\n');
+			core::print<char8_t>(core::sink_file_UTF16BE_unlocked(file), big);
+			core::print<char8_t>(core::sink_file_UTF16BE(file), u8"x="sv, 42, ' ', '\n');
+		}
+		ASSERT_EQ(read_all(), widen(expected_text, 2, true));
+
+		{
+			core::file_write file;
+			ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+			core::print<char16_t>(core::sink_file_UTF16LE_unlocked(file), u"x="sv, 42, ' ', '\n');
+			core::print<char16_t>(core::sink_file_UTF16LE(file), std::u16string(0x3000, u'z'));
+			core::print<char32_t>(core::sink_file_UTF16LE(file), U"x="sv, 42, ' ', '\n');
+		}
+		ASSERT_EQ(read_all(), widen(expected_text, 2, false));
+
+		{
+			core::file_write file;
+			ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+			core::print<char32_t>(core::sink_file_UCS4BE(file), U"x="sv, 42, ' ', '\n');
+			core::print<char32_t>(core::sink_file_UCS4BE_unlocked(file), std::u32string(0x3000, U'z'));
+			core::print<char16_t>(core::sink_file_UCS4BE(file), u"x="sv, 42, ' ', '\n');
+		}
+		ASSERT_EQ(read_all(), widen(expected_text, 4, true));
+
+		{
+			core::file_write file;
+			ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+			core::print<char32_t>(core::sink_file_UCS4LE_unlocked(file), U"x="sv, 42, ' ', '\n');
+			core::print<char8_t>(core::sink_file_UCS4LE(file), big);
+			core::print<char32_t>(core::sink_file_UCS4LE(file), U"x="sv, 42, ' ', '\n');
+		}
+		ASSERT_EQ(read_all(), widen(expected_text, 4, false));
+
+		//formatting in place into the staging ring of an asynchronous writer
+		{
+			core::file_write file;
+			ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+			core::file_write_async writer;
+			ASSERT_EQ(writer.start(file, 0x1000, 0x1000, 0), std::errc{});
+			ASSERT_NE(writer.reserve(16), nullptr);
+			ASSERT_EQ(writer.reserve(0x1001), nullptr);
+
+			core::print<char16_t>(core::sink_file_UTF16LE(writer), u"x="sv, 42, ' ', '\n');
+			core::print<char16_t>(core::sink_file_UTF16LE(writer), std::u16string(0x3000, u'z'));
+			core::print<char16_t>(core::sink_file_UTF16LE(writer), u"x="sv, 42, ' ', '\n');
+			writer.stop();
+		}
+		ASSERT_EQ(read_all(), widen(expected_text, 2, false));
+
+		//an odd amount of UTF-8 leaves the ring misaligned for the wider sinks, which must then go through write
+		{
+			core::file_write file;
+			ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+			core::file_write_async writer;
+			ASSERT_EQ(writer.start(file, 0x1000, 0x1000, 0), std::errc{});
+			ASSERT_NE(writer.reserve(16, alignof(char32_t)), nullptr);
+
+			core::print<char8_t>(core::sink_file_UTF8(writer), u8"abc"sv);
+			ASSERT_EQ(writer.reserve(2, alignof(char16_t)), nullptr);
+			ASSERT_NE(writer.reserve(2, alignof(char8_t)), nullptr);
+
+			core::print<char16_t>(core::sink_file_UTF16LE(writer), u"x="sv, 42, ' ', '\n');
+			core::print<char32_t>(core::sink_file_UCS4BE(writer), U"x="sv, 42, ' ', '\n');
+			core::print<char8_t>(core::sink_file_UTF8(writer), u8"d"sv);
+			core::print<char16_t>(core::sink_file_UTF16BE(writer), u"x="sv, 42, ' ', '\n');
+			writer.stop();
+		}
+		ASSERT_EQ(read_all(), "abc" + widen("x=42 \n", 2, false) + widen("x=42 \n", 4, true) + "d" + widen("x=42 \n", 2, true));
+	}
+
+	TEST(core_file, toPrint_sinks_shared)
+	{
+		using namespace std::string_view_literals;
+
+		std::filesystem::path const fileName = "toPrint_sink_shared_test.bin";
+		AssistFileCleanup auto_cleanup{fileName};
+
+		constexpr uintptr_t thread_count = 4;
+		constexpr uintptr_t line_count = 2000;
+
+		core::file_write file;
+		ASSERT_EQ(file.open(fileName, core::file_write::open_mode::create), std::errc{});
+		core::file_write_async writer;
+		ASSERT_EQ(writer.start(file, 0x400, 0x4000, 0), std::errc{});
+
+		//a single sink used from several threads at once
+		core::sink_file_UTF8<core::file_write_async> sink{writer};
+		{
+			std::vector<std::thread> threads;
+			for(uintptr_t t = 0; t < thread_count; ++t)
+			{
+				threads.emplace_back(
+					[&sink, t]()
+					{
+						for(uintptr_t i = 0; i < line_count; ++i)
+						{
+							core::print<char8_t>(sink, u8"line "sv, t, ' ', i, '\n');
+						}
+					});
+			}
+			for(std::thread& thread : threads)
+			{
+				thread.join();
+			}
+		}
+		writer.stop();
+		ASSERT_EQ(writer.dropped(), uint64_t{0});
+
+		std::ifstream in{fileName, std::ios::binary};
+		std::vector<uintptr_t> next(thread_count, 0);
+		std::string line;
+		while(std::getline(in, line))
+		{
+			uintptr_t t = 0;
+			uintptr_t i = 0;
+			ASSERT_EQ(std::sscanf(line.c_str(), "line %zu %zu", &t, &i), 2) << line;
+			ASSERT_LT(t, thread_count);
+			//each thread's lines arrive whole and in order
+			ASSERT_EQ(i, next[t]);
+			++next[t];
+		}
+		for(uintptr_t const count : next)
+		{
+			ASSERT_EQ(count, line_count);
+		}
+	}
+
+#ifdef __linux__
+	TEST(core_file, async)
+	{
+		std::filesystem::path const fileName = "async_test.bin";
+		constexpr uint32_t block_size = 64;
+		constexpr uint32_t block_count = 96;
+
+		AssistFileCleanup auto_cleanup{fileName};
+		assist_delete_file(fileName);
+
+		core::file_async engine;
+		ASSERT_FALSE(engine.is_open());
+		ASSERT_EQ(engine.queue_read(core::file_async::descriptor(0), nullptr, 0, 0, 0), std::errc::bad_file_descriptor);
+		{
+			std::errc const res = engine.open(64);
+			if(res == std::errc::not_supported)
+			{
+				GTEST_SKIP() << "io_uring not supported";
+			}
+			ASSERT_EQ(res, std::errc{});
+		}
+		ASSERT_TRUE(engine.is_open());
+
+		std::vector<uint8_t> out_data(block_size * block_count);
+		for(uintptr_t i = 0; i < out_data.size(); ++i)
+		{
+			out_data[i] = static_cast<uint8_t>(i * 7 + i / 251);
+		}
+
+		std::vector<core::file_async::completion> completions(block_count + 1);
+		auto const collect = [&](uint32_t p_expected, std::vector<uint64_t>& p_seen)
+			{
+				uint32_t collected = 0;
+				while(collected < p_expected)
+				{
+					ASSERT_EQ(engine.wait(1), std::errc{});
+					uint32_t const count = engine.reap(completions);
+					for(uint32_t i = 0; i < count; ++i)
+					{
+						p_seen.push_back(completions[i].user_data);
+						ASSERT_GE(completions[i].result, 0) << completions[i].user_data;
+					}
+					collected += count;
+				}
+			};
+
+		//---- writes through a duplex handle, last one linked with an fsync ----
+		{
+			core::file_duplex file;
+			ASSERT_EQ(file.open(fileName, core::file_duplex::open_mode::create), std::errc{});
+			core::file_async::target const target = core::file_async::descriptor(file);
+			ASSERT_NE(target.value, -1);
+
+			//more blocks than the queue depth, forces the engine to flush on its own
+			for(uint32_t i = 0; i < block_count - 1; ++i)
+			{
+				ASSERT_EQ(engine.queue_write(target, out_data.data() + i * block_size, block_size, i * block_size, i), std::errc{});
+			}
+			ASSERT_EQ(engine.wait(0), std::errc{});
+
+			std::vector<uint64_t> seen;
+			collect(block_count - 1, seen);
+			ASSERT_EQ(engine.queue_write_fsync(target, out_data.data() + (block_count - 1) * block_size, block_size, (block_count - 1) * block_size, block_count - 1, block_count, true), std::errc{});
+			collect(2, seen);
+
+			std::sort(seen.begin(), seen.end());
+			ASSERT_EQ(seen.size(), uintptr_t{block_count + 1});
+			for(uint32_t i = 0; i <= block_count; ++i)
+			{
+				ASSERT_EQ(seen[i], uint64_t{i});
+			}
+			ASSERT_EQ(file.size(), static_cast<int64_t>(out_data.size()));
+		}
+
+		//---- reads through a read handle, registered file and buffer ----
+		{
+			core::file_read file;
+			ASSERT_EQ(file.open(fileName), std::errc{});
+			int const fd = core::file_async::descriptor(file).value;
+			ASSERT_NE(fd, -1);
+
+			std::vector<uint8_t> in_data(out_data.size());
+			std::span<uint8_t> const buffers[] = {in_data};
+			ASSERT_EQ(engine.register_files(std::span<int const>{&fd, 1}), std::errc{});
+			ASSERT_EQ(engine.register_buffers(buffers), std::errc{});
+
+			//reverse order to exercise random access
+			uint32_t completed = 0;
+			for(uint32_t i = 0; i < block_count; ++i)
+			{
+				uint32_t const block = block_count - 1 - i;
+				std::errc res = engine.queue_read_fixed(core::file_async::registered(0), 0, in_data.data() + block * block_size, block_size, block * block_size, block);
+				if(res == std::errc::resource_unavailable_try_again)
+				{
+					ASSERT_EQ(engine.wait(1), std::errc{});
+					uint32_t const count = engine.reap(completions);
+					for(uint32_t j = 0; j < count; ++j)
+					{
+						ASSERT_EQ(completions[j].result, static_cast<int32_t>(block_size));
+					}
+					completed += count;
+					res = engine.queue_read_fixed(core::file_async::registered(0), 0, in_data.data() + block * block_size, block_size, block * block_size, block);
+				}
+				ASSERT_EQ(res, std::errc{});
+			}
+
+			ASSERT_EQ(engine.submit(), std::errc{});
+			ASSERT_EQ(engine.queued(), uint32_t{0});
+			while(completed < block_count)
+			{
+				ASSERT_EQ(engine.wait(1), std::errc{});
+				uint32_t const count = engine.reap(completions);
+				for(uint32_t i = 0; i < count; ++i)
+				{
+					ASSERT_EQ(completions[i].result, static_cast<int32_t>(block_size));
+				}
+				completed += count;
+			}
+			ASSERT_EQ(completed, block_count);
+
+			ASSERT_TRUE(in_data == out_data);
+
+			ASSERT_EQ(engine.unregister_buffers(), std::errc{});
+			ASSERT_EQ(engine.unregister_files(), std::errc{});
+		}
+
+		//---- errors are reported per operation ----
+		{
+			uint8_t buff[4];
+			ASSERT_EQ(engine.queue_read(core::file_async::descriptor(-1), buff, sizeof(buff), 0, 7), std::errc{});
+			ASSERT_EQ(engine.wait(1), std::errc{});
+			ASSERT_EQ(engine.reap(completions), uint32_t{1});
+			ASSERT_EQ(completions[0].user_data, uint64_t{7});
+			ASSERT_EQ(completions[0].result, -EBADF);
+		}
+
+		engine.close();
+		ASSERT_FALSE(engine.is_open());
+	}
+#endif
+}
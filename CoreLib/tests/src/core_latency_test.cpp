@@ -0,0 +1,245 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <CoreLib/core_latency.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_latency.hpp>
+#include <CoreLib/toPrint/toPrint_string_sink.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::literals::string_view_literals;
+
+TEST(core_latency, bucket_layout)
+{
+	using histogram = core::latency_histogram;
+
+	for(uint64_t value = 0; value < 128; ++value)
+	{
+		ASSERT_EQ(histogram::bucket_index(value), value);
+	}
+
+	uintptr_t last_index = 0;
+	for(uintptr_t index = 0; index < histogram::bucket_count; ++index)
+	{
+		uint64_t const lowest = histogram::bucket_lowest(index);
+		uint64_t const highest = histogram::bucket_highest(index);
+		ASSERT_LE(lowest, highest);
+		ASSERT_EQ(histogram::bucket_index(lowest), index);
+		ASSERT_EQ(histogram::bucket_index(highest), index);
+		if(index > 0)
+		{
+			ASSERT_EQ(histogram::bucket_highest(index - 1) + 1, lowest);
+		}
+		//relative error below 1/64
+		ASSERT_LE((highest - lowest) / 64, lowest / 4096 + 1);
+		last_index = index;
+	}
+	ASSERT_EQ(histogram::bucket_index(~uint64_t{0}), last_index);
+}
+
+TEST(core_latency, histogram)
+{
+	core::latency_histogram histogram;
+	ASSERT_EQ(histogram.count(), 0);
+	ASSERT_EQ(histogram.percentile(50.0), 0);
+
+	for(uint64_t value = 1; value <= 1000; ++value)
+	{
+		histogram.record(value);
+	}
+
+	ASSERT_EQ(histogram.count(), 1000);
+	ASSERT_EQ(histogram.min(), 1);
+	ASSERT_EQ(histogram.max(), 1000);
+	ASSERT_EQ(histogram.mean(), 500);
+	ASSERT_EQ(histogram.percentile(0.0), 1);
+	ASSERT_EQ(histogram.percentile(100.0), 1000);
+	ASSERT_EQ(histogram.percentile(10.0), 100);
+
+	uint64_t const p50 = histogram.percentile(50.0);
+	uint64_t const p99 = histogram.percentile(99.0);
+	ASSERT_GE(p50, 500);
+	ASSERT_LE(p50, 500 + 500 / 64);
+	ASSERT_GE(p99, 990);
+	ASSERT_LE(p99, 1000);
+
+	core::latency_histogram other;
+	other.record(5000);
+	histogram.merge(other);
+	ASSERT_EQ(histogram.count(), 1001);
+	ASSERT_EQ(histogram.max(), 5000);
+	ASSERT_EQ(histogram.percentile(100.0), 5000);
+
+	histogram.reset();
+	ASSERT_EQ(histogram.count(), 0);
+	ASSERT_EQ(histogram.max(), 0);
+}
+
+TEST(core_latency, recorder)
+{
+	constexpr uint64_t samples = 10000;
+	core::latency_recorder recorder;
+
+	std::vector<std::thread> threads;
+	for(uint64_t t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([&recorder, t]()
+			{
+				for(uint64_t i = 0; i < samples; ++i)
+				{
+					recorder.record(t * 1000 + i % 100);
+				}
+			});
+	}
+	//snapshots can be taken while threads record
+	[[maybe_unused]] core::latency_histogram const partial = recorder.snapshot();
+	for(std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	core::latency_histogram const snapshot = recorder.snapshot();
+	ASSERT_EQ(snapshot.count(), 4 * samples);
+	ASSERT_EQ(snapshot.min(), 0);
+	ASSERT_EQ(snapshot.max(), 3099);
+	ASSERT_LE(snapshot.percentile(25.0), 99);
+	ASSERT_GE(snapshot.percentile(26.0), 1000);
+
+	//shards of exited threads are reused
+	std::thread{[&recorder](){ recorder.record(7); }}.join();
+	ASSERT_EQ(recorder.snapshot().count(), 4 * samples + 1);
+
+	recorder.reset();
+	ASSERT_EQ(recorder.snapshot().count(), 0);
+}
+
+TEST(core_latency, recorder_many)
+{
+	//a thread recording into more recorders than it used to keep bound, ex. one per pipeline stage
+	constexpr uint64_t stage_count = 8;
+	constexpr uint64_t samples = 5000;
+
+	{
+		std::vector<std::unique_ptr<core::latency_recorder>> stages;
+		for(uint64_t s = 0; s < stage_count; ++s)
+		{
+			stages.push_back(std::make_unique<core::latency_recorder>());
+		}
+
+		std::vector<std::thread> threads;
+		for(uint64_t t = 0; t < 2; ++t)
+		{
+			threads.emplace_back([&stages]()
+				{
+					for(uint64_t i = 0; i < samples; ++i)
+					{
+						for(uint64_t s = 0; s < stage_count; ++s)
+						{
+							stages[s]->record(s * 100 + i % 10);
+						}
+					}
+				});
+		}
+		for(std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		for(uint64_t s = 0; s < stage_count; ++s)
+		{
+			core::latency_histogram const snapshot = stages[s]->snapshot();
+			ASSERT_EQ(snapshot.count(), 2 * samples);
+			ASSERT_EQ(snapshot.min(), s * 100);
+			ASSERT_EQ(snapshot.max(), s * 100 + 9);
+		}
+
+		//this thread is still bound to the recorders when they are destroyed
+		for(std::unique_ptr<core::latency_recorder>& stage : stages)
+		{
+			stage->record(1);
+		}
+	}
+
+	//and binds to new ones without issue
+	for(uint64_t round = 0; round < 3; ++round)
+	{
+		std::vector<std::unique_ptr<core::latency_recorder>> stages;
+		for(uint64_t s = 0; s < stage_count; ++s)
+		{
+			stages.push_back(std::make_unique<core::latency_recorder>());
+			stages.back()->record(s);
+			stages.back()->record(s);
+		}
+		for(uint64_t s = 0; s < stage_count; ++s)
+		{
+			ASSERT_EQ(stages[s]->snapshot().count(), 2);
+		}
+	}
+}
+
+TEST(core_latency, scoped_latency)
+{
+	core::latency_recorder recorder;
+	core::latency_histogram histogram;
+	{
+		core::scoped_latency const timer{recorder};
+		core::scoped_latency local{histogram};
+		std::this_thread::sleep_for(std::chrono::milliseconds{2});
+		local.lap();
+	}
+	ASSERT_EQ(histogram.count(), 2);
+	ASSERT_GE(histogram.max(), 2'000'000);
+
+	core::latency_histogram const snapshot = recorder.snapshot();
+	ASSERT_EQ(snapshot.count(), 1);
+	ASSERT_GE(snapshot.min(), 2'000'000);
+}
+
+TEST(core_latency, toPrint_latency)
+{
+	core::latency_histogram histogram;
+	for(uint64_t value = 1; value <= 100; ++value)
+	{
+		histogram.record(value);
+	}
+
+	std::u8string tsink;
+	core::print<char8_t>(tsink, core::toPrint_latency{histogram});
+	ASSERT_EQ(tsink, u8"n=100 min=1ns p50=50ns p90=90ns p99=99ns p99.9=100ns max=100ns mean=50ns"sv);
+
+	std::u16string wide;
+	core::print<char16_t>(wide, core::toPrint_latency{core::latency_histogram{}});
+	ASSERT_EQ(wide, u"n=0 min=0ns p50=0ns p90=0ns p99=0ns p99.9=0ns max=0ns mean=0ns"sv);
+}
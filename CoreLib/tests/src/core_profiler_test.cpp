@@ -0,0 +1,219 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <CoreLib/core_extra_compiler.hpp>
+#include <CoreLib/core_profiler.hpp>
+#include <CoreLib/core_time.hpp>
+#include <CoreLib/core_type.hpp>
+
+#include <gtest/gtest.h>
+
+using core::literals::operator ""_ui64;
+
+#ifndef _WIN32
+
+namespace profiler_test
+{
+	static std::atomic<uint64_t> g_sink = 0;
+
+	NO_INLINE void burn_cpu(uint64_t const p_milliseconds)
+	{
+		core::chrono timer;
+		timer.set();
+		uint64_t value = 1;
+		while(timer.elapsed() < p_milliseconds * 1000000)
+		{
+			for(uint32_t i = 0; i < 10000; ++i)
+			{
+				value = value * 6364136223846793005 + 1442695040888963407;
+			}
+		}
+		g_sink.fetch_add(value, std::memory_order::relaxed);
+	}
+
+	static uint64_t sum_counts(std::u8string_view p_folded)
+	{
+		uint64_t total = 0;
+		while(!p_folded.empty())
+		{
+			uintptr_t const end = p_folded.find(u8'\n');
+			std::u8string_view const line = p_folded.substr(0, end);
+			uintptr_t const space = line.rfind(u8' ');
+			EXPECT_NE(space, std::u8string_view::npos);
+			total += std::stoull(std::string{line.begin() + space + 1, line.end()});
+			p_folded.remove_prefix(end == std::u8string_view::npos ? p_folded.size() : end + 1);
+		}
+		return total;
+	}
+
+	///	\return Number of POSIX timers of the process, -1 if the kernel does not list them
+	static int64_t timer_count()
+	{
+		std::ifstream in{"/proc/self/timers"};
+		if(!in) return -1;
+		int64_t count = 0;
+		std::string line;
+		while(std::getline(in, line))
+		{
+			if(line.starts_with("ID:")) ++count;
+		}
+		return count;
+	}
+
+	static std::string_view as_text(std::u8string const& p_text)
+	{
+		return std::string_view{reinterpret_cast<char const*>(p_text.data()), p_text.size()};
+	}
+
+TEST(core_profiler, lifetime)
+{
+	core::sampling_profiler profiler;
+	ASSERT_EQ(profiler.attach_thread(), std::errc::operation_not_permitted);
+	ASSERT_EQ(profiler.start(0), std::errc::invalid_argument);
+	ASSERT_EQ(profiler.start(1000, 16), std::errc{});
+
+	core::sampling_profiler other;
+	ASSERT_EQ(other.start(1000), std::errc::device_or_resource_busy);
+
+	ASSERT_EQ(profiler.attach_thread(), std::errc{});
+	ASSERT_EQ(profiler.attach_thread(), std::errc{});
+	profiler.detach_thread();
+	profiler.stop();
+
+	ASSERT_EQ(other.start(1000), std::errc{});
+	other.stop();
+	ASSERT_TRUE(other.folded().empty());
+}
+
+TEST(core_profiler, samples_thread)
+{
+	core::sampling_profiler profiler;
+	ASSERT_EQ(profiler.start(1000), std::errc{});
+	ASSERT_EQ(profiler.attach_thread(), std::errc{});
+	burn_cpu(200);
+	profiler.detach_thread();
+	profiler.stop();
+
+	std::u8string const names = profiler.folded(true);
+	ASSERT_GT(profiler.sample_count(), 10_ui64) << as_text(names);
+	ASSERT_EQ(sum_counts(names), profiler.sample_count());
+	ASSERT_NE(names.find(u8"profiler_test::burn_cpu(unsigned long)"), std::u8string::npos) << as_text(names);
+
+	std::u8string const addresses = profiler.folded(false);
+	ASSERT_EQ(sum_counts(addresses), profiler.sample_count());
+	ASSERT_NE(addresses.find(u8"+0x"), std::u8string::npos) << as_text(addresses);
+
+	profiler.reset();
+	ASSERT_EQ(profiler.sample_count(), 0_ui64);
+	ASSERT_TRUE(profiler.folded().empty());
+}
+
+TEST(core_profiler, samples_threads)
+{
+	core::sampling_profiler profiler;
+	ASSERT_EQ(profiler.start(1000, 64), std::errc{});
+
+	std::atomic<bool> done = false;
+	std::vector<std::thread> threads;
+	for(uint32_t i = 0; i < 3; ++i)
+	{
+		threads.emplace_back([&profiler]
+			{
+				ASSERT_EQ(profiler.attach_thread(), std::errc{});
+				burn_cpu(100);
+			});
+	}
+
+	//keep collecting while the threads run, the ring is deliberately small
+	std::thread collector([&profiler, &done]
+		{
+			while(!done.load())
+			{
+				profiler.collect();
+				std::this_thread::sleep_for(std::chrono::milliseconds{1});
+			}
+		});
+
+	for(std::thread& thread: threads) thread.join();
+	done = true;
+	collector.join();
+	profiler.stop();
+	profiler.collect();
+
+	ASSERT_GT(profiler.sample_count() + profiler.dropped(), 10_ui64);
+	ASSERT_EQ(sum_counts(profiler.folded(true)), profiler.sample_count());
+}
+
+TEST(core_profiler, exited_threads)
+{
+	int64_t const initial = timer_count();
+
+	core::sampling_profiler profiler;
+	ASSERT_EQ(profiler.start(1000), std::errc{});
+
+	//threads that exit without detaching
+	for(uint32_t i = 0; i < 8; ++i)
+	{
+		std::thread{[&profiler]
+			{
+				ASSERT_EQ(profiler.attach_thread(), std::errc{});
+				burn_cpu(5);
+			}}.join();
+	}
+
+	//their timers are cleaned up by the next attach
+	ASSERT_EQ(profiler.attach_thread(), std::errc{});
+	if(initial >= 0)
+	{
+		ASSERT_EQ(timer_count(), initial + 1);
+	}
+	burn_cpu(100);
+	profiler.detach_thread();
+	profiler.stop();
+	profiler.collect();
+	ASSERT_GT(profiler.sample_count() + profiler.dropped(), 0_ui64);
+
+	if(initial >= 0)
+	{
+		ASSERT_EQ(timer_count(), initial);
+	}
+
+	//attaching is refused once stopped
+	ASSERT_EQ(profiler.attach_thread(), std::errc::operation_not_permitted);
+}
+
+} //namespace profiler_test
+
+#endif
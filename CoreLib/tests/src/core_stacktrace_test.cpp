@@ -0,0 +1,157 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#ifndef _WIN32
+
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <CoreLib/core_extra_compiler.hpp>
+#include <CoreLib/core_file.hpp>
+#include <CoreLib/core_stacktrace.hpp>
+
+#include <gtest/gtest.h>
+
+namespace stacktrace_test
+{
+	NO_INLINE void crash_trace_target(int volatile* const p_ptr)
+	{
+		*p_ptr = 42;
+	}
+
+	static std::u8string read_file(std::filesystem::path const& p_path)
+	{
+		std::u8string out;
+		core::file_read file;
+		if(file.open(p_path) != std::errc{}) return out;
+		//files in /proc report a size of 0, read until the end instead
+		std::array<char8_t, 4096> buff;
+		for(uintptr_t res = file.read_unlocked(buff.data(), buff.size()); res; res = file.read_unlocked(buff.data(), buff.size()))
+		{
+			out.append(buff.data(), res);
+		}
+		return out;
+	}
+
+	static bool contains(std::u8string_view const p_text, std::u8string_view const p_what)
+	{
+		return p_text.find(p_what) != std::u8string_view::npos;
+	}
+
+	///	\brief Crashes two threads, the second while the first is still writing its trace to the fifo at p_path
+	[[noreturn]] static void crash_two_threads(std::filesystem::path const& p_path)
+	{
+		if(!core::register_crash_trace_raw(p_path)) _exit(1);
+		std::thread first{[]{ crash_trace_target(nullptr); }};
+		std::this_thread::sleep_for(std::chrono::milliseconds{100});
+		std::thread second{[]{ crash_trace_target(nullptr); }};
+		std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+		int const fd = open(p_path.c_str(), O_RDONLY);
+		if(fd < 0) _exit(2);
+		std::array<char, 4096> buff;
+		while(read(fd, buff.data(), buff.size()) > 0) {}
+		std::this_thread::sleep_for(std::chrono::seconds{5});
+		_exit(3);
+	}
+
+TEST(core_stacktrace, raw_crash_trace)
+{
+	std::filesystem::path const path = std::filesystem::temp_directory_path() / ("corelib_raw_trace_" + std::to_string(getpid()) + ".txt");
+	std::filesystem::remove(path);
+
+	EXPECT_EXIT(
+		{
+			if(!core::register_crash_trace_raw(path)) _exit(1);
+			crash_trace_target(nullptr);
+		}, testing::KilledBySignal(SIGABRT), "");
+
+	std::u8string const raw = read_file(path);
+	std::filesystem::remove(path);
+	ASSERT_TRUE(raw.starts_with(u8"CoreLib raw crash trace 1\nsig 11\n"));
+	ASSERT_TRUE(contains(raw, u8"\nframes\n"));
+	ASSERT_TRUE(contains(raw, u8"\nmaps\n"));
+
+	std::u8string symbolized;
+	ASSERT_EQ(core::symbolize_crash_trace(raw, symbolized), std::errc{});
+	ASSERT_TRUE(contains(symbolized, u8"Sig:     0x0000000B\n")) << std::string_view{reinterpret_cast<char const*>(symbolized.data()), symbolized.size()};
+	ASSERT_TRUE(contains(symbolized, u8"Stack:\n"));
+	ASSERT_TRUE(contains(symbolized, u8"stacktrace_test::crash_trace_target(int volatile*)+0x"))
+		<< std::string_view{reinterpret_cast<char const*>(symbolized.data()), symbolized.size()};
+}
+
+TEST(core_stacktrace, raw_crash_trace_threads)
+{
+	//the trace goes to a fifo, so that the first crashing thread is held in open until we start reading
+	std::filesystem::path const path = std::filesystem::temp_directory_path() / ("corelib_raw_trace_fifo_" + std::to_string(getpid()));
+	std::filesystem::remove(path);
+	ASSERT_EQ(mkfifo(path.c_str(), 0600), 0);
+
+	//a second thread crashing while the trace is being written must not end the process
+	EXPECT_EXIT(crash_two_threads(path), testing::KilledBySignal(SIGABRT), "");
+
+	std::filesystem::remove(path);
+}
+
+TEST(core_stacktrace, symbolize_crash_trace)
+{
+	std::u8string output;
+	ASSERT_EQ(core::symbolize_crash_trace(u8"not a trace", output), std::errc::invalid_argument);
+	ASSERT_EQ(core::symbolize_crash_trace(u8"", output), std::errc::invalid_argument);
+
+	//a frame inside a known function, resolved against the live module map
+	std::u8string trace = u8"CoreLib raw crash trace 1\nsig 6\ncode 0\naddr 0x0\npid 1\ntid 1\ntime 0.0\nframes\n";
+	{
+		uintptr_t const addr = reinterpret_cast<uintptr_t>(&crash_trace_target);
+		std::string const frame = "0x" + (std::stringstream{} << std::hex << addr).str() + "\n";
+		trace.append(frame.begin(), frame.end());
+	}
+	trace.append(u8"0x10\nmaps\n");
+	trace.append(read_file("/proc/self/maps"));
+
+	ASSERT_EQ(core::symbolize_crash_trace(trace, output), std::errc{});
+	ASSERT_TRUE(contains(output, u8"Time:    1970-01-01T00:00:00.000Z\n"));
+	ASSERT_TRUE(contains(output, u8"Proc:    1\n"));
+	ASSERT_TRUE(contains(output, u8" stacktrace_test::crash_trace_target(int volatile*)+0x0\n"))
+		<< std::string_view{reinterpret_cast<char const*>(output.data()), output.size()};
+	ASSERT_TRUE(contains(output, u8"\n0x0000000000000010\n")) << "unmapped address must be kept as is";
+}
+
+} //namespace stacktrace_test
+
+#endif
@@ -0,0 +1,344 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <time.h>
+
+#include <CoreLib/core_time.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(core_time, time_delta_nanoseconds)
+{
+	ASSERT_EQ(core::time_delta_t::from_nanoseconds(1'234'567'800).raw(), 12'345'678);
+	ASSERT_EQ(core::time_delta_t::from_nanoseconds(-1'234'567'899).raw(), -12'345'678);
+	ASSERT_EQ(core::time_delta_t::from_nanoseconds(99).raw(), 0);
+	ASSERT_EQ(core::time_delta_t{12'345'678}.nanoseconds(), 1'234'567'800);
+	ASSERT_EQ(core::time_delta_t::from_nanoseconds(core::time_delta_t{-42}.nanoseconds()).raw(), -42);
+}
+
+TEST(core_time, chrono_elapsed)
+{
+	core::chrono timer;
+	timer.set();
+	uint64_t const first = timer.elapsed();
+	std::this_thread::sleep_for(std::chrono::milliseconds{20});
+	uint64_t const second = timer.elapsed();
+
+	ASSERT_LE(first, second);
+	ASSERT_GE(second, 20'000'000);
+	ASSERT_LT(second, 2'000'000'000);
+
+	core::track_chrono track;
+	track.restart();
+	std::this_thread::sleep_for(std::chrono::milliseconds{10});
+	track.pause();
+	uint64_t const paused = track.read();
+	ASSERT_GE(paused, 10'000'000);
+	std::this_thread::sleep_for(std::chrono::milliseconds{10});
+	ASSERT_EQ(track.read(), paused);
+	track.resume();
+	ASSERT_GE(track.read(), paused);
+}
+
+TEST(core_time, clock_stamp)
+{
+	uint64_t const first = core::clock_stamp();
+	std::this_thread::sleep_for(std::chrono::milliseconds{10});
+	uint64_t const second = core::clock_stamp();
+	ASSERT_GE(second - first, 10'000'000);
+	ASSERT_LT(second - first, 2'000'000'000);
+}
+
+TEST(core_time, system_time_to_date)
+{
+	//every day from 1601 to 2800, against the standard library
+	constexpr int64_t day_100ns = int64_t{86400} * 10'000'000;
+	std::chrono::sys_days const reference = std::chrono::year{1601} / std::chrono::January / 1;
+	std::chrono::sys_days const last = std::chrono::year{2800} / std::chrono::December / 31;
+
+	for(std::chrono::sys_days day = reference; day <= last; day += std::chrono::days{1})
+	{
+		std::chrono::year_month_day const ymd{day};
+		uint64_t const day_count = static_cast<uint64_t>((day - reference).count());
+		core::time_point_t const point{day_count * day_100ns + 1};
+		core::date_time_t const date = core::system_time_to_date(point);
+
+		ASSERT_EQ(date.date.year,	static_cast<int>(ymd.year()));
+		ASSERT_EQ(date.date.month,	static_cast<unsigned>(ymd.month()));
+		ASSERT_EQ(date.date.day,	static_cast<unsigned>(ymd.day()));
+		ASSERT_EQ(date.time.hour,	0);
+		ASSERT_EQ(date.time.nsecond, 100);
+		ASSERT_EQ(core::date_to_system_time(date), point);
+	}
+
+	core::date_time_t const leap_end{.date{.year = 2024, .month = 12, .day = 31}, .time{.hour = 23, .minute = 59, .second = 58, .nsecond = 123456700}};
+	core::date_time_t const converted = core::system_time_to_date(core::date_to_system_time(leap_end));
+	ASSERT_EQ(converted.date.year,		2024);
+	ASSERT_EQ(converted.date.month,		12);
+	ASSERT_EQ(converted.date.day,		31);
+	ASSERT_EQ(converted.time.hour,		23);
+	ASSERT_EQ(converted.time.minute,	59);
+	ASSERT_EQ(converted.time.second,	58);
+	ASSERT_EQ(converted.time.nsecond,	123456700);
+}
+
+TEST(core_time, system_time_to_date_batch)
+{
+	std::vector<core::time_point_t> points;
+	for(uint64_t i = 0; i < 1000; ++i)
+	{
+		points.emplace_back(core::system_time_precise().raw() + i * 7'777'777'777);
+	}
+
+	std::vector<core::date_time_t> dates(points.size() - 1);
+	ASSERT_EQ(core::system_time_to_date(points, dates), dates.size());
+
+	for(uintptr_t i = 0; i < dates.size(); ++i)
+	{
+		core::date_time_t const expected = core::system_time_to_date(points[i]);
+		ASSERT_EQ(dates[i].date.year,		expected.date.year);
+		ASSERT_EQ(dates[i].date.month,		expected.date.month);
+		ASSERT_EQ(dates[i].date.day,		expected.date.day);
+		ASSERT_EQ(dates[i].time.hour,		expected.time.hour);
+		ASSERT_EQ(dates[i].time.minute,		expected.time.minute);
+		ASSERT_EQ(dates[i].time.second,		expected.time.second);
+		ASSERT_EQ(dates[i].time.nsecond,	expected.time.nsecond);
+	}
+}
+
+TEST(core_time, to_date)
+{
+	std::chrono::system_clock::time_point const point =
+		std::chrono::sys_days{std::chrono::year{2000} / std::chrono::February / 29}
+		+ std::chrono::hours{13} + std::chrono::minutes{14} + std::chrono::seconds{15} + std::chrono::microseconds{16};
+
+	core::date_time_t const date = core::to_date(point);
+	ASSERT_EQ(date.date.year,		2000);
+	ASSERT_EQ(date.date.month,		2);
+	ASSERT_EQ(date.date.day,		29);
+	ASSERT_EQ(date.time.hour,		13);
+	ASSERT_EQ(date.time.minute,		14);
+	ASSERT_EQ(date.time.second,		15);
+	ASSERT_EQ(date.time.nsecond,	16000);
+}
+
+#ifndef _WIN32
+TEST(core_time, date_time_local)
+{
+	for(uint8_t i = 0; i < 3; ++i)
+	{
+		struct timespec before;
+		struct timespec after;
+		core::date_time_t date;
+		core::date_time_extra extra;
+		clock_gettime(CLOCK_REALTIME, &before);
+		core::date_time_local(date, extra);
+		clock_gettime(CLOCK_REALTIME, &after);
+		if(before.tv_sec != after.tv_sec)
+		{
+			continue;
+		}
+
+		struct tm timeinfo;
+		localtime_r(&before.tv_sec, &timeinfo);
+		ASSERT_EQ(date.date.year,		timeinfo.tm_year + 1900);
+		ASSERT_EQ(date.date.month,		timeinfo.tm_mon + 1);
+		ASSERT_EQ(date.date.day,		timeinfo.tm_mday);
+		ASSERT_EQ(date.time.hour,		timeinfo.tm_hour);
+		ASSERT_EQ(date.time.minute,		timeinfo.tm_min);
+		ASSERT_EQ(date.time.second,		timeinfo.tm_sec);
+		ASSERT_EQ(extra.week_day,		timeinfo.tm_wday);
+		ASSERT_EQ(extra.dst,			timeinfo.tm_isdst > 0);
+		ASSERT_LT(date.time.nsecond, 1'000'000'000);
+		return;
+	}
+	FAIL() << "Unable to sample within the same second";
+}
+#endif
+
+TEST(core_time, iso8601)
+{
+	using namespace std::literals::string_view_literals;
+
+	core::date_time_t date;
+	ASSERT_TRUE(core::from_chars_iso8601(u8"2024-02-29T23:59:60.123456789Z"sv, date));
+	ASSERT_EQ(date.date.year,		2024);
+	ASSERT_EQ(date.date.month,		2);
+	ASSERT_EQ(date.date.day,		29);
+	ASSERT_EQ(date.time.hour,		23);
+	ASSERT_EQ(date.time.minute,		59);
+	ASSERT_EQ(date.time.second,		60);
+	ASSERT_EQ(date.time.nsecond,	123456789);
+
+	ASSERT_TRUE(core::from_chars_iso8601(u"1601-01-01t00:00:00.5z"sv, date));
+	ASSERT_EQ(date.date.year,		1601);
+	ASSERT_EQ(date.time.nsecond,	500000000);
+
+	ASSERT_TRUE(core::from_chars_iso8601(U"9999-12-31T23:59:59Z"sv, date));
+	ASSERT_EQ(date.date.year,		9999);
+	ASSERT_EQ(date.date.month,		12);
+	ASSERT_EQ(date.date.day,		31);
+	ASSERT_EQ(date.time.nsecond,	0);
+
+	for(std::u8string_view const invalid :
+		{
+			u8""sv,
+			u8"2024-02-29T23:59:59"sv,
+			u8"2024-02-29T23:59:59ZZ"sv,
+			u8"2024-02-29 23:59:59Z"sv,
+			u8"2024/02/29T23:59:59Z"sv,
+			u8"2024-02-29T23-59:59Z"sv,
+			u8"2024-02-29T23:59:59.Z"sv,
+			u8"2024-02-29T23:59:59.1234567890Z"sv,
+			u8"2024-02-29T23:59:59+01:00"sv,
+			u8"2023-02-29T00:00:00Z"sv,
+			u8"2024-04-31T00:00:00Z"sv,
+			u8"2024-00-10T00:00:00Z"sv,
+			u8"2024-13-10T00:00:00Z"sv,
+			u8"2024-01-00T00:00:00Z"sv,
+			u8"2024-01-01T24:00:00Z"sv,
+			u8"2024-01-01T00:60:00Z"sv,
+			u8"2024-01-01T00:00:61Z"sv,
+			u8"2O24-01-01T00:00:00Z"sv,
+			u8"2024-01-01T00:00:0:Z"sv,
+		})
+	{
+		ASSERT_FALSE(core::from_chars_iso8601(invalid, date)) << std::string_view{reinterpret_cast<char const*>(invalid.data()), invalid.size()};
+	}
+	ASSERT_FALSE(core::from_chars_iso8601(u"2024-01-01T00:00:00\u00C5"sv, date));
+
+	//round trip
+	uint64_t value = 0x0123456789ABCDEF;
+	for(uint16_t i = 0; i < 1000; ++i)
+	{
+		value = value * 6364136223846793005 + 1442695040888963407;
+		core::date_time_t const source = core::system_time_to_date(core::time_point_t{value % 2'650'467'744'000'000'000});
+
+		for(uint8_t digits = 0; digits <= 9; ++digits)
+		{
+			char8_t buffer[core::iso8601_max_size];
+			char8_t const* const end = core::to_chars_iso8601_unsafe(source, digits, buffer);
+			ASSERT_EQ(static_cast<uintptr_t>(end - buffer), core::to_chars_iso8601_size(digits));
+
+			core::date_time_t decoded;
+			ASSERT_TRUE(core::from_chars_iso8601(std::u8string_view{buffer, end}, decoded));
+
+			uint32_t divisor = 1;
+			for(uint8_t j = digits; j < 9; ++j) divisor *= 10;
+			ASSERT_EQ(decoded.time.nsecond, source.time.nsecond / divisor * divisor);
+			ASSERT_EQ(decoded.time.second,	source.time.second);
+			ASSERT_EQ(decoded.time.minute,	source.time.minute);
+			ASSERT_EQ(decoded.time.hour,	source.time.hour);
+			ASSERT_EQ(decoded.date.day,		source.date.day);
+			ASSERT_EQ(decoded.date.month,	source.date.month);
+			ASSERT_EQ(decoded.date.year,	source.date.year);
+		}
+	}
+}
+
+TEST(core_time, system_time_coarse)
+{
+	core::time_point_t const precise = core::system_time_precise();
+	core::time_point_t const coarse = core::system_time_coarse();
+
+	//coarse clock lags behind by at most a scheduler tick
+	int64_t const diff = (coarse - precise).raw();
+	ASSERT_LT(diff, 10'000);
+	ASSERT_GT(diff, -1'000'000);
+}
+
+TEST(core_time, date_time_local_cached)
+{
+	for(uint8_t i = 0; i < 3; ++i)
+	{
+		core::date_time_t reference;
+		core::date_time_extra reference_extra;
+		core::date_time_t cached;
+		core::date_time_extra cached_extra;
+		core::date_time_t cached_again;
+
+		core::date_time_local(reference, reference_extra);
+		core::date_time_local_cached(cached, cached_extra);
+		core::date_time_local_cached(cached_again);
+		core::date_time_t after;
+		core::date_time_local(after);
+
+		if(reference.time.second != after.time.second)
+		{
+			//crossed a second boundary, try again
+			continue;
+		}
+
+		ASSERT_EQ(cached.date.year,		reference.date.year);
+		ASSERT_EQ(cached.date.month,	reference.date.month);
+		ASSERT_EQ(cached.date.day,		reference.date.day);
+		ASSERT_EQ(cached.time.hour,		reference.time.hour);
+		ASSERT_EQ(cached.time.minute,	reference.time.minute);
+		ASSERT_EQ(cached.time.second,	reference.time.second);
+		ASSERT_EQ(cached_extra.week_day,	reference_extra.week_day);
+		ASSERT_EQ(cached_extra.dst,			reference_extra.dst);
+
+		ASSERT_EQ(cached_again.time.second,	cached.time.second);
+		ASSERT_LT(cached.time.nsecond, 1'000'000'000);
+		ASSERT_LE(cached.time.nsecond, cached_again.time.nsecond);
+		return;
+	}
+	FAIL() << "Unable to sample within the same second";
+}
+
+#if defined(_M_AMD64) || defined(__amd64__)
+TEST(core_time, tsc_clock)
+{
+	if(!core::tsc_clock::is_invariant())
+	{
+		ASSERT_EQ(core::tsc_clock::frequency(), 0);
+		GTEST_SKIP() << "Time stamp counter is not invariant";
+	}
+
+	uint64_t const frequency = core::tsc_clock::frequency();
+	ASSERT_GT(frequency, 0);
+	ASSERT_NEAR(static_cast<double>(core::tsc_clock::to_nanoseconds(frequency)), 1e9, 1e6);
+
+	uint64_t const start = core::tsc_clock::read_ordered();
+	std::this_thread::sleep_for(std::chrono::milliseconds{20});
+	uint64_t const end = core::tsc_clock::read_ordered();
+	ASSERT_GT(end, start);
+
+	uint64_t const elapsed = core::tsc_clock::to_nanoseconds(end - start);
+	ASSERT_GE(elapsed, 19'000'000);
+	ASSERT_LT(elapsed, 2'000'000'000);
+
+	core::time_delta_t const forward  = core::tsc_clock::to_time_delta(static_cast<int64_t>(end - start));
+	core::time_delta_t const backward = core::tsc_clock::to_time_delta(-static_cast<int64_t>(end - start));
+	ASSERT_EQ(forward.raw(), -backward.raw());
+	ASSERT_EQ(forward.raw(), static_cast<int64_t>(elapsed / 100));
+}
+#endif
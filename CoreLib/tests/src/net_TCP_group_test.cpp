@@ -0,0 +1,189 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/net/core_net_init.hpp>
+#include <CoreLib/net/core_net_TCP_group.hpp>
+
+#include <gtest/gtest.h>
+
+#ifndef _WIN32
+
+namespace net_TCP_group
+{
+using core::NET_Error;
+using core::literals::operator ""_ui32;
+
+namespace
+{
+	struct accept_counter
+	{
+		std::atomic<uint32_t>					accepted = 0;
+		std::array<std::atomic<uint32_t>, 4>	per_listener = {};
+	};
+
+	void accept_worker(core::NetTCP_S& p_listener, uint32_t const p_index, void* const p_context)
+	{
+		accept_counter& counter = *reinterpret_cast<accept_counter*>(p_context);
+		while(true)
+		{
+			core::NetTCP_C client;
+			NET_Error const err = p_listener.accept(client);
+			if(err == NET_Error::WouldBlock) continue;
+			if(err != NET_Error::NoErr) return;
+
+			++counter.per_listener[p_index];
+			++counter.accepted;
+			client.close();
+		}
+	}
+
+	bool wait_for(std::atomic<uint32_t> const& p_value, uint32_t const p_expected)
+	{
+		for(uint32_t i = 0; i < 500; ++i)
+		{
+			if(p_value.load() >= p_expected) return true;
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		return false;
+	}
+} //namespace
+
+TEST(net_TCP_group, open_close)
+{
+	ASSERT_TRUE(core::Net_Init());
+	core::IP_address const loopback{u8"127.0.0.1"};
+	{
+		core::NetTCP_S_group group;
+		ASSERT_EQ(group.open_bind_listen(loopback, 0, 0, 16), NET_Error::Invalid_Option);
+		ASSERT_FALSE(group.is_open());
+
+		ASSERT_EQ(group.open_bind_listen(loopback, 0, 3, 16), NET_Error::NoErr);
+		ASSERT_TRUE(group.is_open());
+		ASSERT_FALSE(group.running());
+		ASSERT_EQ(group.size(), 3_ui32);
+		ASSERT_EQ(group.open_bind_listen(loopback, 0, 3, 16), NET_Error::Already_Used);
+
+		//all listeners share the port picked for the first one
+		core::IP_address address;
+		uint16_t port = 0;
+		ASSERT_EQ(group.get_address(address, port), NET_Error::NoErr);
+		ASSERT_NE(port, 0);
+		for(uint32_t i = 0; i < group.size(); ++i)
+		{
+			uint16_t listener_port = 0;
+			ASSERT_EQ(group.listener(i).get_address(address, listener_port), NET_Error::NoErr);
+			ASSERT_EQ(listener_port, port);
+		}
+
+		ASSERT_EQ(group.close(), NET_Error::NoErr);
+		ASSERT_FALSE(group.is_open());
+		ASSERT_EQ(group.get_address(address, port), NET_Error::Invalid_Socket);
+	}
+	core::Net_End();
+}
+
+TEST(net_TCP_group, run_stop)
+{
+	ASSERT_TRUE(core::Net_Init());
+	{
+		core::NetTCP_S_group group;
+		accept_counter counter;
+		ASSERT_EQ(group.run(accept_worker, &counter), NET_Error::Invalid_Socket);
+
+		ASSERT_EQ(group.open_bind_listen(core::IP_address{u8"127.0.0.1"}, 0, 2, 16), NET_Error::NoErr);
+		core::IP_address address;
+		uint16_t port = 0;
+		ASSERT_EQ(group.get_address(address, port), NET_Error::NoErr);
+
+		ASSERT_EQ(group.run(nullptr, &counter), NET_Error::Invalid_Option);
+		std::array<uint32_t, 1> const bad_size{0};
+		ASSERT_EQ(group.run(accept_worker, &counter, bad_size), NET_Error::Invalid_Option);
+		std::array<uint32_t, 2> const bad_cpu{0, 64};
+		ASSERT_EQ(group.run(accept_worker, &counter, bad_cpu), NET_Error::Invalid_Option);
+		ASSERT_FALSE(group.running());
+
+		std::array<uint32_t, 2> const cpu_map{0, 0};
+		ASSERT_EQ(group.run(accept_worker, &counter, cpu_map), NET_Error::NoErr);
+		ASSERT_TRUE(group.running());
+		ASSERT_EQ(group.run(accept_worker, &counter), NET_Error::Already_Used);
+
+		constexpr uint32_t connections = 8;
+		for(uint32_t i = 0; i < connections; ++i)
+		{
+			core::NetTCP_C client;
+			ASSERT_EQ(client.open(core::IP_address::IPv::IPv_4), NET_Error::NoErr);
+			ASSERT_EQ(client.connect(address, port), NET_Error::NoErr);
+			client.close();
+		}
+		ASSERT_TRUE(wait_for(counter.accepted, connections));
+		ASSERT_EQ(counter.per_listener[0] + counter.per_listener[1], connections);
+
+		group.stop();
+		ASSERT_FALSE(group.running());
+		ASSERT_TRUE(group.is_open());
+		ASSERT_EQ(group.close(), NET_Error::NoErr);
+	}
+	core::Net_End();
+}
+
+TEST(net_TCP_group, pin_failure)
+{
+	//CPU 63 is assumed to not exist on the test machine
+	if(std::thread::hardware_concurrency() > 63)
+	{
+		GTEST_SKIP();
+	}
+
+	ASSERT_TRUE(core::Net_Init());
+	{
+		core::NetTCP_S_group group;
+		accept_counter counter;
+		ASSERT_EQ(group.open_bind_listen(core::IP_address{u8"127.0.0.1"}, 0, 2, 16), NET_Error::NoErr);
+
+		std::array<uint32_t, 2> const cpu_map{0, 63};
+		ASSERT_EQ(group.run(accept_worker, &counter, cpu_map), NET_Error::Fail);
+		ASSERT_FALSE(group.running());
+
+		//the group can still be run after a failed attempt
+		ASSERT_EQ(group.run(accept_worker, &counter), NET_Error::NoErr);
+		ASSERT_TRUE(group.running());
+		ASSERT_EQ(group.close(), NET_Error::NoErr);
+		ASSERT_FALSE(group.running());
+	}
+	core::Net_End();
+}
+
+} //namespace net_TCP_group
+
+#endif
@@ -0,0 +1,249 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+
+#include <CoreLib/net/core_net_address.hpp>
+#include <CoreLib/core_endian.hpp>
+
+#include <gtest/gtest.h>
+
+namespace net_address
+{
+
+TEST(net_address, IPv4_from_string)
+{
+	struct test_case
+	{
+		std::u8string_view		text;
+		std::array<uint8_t, 4>	expected;
+	};
+
+	std::vector<test_case> const testCases =
+	{
+		{u8"0.0.0.0"			, {  0,   0,   0,   0}},
+		{u8"127.0.0.1"			, {127,   0,   0,   1}},
+		{u8"192.168.1.254"		, {192, 168,   1, 254}},
+		{u8"255.255.255.255"	, {255, 255, 255, 255}},
+		{u8"10.020.3.004"		, { 10,  20,   3,   4}},
+	};
+
+	for(test_case const& tcase : testCases)
+	{
+		core::IPv4_address address;
+		ASSERT_TRUE(address.from_string(tcase.text)) << std::string{tcase.text.begin(), tcase.text.end()};
+		ASSERT_EQ(address, core::IPv4_address{tcase.expected});
+
+		std::u16string const text16{tcase.text.begin(), tcase.text.end()};
+		core::IPv4_address address16;
+		ASSERT_TRUE(address16.from_string(text16));
+		ASSERT_EQ(address16, address);
+	}
+}
+
+TEST(net_address, IPv4_from_string_invalid)
+{
+	std::vector<std::u8string_view> const testCases =
+	{
+		u8"",
+		u8"1.2.3",
+		u8"1.2.3.4.",
+		u8".1.2.3.4",
+		u8"1..2.3.4",
+		u8"1.2.3.4.5",
+		u8"256.1.1.1",
+		u8"1.1.1.999",
+		u8"1.1.1.1000",
+		u8"1.1.1.a",
+		u8"1.1.1.-1",
+		u8"1.1.1.1 ",
+		u8" 1.1.1.1",
+		u8"1:1.1.1.1",
+		u8"1111.1.1.1",
+		u8"255.255.255.2555",
+	};
+
+	for(std::u8string_view const tcase : testCases)
+	{
+		core::IPv4_address address;
+		ASSERT_FALSE(address.from_string(tcase)) << std::string{tcase.begin(), tcase.end()};
+		ASSERT_TRUE(address.is_null());
+
+		std::u32string const text32{tcase.begin(), tcase.end()};
+		ASSERT_FALSE(address.from_string(text32)) << std::string{tcase.begin(), tcase.end()};
+	}
+}
+
+TEST(net_address, IPv6_from_string)
+{
+	struct test_case
+	{
+		std::u8string_view		text;
+		std::array<uint16_t, 8>	expected;
+	};
+
+	std::vector<test_case> const testCases =
+	{
+		{u8"::"										, {0, 0, 0, 0, 0, 0, 0, 0}},
+		{u8"::1"									, {0, 0, 0, 0, 0, 0, 0, 1}},
+		{u8"1::"									, {1, 0, 0, 0, 0, 0, 0, 0}},
+		{u8"2001:db8::ff00:42:8329"					, {0x2001, 0xDB8, 0, 0, 0, 0xFF00, 0x42, 0x8329}},
+		{u8"2001:0DB8:0000:0000:0000:FF00:0042:8329", {0x2001, 0xDB8, 0, 0, 0, 0xFF00, 0x42, 0x8329}},
+		{u8"fe80::1:2:3:4"							, {0xFE80, 0, 0, 0, 1, 2, 3, 4}},
+		{u8"1:2:3:4:5:6:7:8"						, {1, 2, 3, 4, 5, 6, 7, 8}},
+		{u8"::2:3:4:5:6:7:8"						, {0, 2, 3, 4, 5, 6, 7, 8}},
+		{u8"1:2:3:4:5:6:7::"						, {1, 2, 3, 4, 5, 6, 7, 0}},
+		{u8"1:2:3::6:7:8"							, {1, 2, 3, 0, 0, 6, 7, 8}},
+	};
+
+	for(test_case const& tcase : testCases)
+	{
+		std::array<uint16_t, 8> expected;
+		for(uint8_t i = 0; i < 8; ++i)
+		{
+			expected[i] = core::endian_host2big(tcase.expected[i]);
+		}
+
+		core::IPv6_address address;
+		ASSERT_TRUE(address.from_string(tcase.text)) << std::string{tcase.text.begin(), tcase.text.end()};
+		ASSERT_EQ(address, core::IPv6_address{expected}) << std::string{tcase.text.begin(), tcase.text.end()};
+
+		std::u16string const text16{tcase.text.begin(), tcase.text.end()};
+		core::IPv6_address address16;
+		ASSERT_TRUE(address16.from_string(text16));
+		ASSERT_EQ(address16, address);
+	}
+}
+
+TEST(net_address, IPv6_from_string_invalid)
+{
+	std::vector<std::u8string_view> const testCases =
+	{
+		u8"",
+		u8":",
+		u8":::",
+		u8"1:",
+		u8":1",
+		u8"1::2::3",
+		u8"1:::2",
+		u8"1:2:3:4:5:6:7",
+		u8"1:2:3:4:5:6:7:8:9",
+		u8"1:2:3:4:5:6:7:8::",
+		u8"::1:2:3:4:5:6:7:8",
+		u8"1:2:3:4::5:6:7:8",
+		u8"12345::",
+		u8"g::",
+		u8"1.2.3.4",
+		u8"::1 ",
+		u8"1:2:3:4:5:6:7:8:",
+	};
+
+	for(std::u8string_view const tcase : testCases)
+	{
+		core::IPv6_address address;
+		ASSERT_FALSE(address.from_string(tcase)) << std::string{tcase.begin(), tcase.end()};
+		ASSERT_TRUE(address.is_null());
+
+		std::u32string const text32{tcase.begin(), tcase.end()};
+		ASSERT_FALSE(address.from_string(text32)) << std::string{tcase.begin(), tcase.end()};
+	}
+}
+
+TEST(net_address, round_trip)
+{
+	std::vector<std::u8string_view> const testCases =
+	{
+		u8"0.0.0.0",
+		u8"1.22.133.4",
+		u8"255.255.255.255",
+		u8"::",
+		u8"::1",
+		u8"1::",
+		u8"2001:DB8::FF00:42:8329",
+		u8"1:0:0:2::3",
+		u8"1:2:3:4:5:6:7:8",
+		u8"1:0:2:3:4:5:6:7",
+	};
+
+	for(std::u8string_view const tcase : testCases)
+	{
+		core::IP_address address;
+		ASSERT_TRUE(address.from_string(tcase)) << std::string{tcase.begin(), tcase.end()};
+		ASSERT_EQ(address.to_string(), tcase);
+
+		std::array<char8_t, 39> buff;
+		uintptr_t const size = address.version() == core::IP_address::IPv::IPv_4 ?
+			core::to_chars_IPv4_size(address.v4.byteField) :
+			core::to_chars_IPv6_size(address.v6.doubletField);
+		ASSERT_EQ(size, tcase.size());
+
+		char8_t* const end = address.version() == core::IP_address::IPv::IPv_4 ?
+			core::to_chars_IPv4_unsafe(std::span<uint8_t const, 4>{address.v4.byteField}, buff.data()) :
+			core::to_chars_IPv6_unsafe(std::span<uint16_t const, 8>{address.v6.doubletField}, buff.data());
+		ASSERT_EQ(std::u8string_view(buff.data(), end), tcase);
+	}
+}
+
+TEST(net_address, bulk)
+{
+	std::vector<std::u8string_view> const input =
+	{
+		u8"10.0.0.1",
+		u8"not an address",
+		u8"FE80::1",
+		u8"192.168.100.200",
+	};
+
+	std::vector<core::IP_address> addresses(input.size());
+	ASSERT_EQ(core::from_string_bulk(input, addresses), 3);
+	ASSERT_EQ(addresses[0].version(), core::IP_address::IPv::IPv_4);
+	ASSERT_EQ(addresses[1].version(), core::IP_address::IPv::None);
+	ASSERT_EQ(addresses[2].version(), core::IP_address::IPv::IPv_6);
+	ASSERT_EQ(addresses[3].version(), core::IP_address::IPv::IPv_4);
+
+	std::vector<core::IPv4_address> addresses_v4(input.size());
+	ASSERT_EQ(core::from_string_bulk(input, addresses_v4), 2);
+	ASSERT_TRUE(addresses_v4[1].is_null());
+	ASSERT_TRUE(addresses_v4[2].is_null());
+
+	std::array<char8_t, 64> buff;
+	std::array<uintptr_t, 4> sizes;
+	ASSERT_EQ(core::to_string_bulk(addresses, buff, sizes), 4);
+	ASSERT_EQ(sizes[0], 8);
+	ASSERT_EQ(sizes[1], 0);
+	ASSERT_EQ(sizes[2], 7);
+	ASSERT_EQ(sizes[3], 15);
+	ASSERT_EQ(std::u8string_view(buff.data(), 30), u8"10.0.0.1FE80::1192.168.100.200");
+
+	//not enough room for the last address
+	ASSERT_EQ(core::to_string_bulk(addresses, std::span<char8_t>{buff.data(), 29}, sizes), 3);
+}
+
+} //namespace net_address
@@ -0,0 +1,184 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/net/core_net_buffer_pool.hpp>
+
+#include <gtest/gtest.h>
+
+namespace net_buffer_pool
+{
+using core::literals::operator ""_uip;
+
+namespace
+{
+	///	\brief Acquires buffers until the pool runs out, or \p p_max are held
+	std::vector<core::Net_buffer> acquire_all(core::Net_buffer_pool& p_pool, uintptr_t const p_max)
+	{
+		std::vector<core::Net_buffer> buffers;
+		while(buffers.size() < p_max)
+		{
+			core::Net_buffer buffer = p_pool.acquire();
+			if(!buffer.is_valid()) break;
+			buffers.push_back(std::move(buffer));
+		}
+		return buffers;
+	}
+} //namespace
+
+TEST(net_buffer_pool, acquire_release)
+{
+	core::Net_buffer_pool pool{100};
+	ASSERT_EQ(pool.block_size(), 128_uip);
+	ASSERT_EQ(pool.capacity(), 0_uip);
+
+	core::Net_buffer buffer = pool.acquire();
+	ASSERT_TRUE(buffer.is_valid());
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(buffer.data()) % 64, 0_uip);
+	ASSERT_EQ(buffer.capacity(), 128_uip);
+	ASSERT_EQ(buffer.size(), 0_uip);
+	ASSERT_EQ(buffer.whole().size(), 128_uip);
+	ASSERT_EQ(pool.capacity(), 64_uip);
+
+	buffer.set_size(10);
+	ASSERT_EQ(buffer.used().size(), 10_uip);
+	ASSERT_EQ(buffer.used().data(), buffer.data());
+
+	uint8_t* const data = buffer.data();
+	core::Net_buffer moved = std::move(buffer);
+	ASSERT_FALSE(buffer.is_valid());
+	ASSERT_TRUE(moved.is_valid());
+	ASSERT_EQ(moved.data(), data);
+	ASSERT_EQ(moved.size(), 10_uip);
+
+	moved.release();
+	ASSERT_FALSE(moved.is_valid());
+	ASSERT_EQ(moved.capacity(), 0_uip);
+
+	//the block just returned is at the top of the thread cache
+	core::Net_buffer again = pool.acquire();
+	ASSERT_EQ(again.data(), data);
+	ASSERT_EQ(again.size(), 0_uip);
+	ASSERT_EQ(pool.capacity(), 64_uip);
+}
+
+TEST(net_buffer_pool, max_slabs)
+{
+	core::Net_buffer_pool pool{64, 4, 2};
+
+	std::vector<core::Net_buffer> buffers = acquire_all(pool, 100);
+	ASSERT_EQ(buffers.size(), 8_uip);
+	ASSERT_EQ(pool.capacity(), 8_uip);
+	ASSERT_FALSE(pool.acquire().is_valid());
+
+	for(uintptr_t i = 0; i < buffers.size(); ++i)
+	{
+		for(uintptr_t j = i + 1; j < buffers.size(); ++j)
+		{
+			ASSERT_NE(buffers[i].data(), buffers[j].data());
+		}
+	}
+
+	buffers.pop_back();
+	ASSERT_TRUE(pool.acquire().is_valid());
+	ASSERT_EQ(pool.capacity(), 8_uip);
+}
+
+TEST(net_buffer_pool, flush_thread_cache)
+{
+	constexpr uintptr_t block_count = 64;
+	core::Net_buffer_pool pool{64, block_count, 1};
+
+	//after this most blocks are held in the cache of this thread
+	acquire_all(pool, block_count).clear();
+
+	uintptr_t const without_flush = std::async(std::launch::async, [&pool]() { return acquire_all(pool, block_count).size(); }).get();
+	ASSERT_LT(without_flush, block_count);
+
+	pool.flush_thread_cache();
+	uintptr_t const with_flush = std::async(std::launch::async, [&pool]() { return acquire_all(pool, block_count).size(); }).get();
+	ASSERT_EQ(with_flush, block_count);
+	ASSERT_EQ(pool.capacity(), block_count);
+}
+
+TEST(net_buffer_pool, release_other_thread)
+{
+	core::Net_buffer_pool pool{64, 4, 1};
+	pool.flush_thread_cache();
+
+	std::vector<core::Net_buffer> buffers = acquire_all(pool, 100);
+	ASSERT_EQ(buffers.size(), 4_uip);
+	ASSERT_FALSE(pool.acquire().is_valid());
+
+	//released into the cache of the other thread, which gives them back to the pool when it exits
+	std::thread{[moved = std::move(buffers)]() mutable { moved.clear(); }}.join();
+
+	buffers = acquire_all(pool, 100);
+	ASSERT_EQ(buffers.size(), 4_uip);
+	ASSERT_EQ(pool.capacity(), 4_uip);
+}
+
+TEST(net_buffer_pool, destroy_while_cached)
+{
+	std::optional<core::Net_buffer_pool> pool;
+	pool.emplace(64, 4);
+
+	std::promise<void> cached;
+	std::promise<void> destroyed;
+	std::thread worker{[&pool, &cached, destroyed_future = destroyed.get_future()]()
+		{
+			//leaves blocks in the cache of this thread, still bound to the pool
+			acquire_all(*pool, 4).clear();
+			cached.set_value();
+			destroyed_future.wait();
+		}};
+
+	cached.get_future().wait();
+	pool.reset();
+	destroyed.set_value();
+	worker.join();
+
+	//same on the current thread, a new pool must not receive blocks from the old one
+	pool.emplace(64, 4, 1);
+	acquire_all(*pool, 4).clear();
+	pool.reset();
+
+	pool.emplace(64, 4, 1);
+	std::vector<core::Net_buffer> buffers = acquire_all(*pool, 100);
+	ASSERT_EQ(buffers.size(), 4_uip);
+	buffers.clear();
+	pool.reset();
+}
+
+} //namespace net_buffer_pool
@@ -0,0 +1,212 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <vector>
+#include <string_view>
+#include <random>
+
+#include <CoreLib/net/core_net_prefix_table.hpp>
+
+#include <gtest/gtest.h>
+
+namespace net_prefix_table
+{
+
+namespace
+{
+	struct network_v4
+	{
+		uint32_t	address;	//!< host order
+		uint8_t		length;
+		uint32_t	value;
+	};
+
+	uint32_t reference_lookup(std::vector<network_v4> const& p_networks, uint32_t const p_address)
+	{
+		int16_t best_length = -1;
+		uint32_t best_value = core::IP_prefix_table::no_match;
+		for(network_v4 const& network : p_networks)
+		{
+			uint32_t const mask = network.length ? ~uint32_t{0} << (32 - network.length) : 0;
+			if(((network.address ^ p_address) & mask) == 0 && network.length >= best_length)
+			{
+				best_length	= network.length;
+				best_value	= network.value;
+			}
+		}
+		return best_value;
+	}
+
+	core::IPv4_address to_address(uint32_t const p_address)
+	{
+		std::array<uint8_t, 4> const bytes =
+		{
+			static_cast<uint8_t>(p_address >> 24),
+			static_cast<uint8_t>(p_address >> 16),
+			static_cast<uint8_t>(p_address >>  8),
+			static_cast<uint8_t>(p_address)
+		};
+		return core::IPv4_address{bytes};
+	}
+} //namespace
+
+TEST(net_prefix_table, cidr)
+{
+	core::IP_prefix_table table;
+	ASSERT_TRUE(table.insert(u8"10.0.0.0/8"			, 1));
+	ASSERT_TRUE(table.insert(u8"10.1.0.0/16"		, 2));
+	ASSERT_TRUE(table.insert(u8"10.1.2.0/24"		, 3));
+	ASSERT_TRUE(table.insert(u8"10.1.2.3"			, 4));
+	ASSERT_TRUE(table.insert(u8"192.168.7.77/20"	, 5));
+	ASSERT_TRUE(table.insert(u8"2001:db8::/32"		, 6));
+	ASSERT_TRUE(table.insert(u8"2001:db8:0:1::/64"	, 7));
+	ASSERT_TRUE(table.insert(u8"::1"				, 8));
+
+	ASSERT_FALSE(table.insert(u8"10.0.0.0/33"		, 0));
+	ASSERT_FALSE(table.insert(u8"2001:db8::/129"	, 0));
+	ASSERT_FALSE(table.insert(u8"10.0.0/8"			, 0));
+	ASSERT_FALSE(table.insert(u8"10.0.0.0/"			, 0));
+	ASSERT_FALSE(table.insert(u8"10.0.0.0/a"		, 0));
+	ASSERT_EQ(table.size(), 8);
+
+	struct test_case
+	{
+		std::u8string_view	address;
+		uint32_t			expected;
+	};
+
+	std::vector<test_case> const testCases =
+	{
+		{u8"10.200.0.1"				, 1},
+		{u8"10.1.200.1"				, 2},
+		{u8"10.1.2.200"				, 3},
+		{u8"10.1.2.3"				, 4},
+		{u8"192.168.0.0"			, 5},
+		{u8"192.168.15.255"			, 5},
+		{u8"192.168.16.0"			, core::IP_prefix_table::no_match},
+		{u8"11.0.0.0"				, core::IP_prefix_table::no_match},
+		{u8"2001:db8:ffff::1"		, 6},
+		{u8"2001:db8:0:1:2:3:4:5"	, 7},
+		{u8"2001:db8:0:2::"			, 6},
+		{u8"::1"					, 8},
+		{u8"::2"					, core::IP_prefix_table::no_match},
+		{u8"2001:db9::"				, core::IP_prefix_table::no_match},
+	};
+
+	std::vector<core::IP_address> addresses;
+	for(test_case const& tcase : testCases)
+	{
+		core::IP_address const address{tcase.address};
+		ASSERT_TRUE(address.is_valid());
+		ASSERT_EQ(table.lookup(address), tcase.expected) << std::string{tcase.address.begin(), tcase.address.end()};
+		addresses.push_back(address);
+	}
+	addresses.push_back(core::IP_address{});
+
+	std::vector<uint32_t> results(addresses.size());
+	table.lookup(addresses, results);
+	for(uintptr_t i = 0; i < testCases.size(); ++i)
+	{
+		ASSERT_EQ(results[i], testCases[i].expected) << i;
+	}
+	ASSERT_EQ(results.back(), core::IP_prefix_table::no_match);
+
+	table.clear();
+	ASSERT_EQ(table.size(), 0);
+	ASSERT_EQ(table.lookup(core::IP_address{u8"10.1.2.3"}), core::IP_prefix_table::no_match);
+}
+
+TEST(net_prefix_table, default_route)
+{
+	core::IP_prefix_table table;
+	ASSERT_TRUE(table.insert(u8"10.1.2.0/24", 2));
+	ASSERT_TRUE(table.insert(u8"0.0.0.0/0", 1));
+	ASSERT_TRUE(table.insert(u8"::/0", 3));
+
+	ASSERT_EQ(table.lookup(core::IPv4_address{u8"10.1.2.1"}), 2);
+	ASSERT_EQ(table.lookup(core::IPv4_address{u8"1.1.1.1"}), 1);
+	ASSERT_EQ(table.lookup(core::IPv6_address{u8"1::1"}), 3);
+}
+
+TEST(net_prefix_table, replace)
+{
+	core::IP_prefix_table table;
+	ASSERT_TRUE(table.insert(u8"10.0.0.0/8", 1));
+	ASSERT_TRUE(table.insert(u8"10.1.0.0/16", 2));
+	ASSERT_TRUE(table.insert(u8"2001:db8::/32", 3));
+	ASSERT_EQ(table.size(), 3);
+
+	//same networks, host bits are ignored
+	ASSERT_TRUE(table.insert(u8"10.0.0.0/8", 4));
+	ASSERT_TRUE(table.insert(u8"10.1.2.3/16", 5));
+	ASSERT_TRUE(table.insert(u8"2001:db8:1::/32", 6));
+	ASSERT_EQ(table.size(), 3);
+
+	ASSERT_EQ(table.lookup(core::IPv4_address{u8"10.2.0.1"}), 4);
+	ASSERT_EQ(table.lookup(core::IPv4_address{u8"10.1.0.1"}), 5);
+	ASSERT_EQ(table.lookup(core::IPv6_address{u8"2001:db8::1"}), 6);
+
+	//same address, different length, is a different network
+	ASSERT_TRUE(table.insert(u8"10.0.0.0/9", 7));
+	ASSERT_EQ(table.size(), 4);
+	ASSERT_EQ(table.lookup(core::IPv4_address{u8"10.2.0.1"}), 7);
+	ASSERT_EQ(table.lookup(core::IPv4_address{u8"10.200.0.1"}), 4);
+}
+
+TEST(net_prefix_table, random_v4)
+{
+	std::mt19937 rng{42};
+	std::vector<network_v4> networks;
+	core::IP_prefix_table table;
+
+	for(uint32_t i = 0; i < 400; ++i)
+	{
+		//clustered addresses so that networks overlap
+		uint32_t const address = (rng() & 0x0F0F0F0F) | 0x0A000000;
+		uint8_t const length = static_cast<uint8_t>(rng() % 33);
+		uint32_t const mask = length ? ~uint32_t{0} << (32 - length) : 0;
+		networks.push_back({address & mask, length, i});
+		ASSERT_TRUE(table.insert(to_address(address), length, i));
+	}
+
+	std::vector<core::IPv4_address> addresses;
+	std::vector<uint32_t> expected;
+	for(uint32_t i = 0; i < 5000; ++i)
+	{
+		uint32_t const address = (rng() & 0x0F0F0F0F) | (rng() & 0x10000000) | 0x0A000000;
+		addresses.push_back(to_address(address));
+		expected.push_back(reference_lookup(networks, address));
+		ASSERT_EQ(table.lookup(addresses.back()), expected.back()) << i;
+	}
+
+	std::vector<uint32_t> results(addresses.size());
+	table.lookup(addresses, results);
+	ASSERT_EQ(results, expected);
+}
+
+} //namespace net_prefix_table
@@ -0,0 +1,172 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <cstdint>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/net/core_net_init.hpp>
+#include <CoreLib/net/core_net_TCP.hpp>
+#include <CoreLib/net/core_net_UDP.hpp>
+
+#include <gtest/gtest.h>
+
+namespace net_socket_options
+{
+using core::NET_Error;
+using core::literals::operator ""_ui32;
+
+TEST(net_socket_options, closed_socket)
+{
+	ASSERT_TRUE(core::Net_Init());
+
+	core::NetTCP_C_V4 client;
+	uint32_t size = 0;
+	bool flag = false;
+	ASSERT_EQ(client.set_receive_buffer_size(65536), NET_Error::Invalid_Socket);
+	ASSERT_EQ(client.get_receive_buffer_size(size), NET_Error::Invalid_Socket);
+	ASSERT_EQ(client.set_cork(true), NET_Error::Invalid_Socket);
+	ASSERT_EQ(client.get_cork(flag), NET_Error::Invalid_Socket);
+	ASSERT_EQ(client.set_fast_open_connect(true), NET_Error::Invalid_Socket);
+	ASSERT_EQ(client.get_fast_open_connect(flag), NET_Error::Invalid_Socket);
+
+	core::NetTCP_S_V4 server;
+	ASSERT_EQ(server.set_fast_open(5), NET_Error::Invalid_Socket);
+	ASSERT_EQ(server.get_fast_open(size), NET_Error::Invalid_Socket);
+
+	core::Net_End();
+}
+
+TEST(net_socket_options, buffer_sizes)
+{
+	ASSERT_TRUE(core::Net_Init());
+
+	core::NetUDP_V4 socket;
+	ASSERT_EQ(socket.open(), NET_Error::NoErr);
+
+	uint32_t size = 0;
+	ASSERT_EQ(socket.set_receive_buffer_size(65536), NET_Error::NoErr);
+	ASSERT_EQ(socket.get_receive_buffer_size(size), NET_Error::NoErr);
+	//Linux reports double the requested size, to account for bookkeeping overhead
+	ASSERT_GE(size, 65536_ui32);
+
+	ASSERT_EQ(socket.set_send_buffer_size(32768), NET_Error::NoErr);
+	ASSERT_EQ(socket.get_send_buffer_size(size), NET_Error::NoErr);
+	ASSERT_GE(size, 32768_ui32);
+
+	//does not fit in the int taken by the system call
+	ASSERT_EQ(socket.set_receive_buffer_size(0x80000000), NET_Error::Invalid_Option);
+
+	socket.close();
+	core::Net_End();
+}
+
+#ifndef _WIN32
+TEST(net_socket_options, socket_options)
+{
+	ASSERT_TRUE(core::Net_Init());
+
+	core::NetUDP_V4 socket;
+	ASSERT_EQ(socket.open(), NET_Error::NoErr);
+
+	bool reuse = false;
+	ASSERT_EQ(socket.set_reuse_port(true), NET_Error::NoErr);
+	ASSERT_EQ(socket.get_reuse_port(reuse), NET_Error::NoErr);
+	ASSERT_TRUE(reuse);
+	ASSERT_EQ(socket.set_reuse_port(false), NET_Error::NoErr);
+	ASSERT_EQ(socket.get_reuse_port(reuse), NET_Error::NoErr);
+	ASSERT_FALSE(reuse);
+
+	uint32_t cpu = 1;
+	ASSERT_EQ(socket.set_incoming_cpu(0), NET_Error::NoErr);
+	ASSERT_EQ(socket.get_incoming_cpu(cpu), NET_Error::NoErr);
+	ASSERT_EQ(cpu, 0_ui32);
+
+	//raising the busy poll time requires CAP_NET_ADMIN, lowering it back to 0 does not
+	uint32_t busy_poll = 1;
+	ASSERT_EQ(socket.set_busy_poll(0), NET_Error::NoErr);
+	ASSERT_EQ(socket.get_busy_poll(busy_poll), NET_Error::NoErr);
+	ASSERT_EQ(busy_poll, 0_ui32);
+
+	socket.close();
+	core::Net_End();
+}
+
+TEST(net_socket_options, tcp_options)
+{
+	ASSERT_TRUE(core::Net_Init());
+
+	core::NetTCP_S_V4 server;
+	ASSERT_EQ(server.open_bind(core::IPv4_address{u8"127.0.0.1"}, 0), NET_Error::NoErr);
+
+	uint32_t queue_length = 0;
+	ASSERT_EQ(server.set_fast_open(5), NET_Error::NoErr);
+	ASSERT_EQ(server.get_fast_open(queue_length), NET_Error::NoErr);
+	ASSERT_EQ(queue_length, 5_ui32);
+	ASSERT_EQ(server.listen(4), NET_Error::NoErr);
+	server.close();
+
+	core::NetTCP_C_V4 client;
+	ASSERT_EQ(client.open(), NET_Error::NoErr);
+
+	bool flag = false;
+	ASSERT_EQ(client.set_cork(true), NET_Error::NoErr);
+	ASSERT_EQ(client.get_cork(flag), NET_Error::NoErr);
+	ASSERT_TRUE(flag);
+	ASSERT_EQ(client.set_cork(false), NET_Error::NoErr);
+	ASSERT_EQ(client.get_cork(flag), NET_Error::NoErr);
+	ASSERT_FALSE(flag);
+
+	ASSERT_EQ(client.set_quick_ack(true), NET_Error::NoErr);
+	ASSERT_EQ(client.get_quick_ack(flag), NET_Error::NoErr);
+
+	uint32_t lowat = 0;
+	ASSERT_EQ(client.set_notsent_lowat(16384), NET_Error::NoErr);
+	ASSERT_EQ(client.get_notsent_lowat(lowat), NET_Error::NoErr);
+	ASSERT_EQ(lowat, 16384_ui32);
+
+	//only accepted if client side Fast Open is enabled in net.ipv4.tcp_fastopen
+	NET_Error const res = client.set_fast_open_connect(true);
+	if(res == NET_Error::NoErr)
+	{
+		flag = false;
+		ASSERT_EQ(client.get_fast_open_connect(flag), NET_Error::NoErr);
+		ASSERT_TRUE(flag);
+		ASSERT_EQ(client.set_fast_open_connect(false), NET_Error::NoErr);
+		ASSERT_EQ(client.get_fast_open_connect(flag), NET_Error::NoErr);
+		ASSERT_FALSE(flag);
+	}
+	else
+	{
+		ASSERT_EQ(res, NET_Error::Sock_Option);
+	}
+
+	client.close();
+	core::Net_End();
+}
+#endif
+
+} //namespace net_socket_options
@@ -28,13 +28,20 @@
 #include <utility>
 #include <type_traits>
 #include <vector>
+#include <limits>
+#include <array>
+#include <algorithm>
+#include <thread>
+#include <atomic>
 #include <gtest/gtest.h>
 
 #include <CoreLib/toPrint/toPrint.hpp>
 #include <CoreLib/toPrint/toPrint_filesystem.hpp>
 #include <CoreLib/toPrint/toPrint_net.hpp>
+#include <CoreLib/toPrint/toPrint_time.hpp>
 #include <CoreLib/toPrint/toPrint_enum.hpp>
 #include <CoreLib/toPrint/toPrint_string_sink.hpp>
+#include <CoreLib/toPrint/toPrint_deferred.hpp>
 
 using core::literals::operator ""_ui8;
 using core::literals::operator ""_i8;
@@ -185,6 +192,10 @@ TEST(toPrint, toPrint_type_support)
 	TYPE_TEST_PRINT(char16_t, core::toPrint_net{ core::IP_address{}, 25 });
 	TYPE_TEST_PRINT(char32_t, core::toPrint_net{ core::IP_address{}, 25 });
 
+	TYPE_TEST_PRINT(char8_t , core::toPrint_iso8601{core::time_point_t{}});
+	TYPE_TEST_PRINT(char16_t, core::toPrint_iso8601{core::time_point_t{}});
+	TYPE_TEST_PRINT(char32_t, core::toPrint_iso8601{core::time_point_t{}});
+
 
 	TYPE_TEST_PRINT(char8_t, TestEnum::Val0);
 	TYPE_TEST_PRINT(char16_t, TestEnum::Val1);
@@ -212,3 +223,293 @@ TEST(toPrint, toPrint_string_sink)
 
 	ASSERT_EQ(tsink, u8"Test 23"sv);
 }
+
+TEST(toPrint, toPrint_single_pass)
+{
+	class test_sink: public core::sink_toPrint_base
+	{
+	public:
+		void write(std::u8string_view p_message)
+		{
+			m_print_cache.push_back(std::u8string{p_message});
+		}
+
+	public:
+
+		std::vector<std::u8string> m_print_cache;
+	};
+
+	auto const print_both = [](auto const&... args)
+	{
+		test_sink two_pass;
+		test_sink single_pass;
+		core::print<char8_t>(two_pass, args...);
+		core::print_single_pass<char8_t>(single_pass, args...);
+
+		ASSERT_EQ(two_pass.m_print_cache.size(), 1_uip);
+		ASSERT_EQ(single_pass.m_print_cache.size(), 1_uip);
+		ASSERT_EQ(two_pass.m_print_cache[0], single_pass.m_print_cache[0]);
+	};
+
+	TestStr test;
+
+	print_both();
+	print_both(0);
+	print_both(std::numeric_limits<int64_t>::min());
+	print_both(std::numeric_limits<uint64_t>::max());
+	print_both("Combination "sv, 32, ' ', test);
+	print_both(core::toPrint_hex{0xABC_ui8}, ' ', core::toPrint_bin{5_ui8}, ' ', core::toPrint_hex_fix{uint16_t{7}});
+	print_both(-5.67, ' ', core::toPrint_fp_fancy{1.5e-30});
+	print_both(u"\u00E9\u4E2D"sv, U"\U0001F600"sv, "?"sv);
+
+	{
+		test_sink tsink;
+		core::print_single_pass<char8_t>(tsink, "Value "sv, -123, ' ', -5.67);
+		ASSERT_EQ(tsink.m_print_cache.size(), 1_uip);
+		ASSERT_EQ(tsink.m_print_cache[0], u8"Value -123 -5.67"sv);
+	}
+
+	{
+		std::u8string tsink;
+		core::print_single_pass<char8_t>(tsink, u8"Test "sv, 23, ' ', std::numeric_limits<uint64_t>::max());
+		ASSERT_EQ(tsink, u8"Test 23 18446744073709551615"sv);
+	}
+
+	{
+		std::u16string two_pass;
+		std::u16string single_pass;
+		core::print<char16_t>(two_pass, u8"Test "sv, 23, ' ', core::toPrint_fp_fancy{2.5e10});
+		core::print_single_pass<char16_t>(single_pass, u8"Test "sv, 23, ' ', core::toPrint_fp_fancy{2.5e10});
+		ASSERT_EQ(two_pass, single_pass);
+	}
+}
+
+TEST(toPrint, toPrint_format)
+{
+	{
+		std::u8string tsink;
+		core::print<char8_t>(tsink, core::toPrint_format<"Value {} hex {:x} fix {:X} bin {:b}/{:B}.">(-23, 0xAB_ui8, 0xAB_ui8, 5_ui8, 5_ui8));
+		ASSERT_EQ(tsink, u8"Value -23 hex AB fix AB bin 101/00000101."sv);
+	}
+
+	{
+		std::u8string tsink;
+		core::print<char8_t>(tsink, core::toPrint_format<u8"{{{}}} {}">("braces"sv, u8'A'));
+		ASSERT_EQ(tsink, u8"{braces} A"sv);
+	}
+
+	{
+		std::u8string tsink;
+		core::print<char8_t>(tsink, core::toPrint_format<"No fields">());
+		ASSERT_EQ(tsink, u8"No fields"sv);
+	}
+
+	{
+		TestStr test;
+		std::u8string two_pass;
+		std::u8string single_pass;
+		core::print<char8_t>(two_pass, core::toPrint_format<"[{}] {} {:e}">(test, 3.5, 1.5e-30));
+		core::print_single_pass<char8_t>(single_pass, core::toPrint_format<"[{}] {} {:e}">(test, 3.5, 1.5e-30));
+		ASSERT_EQ(two_pass, single_pass);
+		ASSERT_EQ(two_pass.substr(0, 14), u8"[TestStr] 3.5 "sv);
+	}
+
+	{
+		std::u16string tsink;
+		core::print<char16_t>(tsink, core::toPrint_format<"x={} ">(7), core::toPrint_format<u8"\u00E9{}\u00E9">(8));
+		ASSERT_EQ(tsink, u"x=7 \u00E98\u00E9"sv);
+	}
+
+	{
+		std::u32string tsink;
+		core::print<char32_t>(tsink, core::toPrint_format<U"\u00E9{}">(u"\u4E2D"sv));
+		ASSERT_EQ(tsink, U"\u00E9\u4E2D"sv);
+	}
+}
+
+TEST(toPrint, toPrint_iso8601)
+{
+	core::date_time_t const date{.date{.year = 2024, .month = 2, .day = 29}, .time{.hour = 7, .minute = 5, .second = 9, .nsecond = 12345678}};
+
+	{
+		std::u8string tsink;
+		core::print<char8_t>(tsink, core::toPrint_iso8601{date}, ' ', core::toPrint_iso8601{date, 3}, ' ', core::toPrint_iso8601{date, 0});
+		ASSERT_EQ(tsink, u8"2024-02-29T07:05:09.012345678Z 2024-02-29T07:05:09.012Z 2024-02-29T07:05:09Z"sv);
+	}
+
+	{
+		std::u8string tsink;
+		core::print_single_pass<char8_t>(tsink, "at "sv, core::toPrint_iso8601{core::date_to_system_time(date), 6});
+		ASSERT_EQ(tsink, u8"at 2024-02-29T07:05:09.012345Z"sv);
+	}
+
+	{
+		std::u16string tsink;
+		core::print<char16_t>(tsink, core::toPrint_iso8601{date, 1});
+		ASSERT_EQ(tsink, u"2024-02-29T07:05:09.0Z"sv);
+	}
+
+	{
+		std::u32string tsink;
+		core::print<char32_t>(tsink, core::toPrint_iso8601{date, 200});
+		ASSERT_EQ(tsink, U"2024-02-29T07:05:09.012345678Z"sv);
+	}
+}
+
+TEST(toPrint, toPrint_deferred)
+{
+	class collect_sink: public core::sink_toPrint_base
+	{
+	public:
+		void write(std::u8string_view p_message)
+		{
+			m_text.append(p_message);
+		}
+
+	public:
+		std::u8string m_text;
+	};
+
+	{
+		collect_sink tsink;
+		core::deferred_printer printer;
+		ASSERT_EQ(printer.start(tsink), std::errc{});
+
+		core::IPv4_address const address{std::u8string_view{u8"192.168.0.1"}};
+		std::string const owned = "owned";
+		{
+			std::u8string temporary = u8"temporary";
+			core::print_deferred<"{} {:x} {} {}|">(printer, -23, 0xAB_ui8, temporary, address);
+			temporary = u8"changed!!";
+		}
+		core::print_deferred<"{} {} {:e} {}|">(printer, owned, U"wide"sv, 1.5, 'c');
+		core::print_deferred<"no fields|">(printer);
+		{
+			char16_t buffer[16] = u"buffer";
+			core::print_deferred<"{} {}|">(printer, u8"literal", buffer);
+			buffer[0] = u'X';
+		}
+
+		printer.flush();
+		ASSERT_EQ(tsink.m_text, u8"-23 AB temporary 192.168.0.1|owned wide 1.5 c|no fields|literal buffer|"sv);
+
+		printer.stop();
+		ASSERT_EQ(printer.dropped(), 0_uip);
+		core::print_deferred<"not running">(printer);
+		ASSERT_EQ(tsink.m_text, u8"-23 AB temporary 192.168.0.1|owned wide 1.5 c|no fields|literal buffer|"sv);
+	}
+
+	{
+		collect_sink tsink;
+		core::deferred_printer printer;
+		ASSERT_EQ(printer.start(tsink, 0x400, 1), std::errc{});
+
+		constexpr uint32_t thread_count = 4;
+		constexpr uint32_t line_count = 2000;
+		std::vector<std::thread> threads;
+		for(uint32_t t = 0; t < thread_count; ++t)
+		{
+			threads.emplace_back(
+				[&printer, t]()
+				{
+					for(uint32_t i = 0; i < line_count; ++i)
+					{
+						core::print_deferred<"{} {} padding to wrap the ring\n">(printer, t, i);
+					}
+				});
+		}
+		for(std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		printer.stop();
+		ASSERT_EQ(printer.dropped(), 0_uip);
+
+		std::array<uint32_t, thread_count> expected{};
+		uint32_t lines = 0;
+		std::u8string_view text = tsink.m_text;
+		while(!text.empty())
+		{
+			uintptr_t const end = text.find(u8'\n');
+			ASSERT_NE(end, std::u8string_view::npos);
+			std::u8string_view const line = text.substr(0, end);
+			text = text.substr(end + 1);
+
+			uintptr_t const split = line.find(u8' ');
+			core::from_chars_result<uint32_t> const t = core::from_chars<uint32_t>(line.substr(0, split));
+			ASSERT_TRUE(t.has_value());
+			ASSERT_LT(t.value(), thread_count);
+			std::u8string_view const rest = line.substr(split + 1);
+			core::from_chars_result<uint32_t> const i = core::from_chars<uint32_t>(rest.substr(0, rest.find(u8' ')));
+			ASSERT_TRUE(i.has_value());
+			ASSERT_EQ(i.value(), expected[t.value()]++);
+			++lines;
+		}
+		ASSERT_EQ(lines, thread_count * line_count);
+	}
+
+	{
+		collect_sink tsink;
+		core::deferred_printer printer;
+		ASSERT_EQ(printer.start(tsink, 0x100, 0, core::deferred_printer::overflow::drop), std::errc{});
+		for(uint32_t i = 0; i < 1000; ++i)
+		{
+			core::print_deferred<"{}\n">(printer, i);
+		}
+		core::print_deferred<"{}">(printer, std::u8string(0x200, u8'x'));
+		printer.stop();
+
+		uint64_t const lines = static_cast<uint64_t>(std::count(tsink.m_text.begin(), tsink.m_text.end(), u8'\n'));
+		ASSERT_EQ(lines + printer.dropped(), 1001_uip);
+		ASSERT_GE(printer.dropped(), 1_uip);
+	}
+
+	//a thread printing to more printers than it used to keep bound must stay in the same ring
+	{
+		collect_sink tsink;
+		core::deferred_printer printer;
+		ASSERT_EQ(printer.start(tsink, 0x1000, 0), std::errc{});
+
+		std::array<collect_sink, 6> other_sinks;
+		std::array<core::deferred_printer, 6> others;
+		for(uintptr_t i = 0; i < others.size(); ++i)
+		{
+			ASSERT_EQ(others[i].start(other_sinks[i], 0x1000, 0), std::errc{});
+		}
+
+		std::atomic<bool> printed = false;
+		std::atomic<bool> release = false;
+		//holds the printer's first ring while this thread takes a second one
+		std::thread holder(
+			[&]()
+			{
+				core::print_deferred<"holder\n">(printer);
+				printed.store(true);
+				while(!release.load()) std::this_thread::yield();
+			});
+		while(!printed.load()) std::this_thread::yield();
+
+		core::print_deferred<"first\n">(printer);
+		for(core::deferred_printer& other : others)
+		{
+			core::print_deferred<"other\n">(other);
+		}
+		release.store(true);
+		holder.join();
+		core::print_deferred<"second\n">(printer);
+
+		printer.stop();
+		std::u8string_view const text = tsink.m_text;
+		uintptr_t const first = text.find(u8"first\n"sv);
+		uintptr_t const second = text.find(u8"second\n"sv);
+		ASSERT_NE(first, std::u8string_view::npos);
+		ASSERT_NE(second, std::u8string_view::npos);
+		ASSERT_LT(first, second);
+
+		for(uintptr_t i = 0; i < others.size(); ++i)
+		{
+			others[i].stop();
+			ASSERT_EQ(other_sinks[i].m_text, u8"other\n"sv);
+		}
+	}
+}
@@ -27,8 +27,10 @@
 //======== ======== ======== ======== ======== ======== ======== ========
 
 #include <iostream>
+#include <string_view>
 #include <vector>
 #include <CoreLib/core_stacktrace.hpp>
+#include <CoreLib/core_file.hpp>
 
 
 volatile int var;
@@ -49,7 +51,38 @@ int main(
 	[[maybe_unused]] int argc,
 	[[maybe_unused]] char* argv[])
 {
-	core::register_crash_trace("Test.strace");
+#ifndef _WIN32
+	//Crashy --symbolize <raw trace>, resolves a trace written by register_crash_trace_raw
+	if(argc == 3 && std::string_view{argv[1]} == "--symbolize")
+	{
+		core::file_read t_file;
+		if(t_file.open(argv[2]) != std::errc{})
+		{
+			std::cerr << "Unable to open " << argv[2] << std::endl;
+			return 1;
+		}
+		std::u8string raw(static_cast<uintptr_t>(t_file.size()), u8'\0');
+		raw.resize(t_file.read_unlocked(raw.data(), raw.size()));
+
+		std::u8string output;
+		if(core::symbolize_crash_trace(raw, output) != std::errc{})
+		{
+			std::cerr << argv[2] << " is not a raw crash trace" << std::endl;
+			return 1;
+		}
+		std::cout.write(reinterpret_cast<char const*>(output.data()), output.size());
+		return 0;
+	}
+
+	if(argc == 2 && std::string_view{argv[1]} == "--raw")
+	{
+		core::register_crash_trace_raw("Test.rawtrace");
+	}
+	else
+#endif
+	{
+		core::register_crash_trace("Test.strace");
+	}
 
 
 	//fn_t fn = (fn_t) static_cast<uintptr_t>( argc );